@@ -441,6 +441,18 @@ namespace juego {
     /******************************************************************************************/
 
 
+    // todos los muros preparados, para jugar en ellos sin cambiar el juego (véase: 
+    // 'JuegoMesaBase::sustituyeMuros'); al preparar unos muros nuevos, se deben agregar aquí
+    const std::vector <std::pair <string, const ActorTablero::GraficoMuros *>> & JuegoMesa::murosPreparados () {
+        static const std::vector <std::pair <string, const ActorTablero::GraficoMuros *>> muros {
+                { "vacio",        & grafico_muros_vacio        },
+                { "ciudad",       & grafico_muros_ciudad       },
+                { "area_central", & grafico_muros_area_central },
+                { "pasillos",     & grafico_muros_pasillos     } };
+        return muros;
+    }
+
+
     void JuegoMesa::preparaTablero () {
         agregaTablero (new ActorTablero (this));
         //
@@ -14,6 +14,9 @@ namespace juego {
 
         JuegoMesa ();
 
+        // nombre y gráfico de los muros preparados en 'JuegoMesa.cpp'
+        static const std::vector <std::pair <string, const ActorTablero::GraficoMuros *>> & murosPreparados ();
+
     private:
 
         /*******************************************************************************************
@@ -0,0 +1,147 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   BusquedaArea.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    BusquedaArea::BusquedaArea (const MotorReglas & motor) : 
+            motor_ {& motor} {
+        centros.resize (TableroReglas::cuentaCeldas);
+    }
+
+
+    void BusquedaArea::balances (
+            const MotorReglas &   motor, 
+            const EstadoPartida & estado, 
+            int atacante, int habilidad, 
+            Balances &            lista    ) {
+        const ReglasPartida & reglas = motor.reglas ();
+        LadoTablero lado = reglas.personaje (atacante).lado;
+        lista.fill (0.0);
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            if (estado.personajes [indc].vitalidad <= 0) {
+                continue;
+            }
+            double dano = motor.danoEsperado (estado, atacante, habilidad, indc);
+            lista [indc] = reglas.personaje (indc).lado == lado ? - dano : dano;
+        }
+    }
+
+
+    void BusquedaArea::busca (
+            const EstadoPartida &       estado, 
+            int atacante, int habilidad, 
+            const Balances &            balances, 
+            int                         maximo, 
+            std::vector <Colocacion> &  colocaciones ) {
+        const ReglasPartida & reglas = motor_->reglas ();
+        const ReglasPartida::Habilidad & habld = reglas.habilidad (habilidad);
+        if (habld.enfoque != EnfoqueHabilidad::area) {
+            throw std::logic_error {"BusquedaArea: la habilidad no es de área"};
+        }
+        colocaciones.clear ();
+        int        celda_atacante = estado.personajes [atacante].celda;
+        LadoTablero lado          = reglas.personaje (atacante).lado;
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            const EstadoPersonaje & persj = estado.personajes [indc];
+            if (persj.vitalidad > 0) {
+                reparte (persj.celda, habld.radio_alcance, celda_atacante, habld.alcance, 
+                         balances [indc], reglas.personaje (indc).lado != lado);
+            }
+        }
+        ordenados.clear ();
+        for (int16_t celda : tocadas) {
+            ordenados.push_back (centros [celda]);
+            centros [celda] = Colocacion {};
+        }
+        tocadas.clear ();
+        std::sort (ordenados.begin (), ordenados.end (), [] (const Colocacion & a, const Colocacion & b) {
+            return a.valor > b.valor || (a.valor == b.valor && a.celda < b.celda);
+        });
+        // véase: 'MotorReglas::generaHabilidades' y 'accesoValido'
+        bool                  directo = habld.acceso == AccesoHabilidad::directo;
+        TableroReglas::Celdas ocupadas {};
+        if (directo && ! ordenados.empty ()) {
+            ocupadas = motor_->ocupadas (estado);
+        }
+        for (const Colocacion & colocacion : ordenados) {
+            if (std::ssize (colocaciones) >= maximo) {
+                break;
+            }
+            if (reglas.muros ().test (colocacion.celda)) {
+                continue;
+            }
+            if (directo && (colocacion.celda == celda_atacante || 
+                            ! TableroReglas::segmentoLibre (ocupadas, celda_atacante, colocacion.celda))) {
+                continue;
+            }
+            colocaciones.push_back (colocacion);
+        }
+    }
+
+
+    void BusquedaArea::busca (
+            const EstadoPartida &       estado, 
+            int atacante, int habilidad, 
+            int                         maximo, 
+            std::vector <Colocacion> &  colocaciones ) {
+        Balances lista;
+        balances (* motor_, estado, atacante, habilidad, lista);
+        busca (estado, atacante, habilidad, lista, maximo, colocaciones);
+    }
+
+
+    BusquedaArea::Colocacion BusquedaArea::mejor (const EstadoPartida & estado, int atacante, int habilidad) {
+        std::vector <Colocacion> colocaciones {};
+        busca (estado, atacante, habilidad, 1, colocaciones);
+        return colocaciones.empty () ? Colocacion {} : colocaciones [0];
+    }
+
+
+    void BusquedaArea::reparte (
+            int celda, int radio, 
+            int celda_atacante, int alcance, 
+            double balance, bool oponente    ) {
+        // en coordenadas axiales (véase: 'TableroReglas::distancia'), la intersección de los dos 
+        // discos es, en cada columna 'q', un tramo de 'r'; en una columna, cada 'r' son dos filas 
+        // más y 'columnas' celdas más
+        int q_persj = TableroReglas::coln (celda);
+        int r_persj = (TableroReglas::fila (celda) - q_persj) / 2;
+        int q_ataca = TableroReglas::coln (celda_atacante);
+        int r_ataca = (TableroReglas::fila (celda_atacante) - q_ataca) / 2;
+        int q_desde = std::max ({ q_persj - radio, q_ataca - alcance, 1 });
+        int q_hasta = std::min ({ q_persj + radio, q_ataca + alcance, TableroReglas::columnas });
+        for (int q = q_desde; q <= q_hasta; ++ q) {
+            int r_desde = std::max ({ r_persj - std::min (radio,   radio   + q - q_persj), 
+                                      r_ataca - std::min (alcance, alcance + q - q_ataca), 
+                                      - ((q - 1) / 2)                                    });
+            int r_hasta = std::min ({ r_persj + std::min (radio,   radio   - q + q_persj), 
+                                      r_ataca + std::min (alcance, alcance - q + q_ataca), 
+                                      (TableroReglas::filas - q) / 2                     });
+            if (r_desde > r_hasta) {
+                continue;
+            }
+            int centro = TableroReglas::celda (q + 2 * r_desde, q);
+            for (int r = r_desde; r <= r_hasta; ++ r, centro += TableroReglas::columnas) {
+                Colocacion & colocacion = centros [centro];
+                if (colocacion.celda == TableroReglas::nula) {
+                    colocacion.celda = static_cast <int16_t> (centro);
+                    tocadas.push_back (static_cast <int16_t> (centro));
+                }
+                colocacion.valor += balance;
+                if (oponente) {
+                    colocacion.oponentes ++;
+                } else {
+                    colocacion.aliados ++;
+                }
+            }
+        }
+    }
+
+
+}
@@ -0,0 +1,85 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  BusquedaArea.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Las celdas centrales válidas de una habilidad de área ('EnfoqueHabilidad::area') para el 
+    // atacante, de más a menos valor, todas a la vez. El valor de un centro es la suma de los 
+    // balances de los personajes vivos que quedan en el área (véase 'MotorReglas::personajesArea').
+    // En vez de recorrer el área de cada centro candidato, cada personaje vivo reparte su balance 
+    // por los centros que le alcanzan (los de su disco de radio 'radio_alcance' dentro del disco 
+    // de radio 'alcance' del atacante), columna a columna en coordenadas axiales: el coste es del 
+    // orden de personajes por celdas del área, no de centros por celdas del área. Solo los centros 
+    // tocados pueden ser válidos ('MotorReglas::generaJugadas' exige algún personaje vivo en el 
+    // área); el muro y el acceso se comprueban después, de mejor a peor, hasta tener los pedidos.
+    class BusquedaArea {
+    public:
+
+        // lo que vale que cada personaje caiga en el área
+        using Balances = std::array <double, ReglasPartida::maximoPersonajes>;
+
+        struct Colocacion {
+            int16_t celda {TableroReglas::nula};
+            double  valor {};
+            // vivos en el área; el atacante cuenta como aliado
+            int8_t  oponentes {};
+            int8_t  aliados {};
+        };
+
+
+        explicit BusquedaArea (const MotorReglas & motor);
+
+        // El daño esperado (véase 'MotorReglas::danoEsperado') a cada oponente del atacante, 
+        // menos el de cada aliado: la curación cuenta al revés.
+        static void balances (
+                const MotorReglas &   motor, 
+                const EstadoPartida & estado, 
+                int atacante, int habilidad, 
+                Balances &            lista    );
+
+        // Hasta 'maximo' colocaciones, las mismas celdas que las jugadas 'habilidadArea' de 
+        // 'MotorReglas::generaJugadas' para el atacante y la habilidad, sin mirar los puntos de 
+        // acción; a igual valor, por celda.
+        void busca (
+                const EstadoPartida &       estado, 
+                int atacante, int habilidad, 
+                const Balances &            balances, 
+                int                         maximo, 
+                std::vector <Colocacion> &  colocaciones );
+        // con 'balances'
+        void busca (
+                const EstadoPartida &       estado, 
+                int atacante, int habilidad, 
+                int                         maximo, 
+                std::vector <Colocacion> &  colocaciones );
+
+        // la de más valor; con la celda nula si no hay ninguna
+        Colocacion mejor (const EstadoPartida & estado, int atacante, int habilidad);
+
+    private:
+
+        const MotorReglas * motor_;
+
+        // por celda, lo repartido en la búsqueda en curso; 'tocadas' son las que hay que limpiar
+        std::vector <Colocacion> centros {};
+        std::vector <int16_t>    tocadas {};
+        std::vector <Colocacion> ordenados {};
+
+
+        // reparte un personaje por los centros a distancia hasta 'radio' de su celda y hasta 
+        // 'alcance' de la del atacante
+        void reparte (
+                int celda, int radio, 
+                int celda_atacante, int alcance, 
+                double balance, bool oponente    );
+
+    };
+
+
+}
@@ -0,0 +1,496 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   BusquedaExpectimax.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    BusquedaExpectimax::BusquedaExpectimax (const MotorReglas & motor, const Configuracion & configuracion) : 
+            motor_ {& motor}, 
+            configuracion_ {configuracion}, 
+            area_ {motor} {
+        if (motor.modo () != ModoReglas::pares) {
+            throw std::logic_error {"BusquedaExpectimax: solo en el modo por parejas"};
+        }
+        if (configuracion_.milisegundos <= 0 || configuracion_.profundidad_maxima <= 0 || 
+            configuracion_.profundidad_maxima > std::numeric_limits <int8_t>::max () || 
+            configuracion_.ancho_desplaza < 0 || configuracion_.ancho_area < 0 || 
+            configuracion_.bits_tabla < 8 || configuracion_.bits_tabla > 28                     ) {
+            throw std::logic_error {"BusquedaExpectimax: configuración inválida"};
+        }
+        //
+        const ReglasPartida & reglas = motor.reglas ();
+        dano_medio.resize (reglas.habilidades ().size ());
+        for (int habilidad = 0; habilidad < std::ssize (reglas.habilidades ()); ++ habilidad) {
+            const ReglasPartida::Habilidad & habld = reglas.habilidad (habilidad);
+            if (habld.antagonista != Antagonista::oponente) {
+                continue;
+            }
+            for (int ventaja = 0; ventaja < cuentaVentaja; ++ ventaja) {
+                int total = 0;
+                for (int aleatorio_100 = 0; aleatorio_100 < 100; ++ aleatorio_100) {
+                    int porcentaje = reglas.porcentajeDano (minimoVentaja + ventaja + aleatorio_100);
+                    total += MotorReglas::ajustaDano (habld.valor_dano, porcentaje);
+                }
+                dano_medio [habilidad][ventaja] = total / 100.0f;
+            }
+        }
+        tabla.resize (size_t {1} << configuracion_.bits_tabla);
+        niveles.resize (configuracion_.profundidad_maxima + 2);
+    }
+
+
+    const BusquedaExpectimax::Configuracion & BusquedaExpectimax::configuracion () const {
+        return configuracion_;
+    }
+
+
+    void BusquedaExpectimax::olvida () {
+        std::fill (tabla.begin (), tabla.end (), Entrada {});
+    }
+
+
+    BusquedaExpectimax::Resultado BusquedaExpectimax::busca (const EstadoPartida & estado, const std::atomic <bool> * detener) {
+        assert (! motor_->terminada (estado));
+        auto inicio = std::chrono::steady_clock::now ();
+        // los valores guardados dependen del lado y del horizonte (el final del turno)
+        LadoTablero lado = motor_->ladoDecide (estado);
+        if (lado != lado_raiz || estado.ronda != ronda_raiz || estado.turno != turno_raiz) {
+            olvida ();
+        }
+        lado_raiz    = lado;
+        ronda_raiz   = estado.ronda;
+        turno_raiz   = estado.turno;
+        final        = inicio + std::chrono::milliseconds {configuracion_.milisegundos};
+        detener_     = detener;
+        interrumpida = false;
+        nodos        = 0;
+        aciertos     = 0;
+        //
+        Resultado resultado {};
+        Nivel & raiz = niveles [0];
+        candidatas (estado, Jugada {}, raiz);
+        resultado.jugada = raiz.candidatas [0].second;
+        resultado.valor  = evalua (estado, lado_raiz);
+        for (int profundidad = 1; profundidad <= configuracion_.profundidad_maxima; ++ profundidad) {
+            recortada = false;
+            double alfa  = - victoria;
+            Jugada mejor = raiz.candidatas [0].second;
+            for (const std::pair <double, Jugada> & candidata : raiz.candidatas) {
+                double valor_jugada = valorJugada (estado, candidata.second, profundidad - 1, alfa, victoria, 1);
+                if (interrumpida) {
+                    break;
+                }
+                if (valor_jugada > alfa) {
+                    alfa  = valor_jugada;
+                    mejor = candidata.second;
+                }
+            }
+            if (interrumpida) {
+                break;
+            }
+            resultado.jugada      = mejor;
+            resultado.valor       = alfa;
+            resultado.profundidad = profundidad;
+            // la siguiente iteración empieza por la mejor
+            std::stable_partition (raiz.candidatas.begin (), raiz.candidatas.end (), 
+                                   [& mejor] (const std::pair <double, Jugada> & candidata) { 
+                                       return candidata.second == mejor; 
+                                   });
+            if (! recortada) {
+                // todas las ramas llegan al final del turno
+                break;
+            }
+        }
+        resultado.nodos          = nodos;
+        resultado.aciertos_tabla = aciertos;
+        resultado.segundos       = std::chrono::duration <double> (std::chrono::steady_clock::now () - inicio).count ();
+        return resultado;
+    }
+
+
+    double BusquedaExpectimax::evalua (const EstadoPartida & estado, LadoTablero lado) const {
+        std::array <double, 2> vitalidad {};
+        std::array <double, 2> puntos {};
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            const EstadoPersonaje & persj = estado.personajes [indc];
+            if (persj.vitalidad <= 0) {
+                continue;
+            }
+            int indice = indiceLado (motor_->reglas ().personaje (indc).lado);
+            vitalidad [indice] += persj.vitalidad;
+            puntos    [indice] += persj.puntos_accion;
+        }
+        int propio = indiceLado (lado);
+        int otro   = 1 - propio;
+        double valor_estado = vitalidad [propio] - vitalidad [otro] + 
+                              configuracion_.peso_puntos  * (puntos [propio] - puntos [otro]) - 
+                              configuracion_.peso_amenaza * (amenaza (estado, lado) - amenaza (estado, opuesto (lado)));
+        // por debajo de cualquier victoria
+        return std::clamp (valor_estado, - victoria / 2, victoria / 2);
+    }
+
+
+    double BusquedaExpectimax::danoMedio (const EstadoPartida & estado, int atacante, int habilidad, int objetivo) const {
+        const ReglasPartida::Habilidad & habld = motor_->reglas ().habilidad (habilidad);
+        int vitalidad = estado.personajes [objetivo].vitalidad;
+        if (vitalidad <= 0) {
+            return 0.0;
+        }
+        if (habld.antagonista != Antagonista::oponente) {
+            return - static_cast <double> (std::min (vitalidad + habld.valor_curacion, ReglasPartida::maximaVitalidad) - vitalidad);
+        }
+        int ventaja = motor_->valorAtaque  (estado, atacante, habld.tipo_ataque) - 
+                      motor_->valorDefensa (estado, objetivo, habld.tipo_defensa);
+        ventaja = std::clamp (ventaja - minimoVentaja, 0, cuentaVentaja - 1);
+        double dano = dano_medio [habilidad][ventaja] - motor_->reglas ().personaje (objetivo).reduce_dano [habld.tipo_dano];
+        return std::clamp (dano, 0.0, static_cast <double> (vitalidad));
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    double BusquedaExpectimax::valor (const EstadoPartida & estado, int profundidad, double alfa, double beta, int nivel) {
+        // el reloj se consulta cada pocos nodos
+        static constexpr int64_t mascaraConsulta = 255;
+        nodos ++;
+        if ((nodos & mascaraConsulta) == 0) {
+            if (std::chrono::steady_clock::now () >= final || (detener_ != nullptr && detener_->load ())) {
+                interrumpida = true;
+            }
+        }
+        if (interrumpida) {
+            return 0.0;
+        }
+        if (motor_->terminada (estado)) {
+            LadoTablero ganador = motor_->ganador (estado);
+            if (ganador == LadoTablero::nulo) {
+                return 0.0;
+            }
+            // antes, mejor
+            return ganador == lado_raiz ? victoria - nivel : - victoria + nivel;
+        }
+        if (fueraHorizonte (estado)) {
+            return evalua (estado, lado_raiz);
+        }
+        if (profundidad == 0) {
+            recortada = true;
+            return evalua (estado, lado_raiz);
+        }
+        //
+        uint64_t clave = estado.clave;
+        Entrada & guardada = entrada (clave);
+        Jugada primera {};
+        if (guardada.clave == clave) {
+            primera = guardada.jugada;
+            if (guardada.profundidad >= profundidad) {
+                aciertos ++;
+                if (guardada.cota == Cota::exacta || 
+                    (guardada.cota == Cota::inferior && guardada.valor >= beta) ||
+                    (guardada.cota == Cota::superior && guardada.valor <= alfa)    ) {
+                    recortada = recortada || guardada.recortada;
+                    return guardada.valor;
+                }
+            }
+        }
+        //
+        Nivel & datos = niveles [nivel];
+        candidatas (estado, primera, datos);
+        bool   maximiza    = motor_->ladoDecide (estado) == lado_raiz;
+        double alfa_previo = alfa;
+        double beta_previo = beta;
+        double mejor       = maximiza ? - std::numeric_limits <double>::infinity () : 
+                                          std::numeric_limits <double>::infinity ();
+        Jugada mejor_jugada = datos.candidatas [0].second;
+        bool   recortada_previa = recortada;
+        recortada = false;
+        for (const std::pair <double, Jugada> & candidata : datos.candidatas) {
+            double valor_jugada = valorJugada (estado, candidata.second, profundidad - 1, alfa, beta, nivel + 1);
+            if (interrumpida) {
+                return 0.0;
+            }
+            if (maximiza ? valor_jugada > mejor : valor_jugada < mejor) {
+                mejor        = valor_jugada;
+                mejor_jugada = candidata.second;
+            }
+            if (maximiza) {
+                alfa = std::max (alfa, valor_jugada);
+            } else {
+                beta = std::min (beta, valor_jugada);
+            }
+            if (alfa >= beta) {
+                break;
+            }
+        }
+        //
+        // se sustituye siempre: la entrada más reciente es la más útil en la iteración siguiente
+        guardada.clave       = clave;
+        guardada.valor       = static_cast <float> (mejor);
+        guardada.profundidad = static_cast <int8_t> (profundidad);
+        guardada.jugada      = mejor_jugada;
+        guardada.recortada   = recortada;
+        recortada = recortada || recortada_previa;
+        if (mejor <= alfa_previo) {
+            guardada.cota = Cota::superior;
+        } else if (mejor >= beta_previo) {
+            guardada.cota = Cota::inferior;
+        } else {
+            guardada.cota = Cota::exacta;
+        }
+        return mejor;
+    }
+
+
+    double BusquedaExpectimax::valorJugada (
+            const EstadoPartida & estado, 
+            const Jugada &        jugada, 
+            int                   profundidad, 
+            double alfa, double beta, 
+            int                   nivel ) {
+        if (! motor_->usaAleatorio (jugada) && ! motor_->usaDesempate (estado, jugada)) {
+            EstadoPartida siguiente = estado;
+            motor_->aplica (siguiente, jugada, 0, 0);
+            return valor (siguiente, profundidad, alfa, beta, nivel);
+        }
+        // Star1: cada desenlace se busca con la ventana que aún puede cambiar el resultado, 
+        // suponiendo lo peor y lo mejor de los que faltan
+        std::vector <Desenlace> & lista = niveles [nivel].desenlaces;
+        desenlaces (estado, jugada, lista);
+        double acumulado = 0.0;
+        double restante  = 1.0;
+        for (const Desenlace & desenlace : lista) {
+            restante -= desenlace.probabilidad;
+            double alfa_desenlace = (alfa - acumulado - victoria   * restante) / desenlace.probabilidad;
+            double beta_desenlace = (beta - acumulado + victoria   * restante) / desenlace.probabilidad;
+            double valor_desenlace = valor (
+                    desenlace.estado, profundidad, 
+                    std::max (alfa_desenlace, - victoria), std::min (beta_desenlace, victoria), nivel);
+            if (interrumpida) {
+                return 0.0;
+            }
+            acumulado += desenlace.probabilidad * valor_desenlace;
+            if (valor_desenlace <= alfa_desenlace) {
+                return acumulado + victoria * restante;
+            }
+            if (valor_desenlace >= beta_desenlace) {
+                return acumulado - victoria * restante;
+            }
+        }
+        return acumulado;
+    }
+
+
+    // Los valores de 'aleatorio_100' solo cambian el resultado donde cambia el grado de 
+    // efectividad de algún personaje, así que basta aplicar la jugada una vez por franja; las 
+    // franjas con el mismo resultado se juntan.
+    void BusquedaExpectimax::desenlaces (const EstadoPartida & estado, const Jugada & jugada, std::vector <Desenlace> & lista) const {
+        lista.clear ();
+        std::vector <int> inicios {0};
+        if (motor_->usaAleatorio (jugada)) {
+            const ReglasPartida & reglas = motor_->reglas ();
+            const ReglasPartida::Habilidad & habld = reglas.habilidad (jugada.habilidad);
+            if (habld.antagonista == Antagonista::oponente) {
+                int valor_ataque = motor_->valorAtaque (estado, jugada.personaje, habld.tipo_ataque);
+                std::bitset <100> cambia {};
+                for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+                    if (estado.personajes [indc].vitalidad <= 0) {
+                        continue;
+                    }
+                    int ventaja = valor_ataque - motor_->valorDefensa (estado, indc, habld.tipo_defensa);
+                    for (int aleatorio_100 = 1; aleatorio_100 < 100; ++ aleatorio_100) {
+                        if (reglas.porcentajeDano (ventaja + aleatorio_100) != 
+                            reglas.porcentajeDano (ventaja + aleatorio_100 - 1)) {
+                            cambia.set (aleatorio_100);
+                        }
+                    }
+                }
+                for (int aleatorio_100 = 1; aleatorio_100 < 100; ++ aleatorio_100) {
+                    if (cambia.test (aleatorio_100)) {
+                        inicios.push_back (aleatorio_100);
+                    }
+                }
+            }
+        }
+        int casos_desempate = motor_->usaDesempate (estado, jugada) ? 2 : 1;
+        for (int desempate = 0; desempate < casos_desempate; ++ desempate) {
+            for (int franja = 0; franja < std::ssize (inicios); ++ franja) {
+                int    final_franja = franja + 1 < std::ssize (inicios) ? inicios [franja + 1] : 100;
+                double probabilidad = (final_franja - inicios [franja]) / (100.0 * casos_desempate);
+                Desenlace desenlace {estado, probabilidad};
+                motor_->aplica (desenlace.estado, jugada, inicios [franja], desempate);
+                auto igual = std::find_if (lista.begin (), lista.end (), 
+                                           [& desenlace] (const Desenlace & otro) { return otro.estado.clave == desenlace.estado.clave; });
+                if (igual != lista.end ()) {
+                    igual->probabilidad += probabilidad;
+                } else {
+                    lista.push_back (desenlace);
+                }
+            }
+        }
+        // los más probables primero: cortan antes
+        std::stable_sort (lista.begin (), lista.end (), 
+                          [] (const Desenlace & a, const Desenlace & b) { return a.probabilidad > b.probabilidad; });
+    }
+
+
+    void BusquedaExpectimax::candidatas (const EstadoPartida & estado, const Jugada & primera, Nivel & nivel) {
+        motor_->generaJugadas (estado, nivel.jugadas);
+        nivel.candidatas.clear ();
+        // desplazamientos: los que más se acercan a un oponente, más la retirada
+        std::vector <std::pair <int, Jugada>> desplaza {};
+        // áreas: la primera jugada de cada habilidad, para pedir a 'BusquedaArea' sus mejores celdas
+        std::vector <Jugada> areas_habilidad {};
+        std::vector <std::pair <double, Jugada>> areas {};
+        LadoTablero lado = motor_->ladoDecide (estado);
+        for (const Jugada & jugada : nivel.jugadas) {
+            if (jugada.tipo == TipoJugada::desplaza) {
+                desplaza.emplace_back (distanciaOponente (estado, lado, jugada.celda), jugada);
+            } else if (jugada.tipo == TipoJugada::habilidadArea) {
+                if (areas_habilidad.empty () || areas_habilidad.back ().habilidad != jugada.habilidad) {
+                    areas_habilidad.push_back (jugada);
+                }
+            } else {
+                nivel.candidatas.emplace_back (prioridad (estado, jugada), jugada);
+            }
+        }
+        if (! desplaza.empty ()) {
+            auto cerca = [] (const std::pair <int, Jugada> & a, const std::pair <int, Jugada> & b) {
+                return a.first < b.first || (a.first == b.first && a.second.puntos < b.second.puntos);
+            };
+            auto retirada = * std::max_element (desplaza.begin (), desplaza.end (), cerca);
+            int ancho = std::min (configuracion_.ancho_desplaza, static_cast <int> (desplaza.size ()));
+            std::partial_sort (desplaza.begin (), desplaza.begin () + ancho, desplaza.end (), cerca);
+            desplaza.resize (ancho);
+            if (std::none_of (desplaza.begin (), desplaza.end (), 
+                              [& retirada] (const std::pair <int, Jugada> & elemento) { return elemento.second == retirada.second; })) {
+                desplaza.push_back (retirada);
+            }
+            for (const std::pair <int, Jugada> & elemento : desplaza) {
+                nivel.candidatas.emplace_back (prioridad (estado, elemento.second), elemento.second);
+            }
+        }
+        for (const Jugada & prototipo : areas_habilidad) {
+            BusquedaArea::Balances lista {};
+            for (int objetivo = 0; objetivo < estado.cuenta_personajes; ++ objetivo) {
+                lista [objetivo] = balance (estado, prototipo, objetivo);
+            }
+            area_.busca (estado, prototipo.personaje, prototipo.habilidad, lista, configuracion_.ancho_area, colocaciones);
+            for (const BusquedaArea::Colocacion & colocacion : colocaciones) {
+                Jugada jugada = prototipo;
+                jugada.celda = colocacion.celda;
+                areas.emplace_back (colocacion.valor, jugada);
+            }
+        }
+        if (! areas.empty ()) {
+            int ancho = std::min (configuracion_.ancho_area, static_cast <int> (areas.size ()));
+            std::partial_sort (areas.begin (), areas.begin () + ancho, areas.end (), 
+                               [] (const std::pair <double, Jugada> & a, const std::pair <double, Jugada> & b) { 
+                                   return a.first > b.first; 
+                               });
+            nivel.candidatas.insert (nivel.candidatas.end (), areas.begin (), areas.begin () + ancho);
+        }
+        // la mejor de la tabla, si sigue siendo candidata, va primero
+        for (std::pair <double, Jugada> & candidata : nivel.candidatas) {
+            if (candidata.second == primera) {
+                candidata.first = std::numeric_limits <double>::infinity ();
+            }
+        }
+        std::stable_sort (nivel.candidatas.begin (), nivel.candidatas.end (), 
+                          [] (const std::pair <double, Jugada> & a, const std::pair <double, Jugada> & b) { 
+                              return a.first > b.first; 
+                          });
+        if (nivel.candidatas.empty ()) {
+            // solo cuando todas las áreas y desplazamientos se han descartado, que no ocurre
+            nivel.candidatas.emplace_back (0.0, nivel.jugadas [0]);
+        }
+    }
+
+
+    // daño esperado a los oponentes menos el hecho a los aliados (la curación cuenta al revés); 
+    // las áreas se valoran en 'candidatas', con 'BusquedaArea'
+    double BusquedaExpectimax::prioridad (const EstadoPartida & estado, const Jugada & jugada) const {
+        LadoTablero lado = motor_->reglas ().personaje (jugada.personaje).lado;
+        switch (jugada.tipo) {
+        case TipoJugada::elige:
+            return estado.personajes [jugada.personaje].vitalidad;
+        case TipoJugada::desplaza:
+            return - 0.01 * distanciaOponente (estado, lado, jugada.celda);
+        case TipoJugada::habilidadSimple:
+            return 0.5;
+        case TipoJugada::habilidadOponente:
+            return balance (estado, jugada, jugada.objetivo);
+        default:
+            return - victoria;
+        }
+    }
+
+
+    double BusquedaExpectimax::balance (const EstadoPartida & estado, const Jugada & jugada, int objetivo) const {
+        const ReglasPartida & reglas = motor_->reglas ();
+        double dano = danoMedio (estado, jugada.personaje, jugada.habilidad, objetivo);
+        return reglas.personaje (objetivo).lado == reglas.personaje (jugada.personaje).lado ? - dano : dano;
+    }
+
+
+    bool BusquedaExpectimax::fueraHorizonte (const EstadoPartida & estado) const {
+        return estado.ronda != ronda_raiz || estado.turno != turno_raiz;
+    }
+
+
+    double BusquedaExpectimax::amenaza (const EstadoPartida & estado, LadoTablero lado) const {
+        const ReglasPartida & reglas = motor_->reglas ();
+        // centros de dos celdas vecinas
+        static constexpr float pasoCelda = 2 * TableroReglas::seno60 * TableroReglas::ladoHexagono;
+        double total = 0.0;
+        for (int oponente = 0; oponente < estado.cuenta_personajes; ++ oponente) {
+            const EstadoPersonaje & persj_opnt = estado.personajes [oponente];
+            if (persj_opnt.vitalidad <= 0 || reglas.personaje (oponente).lado == lado) {
+                continue;
+            }
+            double mayor = 0.0;
+            for (int habilidad : reglas.personaje (oponente).habilidades) {
+                const ReglasPartida::Habilidad & habld = reglas.habilidad (habilidad);
+                if (habld.antagonista != Antagonista::oponente || habld.coste > persj_opnt.puntos_accion) {
+                    continue;
+                }
+                int pasos = static_cast <int> ((persj_opnt.puntos_accion - habld.coste) * 
+                                               reglas.puntosAccionDeDesplaza () / pasoCelda);
+                for (int objetivo = 0; objetivo < estado.cuenta_personajes; ++ objetivo) {
+                    const EstadoPersonaje & persj_objtv = estado.personajes [objetivo];
+                    if (persj_objtv.vitalidad <= 0 || reglas.personaje (objetivo).lado != lado) {
+                        continue;
+                    }
+                    int alcance = habld.alcance + habld.radio_alcance + pasos;
+                    if (TableroReglas::distancia (persj_opnt.celda, persj_objtv.celda) <= alcance) {
+                        mayor = std::max (mayor, danoMedio (estado, oponente, habilidad, objetivo));
+                    }
+                }
+            }
+            total += mayor;
+        }
+        return total;
+    }
+
+
+    int BusquedaExpectimax::distanciaOponente (const EstadoPartida & estado, LadoTablero lado, int celda) const {
+        int minima = TableroReglas::filas + TableroReglas::columnas;
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            if (estado.personajes [indc].vitalidad > 0 && motor_->reglas ().personaje (indc).lado != lado) {
+                minima = std::min (minima, TableroReglas::distancia (celda, estado.personajes [indc].celda));
+            }
+        }
+        return minima;
+    }
+
+
+    BusquedaExpectimax::Entrada & BusquedaExpectimax::entrada (uint64_t clave) {
+        return tabla [clave & (tabla.size () - 1)];
+    }
+
+
+}
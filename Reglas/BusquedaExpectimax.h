@@ -0,0 +1,151 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  BusquedaExpectimax.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Búsqueda expectimax con poda alfa-beta de la jugada de quien decide, en el modo por parejas
+    // y sin pasar del final del turno en curso (las jugadas de los dos elegidos).
+    //  *   Una habilidad con azar es un nodo de azar con un hijo por cada resultado distinto de 
+    //      'aleatorio_100' (las franjas de los grados de efectividad que cambian el daño, unas 
+    //      pocas), con su probabilidad; el empate de iniciativas, con dos. Se podan con Star1: el
+    //      valor de la evaluación está acotado.
+    //  *   Profundización iterativa, en jugadas, con una tabla de transposición por la clave del 
+    //      estado ('EstadoPartida::clave'), que guarda la mejor jugada de cada nodo para ordenar la 
+    //      siguiente iteración.
+    //  *   Las jugadas se ordenan por su daño esperado. De los desplazamientos y de las áreas, que 
+    //      son cientos, solo se consideran los mejores ('ancho_desplaza', 'ancho_area') y, de los 
+    //      desplazamientos, también la retirada más lejos de los oponentes. Las mejores áreas las 
+    //      da 'BusquedaArea', sin valorar cada celda.
+    // El valor es para el lado que decide en la raíz, en puntos de vitalidad (véase 'evalua'); 
+    // una victoria vale 'victoria' menos las jugadas hasta ella.
+    class BusquedaExpectimax {
+    public:
+
+        static constexpr double victoria = 10000.0;
+
+        struct Configuracion {
+            int    milisegundos {1000};
+            int    profundidad_maxima {16};
+            int    ancho_desplaza {4};
+            int    ancho_area {3};
+            // la tabla tiene 2 ^ 'bits_tabla' entradas
+            int    bits_tabla {20};
+            // vitalidad que vale un punto de acción sin gastar
+            double peso_puntos {2.0};
+            // fracción del daño que los oponentes pueden hacer en su próxima jugada
+            double peso_amenaza {0.5};
+        };
+
+        struct Resultado {
+            Jugada  jugada {};
+            double  valor {};
+            // la de la última iteración completa
+            int     profundidad {};
+            int64_t nodos {};
+            int64_t aciertos_tabla {};
+            double  segundos {};
+        };
+
+
+        BusquedaExpectimax (const MotorReglas & motor, const Configuracion & configuracion);
+
+        const Configuracion & configuracion () const;
+
+        // La jugada de quien decide en 'estado', que no debe haber terminado. Termina al agotar 
+        // el tiempo o la profundidad, al llegar al final del turno en todas las ramas o en cuanto 
+        // 'detener' se activa, con la jugada de la última iteración completa.
+        Resultado busca (const EstadoPartida & estado, const std::atomic <bool> * detener = nullptr);
+
+        // vacía la tabla de transposición
+        void olvida ();
+
+        // Para 'lado': la diferencia de vitalidad entre los dos lados, más la de los puntos de 
+        // acción por 'peso_puntos', menos la de la amenaza por 'peso_amenaza'. La amenaza sobre un 
+        // lado es la suma, por oponente vivo, del mayor daño medio que puede hacer a alguno de sus 
+        // personajes desplazándose en línea recta con los puntos que le sobran.
+        double evalua (const EstadoPartida & estado, LadoTablero lado) const;
+
+        // media para los cien valores de 'aleatorio_100', sin pasar de la vitalidad del objetivo
+        double danoMedio (const EstadoPartida & estado, int atacante, int habilidad, int objetivo) const;
+
+    private:
+
+        enum class Cota : uint8_t {
+            exacta,
+            inferior,
+            superior,
+        };
+
+        struct Entrada {
+            uint64_t clave {};
+            float    valor {};
+            int8_t   profundidad {- 1};
+            Cota     cota {};
+            // si alguna rama se cortó por la profundidad antes del final del turno
+            bool     recortada {};
+            Jugada   jugada {};
+        };
+
+        struct Desenlace {
+            EstadoPartida estado {};
+            double        probabilidad {};
+        };
+
+        // lo que se usa en cada nivel del árbol, para no reservar memoria en cada nodo
+        struct Nivel {
+            std::vector <Jugada>                    jugadas {};
+            std::vector <std::pair <double, Jugada>> candidatas {};
+            std::vector <Desenlace>                 desenlaces {};
+        };
+
+        const MotorReglas * motor_;
+        Configuracion       configuracion_;
+        BusquedaArea        area_;
+
+        // daño medio de cada habilidad contra oponentes, por 'valor_ataque - valor_defensa' 
+        // (desde 'minimoVentaja'), antes de restar la reducción del objetivo
+        static constexpr int minimoVentaja = 1 - ReglasPartida::maximaVitalidad;
+        static constexpr int cuentaVentaja = 2 * (ReglasPartida::maximaVitalidad - 1) + 1;
+        std::vector <std::array <float, cuentaVentaja>> dano_medio {};
+
+        std::vector <Entrada> tabla {};
+        std::vector <Nivel>   niveles {};
+        // las de 'area_' para una habilidad, en 'candidatas'
+        std::vector <BusquedaArea::Colocacion> colocaciones {};
+
+        // de la búsqueda en curso
+        LadoTablero                           lado_raiz {};
+        int                                   ronda_raiz {};
+        int                                   turno_raiz {};
+        std::chrono::steady_clock::time_point final {};
+        const std::atomic <bool> *            detener_ {};
+        bool                                  interrumpida {};
+        // en la iteración en curso, si alguna rama se ha cortado por la profundidad
+        bool                                  recortada {};
+        int64_t                               nodos {};
+        int64_t                               aciertos {};
+
+
+        double valor (const EstadoPartida & estado, int profundidad, double alfa, double beta, int nivel);
+        double valorJugada (const EstadoPartida & estado, const Jugada & jugada, int profundidad, double alfa, double beta, int nivel);
+        void   desenlaces (const EstadoPartida & estado, const Jugada & jugada, std::vector <Desenlace> & lista) const;
+        void   candidatas (const EstadoPartida & estado, const Jugada & primera, Nivel & nivel);
+        double prioridad (const EstadoPartida & estado, const Jugada & jugada) const;
+        // 'danoMedio' al objetivo, negativo si es aliado de quien juega
+        double balance (const EstadoPartida & estado, const Jugada & jugada, int objetivo) const;
+        bool   fueraHorizonte (const EstadoPartida & estado) const;
+        double amenaza (const EstadoPartida & estado, LadoTablero lado) const;
+        int    distanciaOponente (const EstadoPartida & estado, LadoTablero lado, int celda) const;
+
+        Entrada & entrada (uint64_t clave);
+
+    };
+
+
+}
@@ -0,0 +1,283 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   BusquedaMonteCarlo.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    BusquedaMonteCarlo::BusquedaMonteCarlo (const MotorReglas & motor, const Configuracion & configuracion) : 
+            motor_ {& motor}, 
+            configuracion_ {configuracion} {
+        if (configuracion_.hilos <= 0) {
+            configuracion_.hilos = std::max (1, static_cast <int> (std::thread::hardware_concurrency ()));
+        }
+        if (configuracion_.milisegundos <= 0 || configuracion_.maximo_nodos <= 0 || 
+            configuracion_.jugadas_simulacion < 0                                     ) {
+            throw std::logic_error {"BusquedaMonteCarlo: configuración inválida"};
+        }
+        for (int indc = 0; indc < configuracion_.hilos; ++ indc) {
+            arboles.push_back (std::make_unique <Arbol> ());
+            arboles.back ()->azar.siembra (configuracion_.semilla, static_cast <uint64_t> (indc));
+        }
+    }
+
+
+    BusquedaMonteCarlo::~BusquedaMonteCarlo () {
+    }
+
+
+    const BusquedaMonteCarlo::Configuracion & BusquedaMonteCarlo::configuracion () const {
+        return configuracion_;
+    }
+
+
+    BusquedaMonteCarlo::Resultado BusquedaMonteCarlo::busca (const EstadoPartida & estado, const std::atomic <bool> * detener) {
+        assert (! motor_->terminada (estado));
+        auto inicio = std::chrono::steady_clock::now ();
+        auto final  = inicio + std::chrono::milliseconds {configuracion_.milisegundos};
+        Resultado resultado {};
+        uint64_t clave = estado.clave;
+        for (std::unique_ptr <Arbol> & arbol : arboles) {
+            if (arbol->nodos.size () >= static_cast <size_t> (configuracion_.maximo_nodos)) {
+                arbol->nodos.clear ();
+            }
+            auto encontrado = arbol->nodos.find (clave);
+            if (encontrado != arbol->nodos.end ()) {
+                resultado.reutilizadas += encontrado->second.visitas;
+            } else {
+                expande (* arbol, clave, estado);
+            }
+            arbol->iteraciones = 0;
+        }
+        //
+        std::vector <std::thread> trabajadores {};
+        for (int indc = 1; indc < std::ssize (arboles); ++ indc) {
+            trabajadores.emplace_back (& BusquedaMonteCarlo::trabaja, this, 
+                                       std::ref (* arboles [indc]), std::cref (estado), final, detener);
+        }
+        trabaja (* arboles [0], estado, final, detener);
+        for (std::thread & trabajador : trabajadores) {
+            trabajador.join ();
+        }
+        //
+        // la raíz se expande igual en todos los árboles: las aristas están en el mismo orden
+        std::vector <Arista> raiz = arboles [0]->nodos.at (clave).aristas;
+        for (int indc = 1; indc < std::ssize (arboles); ++ indc) {
+            const std::vector <Arista> & aristas = arboles [indc]->nodos.at (clave).aristas;
+            assert (aristas.size () == raiz.size ());
+            for (int arista = 0; arista < std::ssize (raiz); ++ arista) {
+                assert (aristas [arista].jugada == raiz [arista].jugada);
+                raiz [arista].visitas += aristas [arista].visitas;
+                raiz [arista].valor   += aristas [arista].valor;
+            }
+        }
+        int elegida = 0;
+        for (int arista = 1; arista < std::ssize (raiz); ++ arista) {
+            if (raiz [arista].visitas > raiz [elegida].visitas) {
+                elegida = arista;
+            }
+        }
+        resultado.jugada = raiz [elegida].jugada;
+        resultado.valor  = raiz [elegida].visitas > 0 ? raiz [elegida].valor / raiz [elegida].visitas : 0.5;
+        for (const std::unique_ptr <Arbol> & arbol : arboles) {
+            resultado.iteraciones += arbol->iteraciones;
+            resultado.nodos       += static_cast <int64_t> (arbol->nodos.size ());
+        }
+        resultado.segundos = std::chrono::duration <double> (std::chrono::steady_clock::now () - inicio).count ();
+        return resultado;
+    }
+
+
+    void BusquedaMonteCarlo::olvida () {
+        for (std::unique_ptr <Arbol> & arbol : arboles) {
+            arbol->nodos.clear ();
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void BusquedaMonteCarlo::trabaja (
+            Arbol &                               arbol, 
+            const EstadoPartida &                 raiz, 
+            std::chrono::steady_clock::time_point final, 
+            const std::atomic <bool> *            detener ) {
+        // el reloj se consulta cada pocas iteraciones; una iteración dura décimas de milisegundo
+        static constexpr int iteracionesConsulta = 8;
+        do {
+            for (int indc = 0; indc < iteracionesConsulta; ++ indc) {
+                itera (arbol, raiz);
+            }
+        } while (std::chrono::steady_clock::now () < final && (detener == nullptr || ! detener->load ()));
+    }
+
+
+    void BusquedaMonteCarlo::itera (Arbol & arbol, const EstadoPartida & raiz) {
+        EstadoPartida estado = raiz;
+        arbol.camino.clear ();
+        // descenso hasta el primer estado que no está en el árbol, que se agrega
+        while (! motor_->terminada (estado)) {
+            uint64_t clave = estado.clave;
+            auto encontrado = arbol.nodos.find (clave);
+            bool nuevo = encontrado == arbol.nodos.end ();
+            if (nuevo && arbol.nodos.size () >= static_cast <size_t> (configuracion_.maximo_nodos)) {
+                break;
+            }
+            Nodo & nodo = nuevo ? expande (arbol, clave, estado) : encontrado->second;
+            int arista = seleccion (nodo);
+            arbol.camino.emplace_back (& nodo, arista);
+            motor_->aplica (estado, nodo.aristas [arista].jugada, arbol.azar);
+            if (nuevo) {
+                break;
+            }
+        }
+        double recompensa = simula (arbol, estado);
+        for (const std::pair <Nodo *, int> & paso : arbol.camino) {
+            Nodo & nodo = * paso.first;
+            Arista & arista = nodo.aristas [paso.second];
+            nodo.visitas ++;
+            arista.visitas ++;
+            arista.valor += static_cast <float> (nodo.lado == LadoTablero::Izquierda ? recompensa : 1.0 - recompensa);
+        }
+        arbol.iteraciones ++;
+    }
+
+
+    BusquedaMonteCarlo::Nodo & BusquedaMonteCarlo::expande (Arbol & arbol, uint64_t clave, const EstadoPartida & estado) {
+        Nodo & nodo = arbol.nodos [clave];
+        nodo.lado = motor_->ladoDecide (estado);
+        motor_->generaJugadas (estado, arbol.jugadas);
+        std::vector <std::pair <double, int>> orden {};
+        for (int indc = 0; indc < std::ssize (arbol.jugadas); ++ indc) {
+            orden.emplace_back (prioridad (estado, arbol.jugadas [indc]), indc);
+        }
+        // estable: con las mismas jugadas, el mismo orden en todos los árboles
+        std::stable_sort (orden.begin (), orden.end (), 
+                          [] (const std::pair <double, int> & a, const std::pair <double, int> & b) { 
+                              return a.first > b.first; 
+                          });
+        nodo.aristas.reserve (orden.size ());
+        for (const std::pair <double, int> & elemento : orden) {
+            Arista arista {};
+            arista.jugada = arbol.jugadas [elemento.second];
+            nodo.aristas.push_back (arista);
+        }
+        return nodo;
+    }
+
+
+    int BusquedaMonteCarlo::seleccion (const Nodo & nodo) const {
+        assert (! nodo.aristas.empty ());
+        int consideradas = 1 + static_cast <int> (2.0 * std::sqrt (static_cast <double> (nodo.visitas)));
+        consideradas = std::min (consideradas, static_cast <int> (nodo.aristas.size ()));
+        double logaritmo = std::log (static_cast <double> (std::max (nodo.visitas, 1)));
+        int    elegida = 0;
+        double mejor   = - std::numeric_limits <double>::infinity ();
+        for (int indc = 0; indc < consideradas; ++ indc) {
+            const Arista & arista = nodo.aristas [indc];
+            if (arista.visitas == 0) {
+                return indc;
+            }
+            double valor = arista.valor / arista.visitas + 
+                           configuracion_.exploracion * std::sqrt (logaritmo / arista.visitas);
+            if (valor > mejor) {
+                mejor   = valor;
+                elegida = indc;
+            }
+        }
+        return elegida;
+    }
+
+
+    double BusquedaMonteCarlo::simula (Arbol & arbol, EstadoPartida & estado) {
+        for (int indc = 0; indc < configuracion_.jugadas_simulacion && ! motor_->terminada (estado); ++ indc) {
+            motor_->generaJugadas (estado, arbol.jugadas);
+            int elegida = arbol.simulacion.elige (* motor_, estado, arbol.jugadas, arbol.azar);
+            motor_->aplica (estado, arbol.jugadas [elegida], arbol.azar);
+        }
+        return evalua (estado);
+    }
+
+
+    double BusquedaMonteCarlo::evalua (const EstadoPartida & estado) const {
+        if (motor_->terminada (estado)) {
+            switch (motor_->ganador (estado)) {
+            case LadoTablero::Izquierda:
+                return 1.0;
+            case LadoTablero::Derecha:
+                return 0.0;
+            default:
+                return 0.5;
+            }
+        }
+        // sin terminar, la diferencia entre las vitalidades de los dos lados (en fracción de la 
+        // máxima de cada uno)
+        std::array <double, 2> vitalidad {};
+        std::array <double, 2> maxima {};
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            int lado = indiceLado (motor_->reglas ().personaje (indc).lado);
+            vitalidad [lado] += estado.personajes [indc].vitalidad;
+            maxima    [lado] += ReglasPartida::maximaVitalidad;
+        }
+        return 0.5 + 0.5 * (vitalidad [0] / maxima [0] - vitalidad [1] / maxima [1]);
+    }
+
+
+    double BusquedaMonteCarlo::prioridad (const EstadoPartida & estado, const Jugada & jugada) const {
+        const ReglasPartida & reglas = motor_->reglas ();
+        LadoTablero lado = reglas.personaje (jugada.personaje).lado;
+        switch (jugada.tipo) {
+        case TipoJugada::elige:
+            return static_cast <double> (estado.personajes [jugada.personaje].vitalidad) / ReglasPartida::maximaVitalidad;
+        case TipoJugada::desplaza: {
+            // acercarse, gastando pocos puntos; siempre por debajo de cualquier habilidad útil
+            int distancia = std::numeric_limits <int>::max ();
+            for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+                if (estado.personajes [indc].vitalidad > 0 && reglas.personaje (indc).lado != lado) {
+                    distancia = std::min (distancia, TableroReglas::distancia (jugada.celda, estado.personajes [indc].celda));
+                }
+            }
+            return - 0.01 * distancia - 0.0001 * jugada.puntos;
+        }
+        case TipoJugada::habilidadSimple: {
+            // solo si cambia algo: el cambio sustituye al anterior
+            const ReglasPartida::Habilidad & habilidad = reglas.habilidad (jugada.habilidad);
+            const EstadoPersonaje & persj = estado.personajes [jugada.personaje];
+            for (const std::pair <int, int> & efecto : habilidad.efectos_ataque) {
+                if (persj.cambio_ataque [efecto.first] != efecto.second) {
+                    return 0.5;
+                }
+            }
+            for (const std::pair <int, int> & efecto : habilidad.efectos_defensa) {
+                if (persj.cambio_defensa [efecto.first] != efecto.second) {
+                    return 0.5;
+                }
+            }
+            return - 1.0;
+        }
+        case TipoJugada::habilidadOponente: {
+            double dano = motor_->danoEsperado (estado, jugada.personaje, jugada.habilidad, jugada.objetivo);
+            return (reglas.personaje (jugada.objetivo).lado == lado ? - dano : dano) / 10.0;
+        }
+        case TipoJugada::habilidadArea: {
+            std::vector <int> afectados {};
+            motor_->personajesArea (estado, jugada.celda, reglas.habilidad (jugada.habilidad).radio_alcance, afectados);
+            double balance = 0.0;
+            for (int afectado : afectados) {
+                double dano = motor_->danoEsperado (estado, jugada.personaje, jugada.habilidad, afectado);
+                balance += reglas.personaje (afectado).lado == lado ? - dano : dano;
+            }
+            return balance / 10.0;
+        }
+        default:
+            return - 1000.0;
+        }
+    }
+
+
+}
@@ -0,0 +1,108 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  BusquedaMonteCarlo.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Búsqueda de Monte Carlo en árbol (UCT) de la jugada de quien decide en una partida. 
+    //  *   Los nodos son estados y se guardan por su clave ('EstadoPartida::clave'), así que dos 
+    //      caminos que llegan a la misma partida comparten estadísticas y el árbol de una 
+    //      búsqueda sirve para la siguiente (la raíz nueva ya suele estar en él).
+    //  *   El azar de las habilidades se sortea en cada descenso; cada resultado es otro estado.
+    //  *   Las jugadas de un nodo se ordenan por su efecto inmediato y solo se consideran las 
+    //      primeras, más cuantas más visitas tiene (ensanchamiento progresivo): los desplazamientos 
+    //      son cientos.
+    //  *   Las simulaciones juegan con 'PoliticaGuion' hasta el final o hasta 
+    //      'jugadas_simulacion' jugadas, y se evalúan por la vitalidad de cada lado.
+    //  *   Cada hilo busca en su propio árbol; al terminar, se suman las visitas de las jugadas de 
+    //      la raíz y gana la más visitada.
+    // Las recompensas son para la izquierda, entre 0 (derrota) y 1 (victoria); cada nodo las 
+    // cuenta para el lado que decide en él.
+    class BusquedaMonteCarlo {
+    public:
+
+        struct Configuracion {
+            // duración de cada búsqueda
+            int      milisegundos {1000};
+            int      hilos {1};
+            // por hilo; un árbol lleno deja de crecer y se vacía al empezar la búsqueda siguiente
+            int      maximo_nodos {200000};
+            int      jugadas_simulacion {40};
+            double   exploracion {0.5};
+            uint64_t semilla {};
+        };
+
+        struct Resultado {
+            Jugada   jugada {};
+            // de 0 a 1, para el lado que decide
+            double   valor {};
+            int64_t  iteraciones {};
+            // visitas de la raíz heredadas de búsquedas anteriores
+            int64_t  reutilizadas {};
+            int64_t  nodos {};
+            double   segundos {};
+        };
+
+
+        BusquedaMonteCarlo (const MotorReglas & motor, const Configuracion & configuracion);
+        ~BusquedaMonteCarlo ();
+
+        const Configuracion & configuracion () const;
+
+        // La jugada de quien decide en 'estado', que no debe haber terminado. Se puede llamar 
+        // desde cualquier hilo, pero no desde dos a la vez. Termina al agotar el tiempo o en 
+        // cuanto 'detener' se activa, con la mejor jugada hasta entonces.
+        Resultado busca (const EstadoPartida & estado, const std::atomic <bool> * detener = nullptr);
+
+        // vacía los árboles (por ejemplo, al empezar otra partida)
+        void olvida ();
+
+    private:
+
+        struct Arista {
+            Jugada  jugada {};
+            int32_t visitas {};
+            // suma de las recompensas para el lado que decide en el nodo
+            float   valor {};
+        };
+
+        struct Nodo {
+            LadoTablero            lado {};
+            int32_t                visitas {};
+            std::vector <Arista>   aristas {};
+        };
+
+        struct Arbol {
+            std::unordered_map <uint64_t, Nodo> nodos {};
+            GeneradorAzar                       azar {};
+            PoliticaGuion                       simulacion {};
+            std::vector <Jugada>                jugadas {};
+            std::vector <std::pair <Nodo *, int>> camino {};
+            int64_t                             iteraciones {};
+        };
+
+        const MotorReglas * motor_;
+        Configuracion       configuracion_;
+        std::vector <std::unique_ptr <Arbol>> arboles {};
+
+
+        void trabaja (Arbol & arbol, const EstadoPartida & raiz, 
+                      std::chrono::steady_clock::time_point final, const std::atomic <bool> * detener);
+        void itera (Arbol & arbol, const EstadoPartida & raiz);
+        Nodo & expande (Arbol & arbol, uint64_t clave, const EstadoPartida & estado);
+        int  seleccion (const Nodo & nodo) const;
+        double simula (Arbol & arbol, EstadoPartida & estado);
+        double evalua (const EstadoPartida & estado) const;
+
+        // efecto inmediato de la jugada para quien la hace, para ordenar las aristas
+        double prioridad (const EstadoPartida & estado, const Jugada & jugada) const;
+
+    };
+
+
+}
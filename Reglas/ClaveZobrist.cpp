@@ -0,0 +1,83 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   ClaveZobrist.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    uint64_t ClaveZobrist::componente (Campo campo, int personaje, int subindice, int valor) {
+        if (valor == 0) {
+            return 0;
+        }
+        // splitmix64 sobre el campo, el personaje, el subíndice y el valor empaquetados
+        uint64_t mezcla = (static_cast <uint64_t> (campo)                         << 56) ^
+                          (static_cast <uint64_t> (static_cast <uint8_t> (personaje)) << 48) ^
+                          (static_cast <uint64_t> (static_cast <uint8_t> (subindice)) << 40) ^
+                           static_cast <uint64_t> (static_cast <uint32_t> (valor));
+        mezcla += 0x9E3779B97F4A7C15ull;
+        mezcla = (mezcla ^ (mezcla >> 30)) * 0xBF58476D1CE4E5B9ull;
+        mezcla = (mezcla ^ (mezcla >> 27)) * 0x94D049BB133111EBull;
+        return mezcla ^ (mezcla >> 31);
+    }
+
+
+    uint64_t ClaveZobrist::componente (Campo campo, int valor) {
+        return componente (campo, 0, 0, valor);
+    }
+
+
+    uint64_t ClaveZobrist::personaje (const EstadoPersonaje & estado_personaje, int personaje) {
+        uint64_t clave = componente (Campo::celda,        personaje, 0, estado_personaje.celda) ^
+                         componente (Campo::vitalidad,    personaje, 0, estado_personaje.vitalidad) ^
+                         componente (Campo::puntosAccion, personaje, 0, estado_personaje.puntos_accion);
+        for (int tipo = 0; tipo < ReglasPartida::maximoTiposEstadistica; ++ tipo) {
+            clave ^= componente (Campo::cambioAtaque,  personaje, tipo, estado_personaje.cambio_ataque  [tipo]);
+            clave ^= componente (Campo::cambioDefensa, personaje, tipo, estado_personaje.cambio_defensa [tipo]);
+        }
+        return clave;
+    }
+
+
+    uint64_t ClaveZobrist::control (const EstadoPartida & estado) {
+        return componente (Campo::ronda,      estado.ronda) ^
+               componente (Campo::turno,      estado.turno) ^
+               componente (Campo::jugada,     estado.jugada) ^
+               componente (Campo::ladoElige,  static_cast <int> (estado.lado_elige)) ^
+               componente (Campo::ladoActual, static_cast <int> (estado.lado_actual)) ^
+               componente (Campo::factor,     estado.factor) ^
+               componente (Campo::elegido,    0, 0, estado.elegido [0]) ^
+               componente (Campo::elegido,    0, 1, estado.elegido [1]) ^
+               componente (Campo::atacante,   estado.atacante);
+    }
+
+
+    uint64_t ClaveZobrist::calcula (const EstadoPartida & estado) {
+        uint64_t clave = control (estado);
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            clave ^= personaje (estado.personajes [indc], indc);
+        }
+        return clave;
+    }
+
+
+    void ClaveZobrist::cambia (
+            EstadoPartida & estado,
+            Campo           campo,
+            int             personaje,
+            int             subindice,
+            int16_t &       valor,
+            int             nuevo ) {
+        if (valor == nuevo) {
+            return;
+        }
+        estado.clave ^= componente (campo, personaje, subindice, valor) ^
+                        componente (campo, personaje, subindice, nuevo);
+        valor = static_cast <int16_t> (nuevo);
+    }
+
+
+}
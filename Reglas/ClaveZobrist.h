@@ -0,0 +1,62 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  ClaveZobrist.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Claves de Zobrist de un 'EstadoPartida'. Cada valor de cada campo del estado tiene un número
+    // de 64 bits pseudoaleatorio, y la clave es el o-exclusivo de los números de sus valores:
+    // cambiar un campo cuesta quitar el número del valor anterior y poner el del nuevo.
+    // Los números no se guardan en tablas, porque los cambios de las estadísticas no están
+    // acotados: se obtienen mezclando el campo y el valor, y son los mismos en todas las
+    // ejecuciones. El valor cero de un campo no aporta nada a la clave.
+    // 'MotorReglas' mantiene 'EstadoPartida::clave' en cada cambio; 'calcula' la obtiene entera.
+    class ClaveZobrist {
+    public:
+
+        enum class Campo : uint8_t {
+            celda,
+            vitalidad,
+            puntosAccion,
+            cambioAtaque,
+            cambioDefensa,
+            ronda,
+            turno,
+            jugada,
+            ladoElige,
+            ladoActual,
+            factor,
+            elegido,
+            atacante
+        };
+
+        // 'personaje' es el índice en 'ReglasPartida'; 'subindice', el tipo de la estadística o el
+        // lado del elegido
+        static uint64_t componente (Campo campo, int personaje, int subindice, int valor);
+        static uint64_t componente (Campo campo, int valor);
+
+        // lo que aportan los campos de un personaje
+        static uint64_t personaje (const EstadoPersonaje & estado_personaje, int personaje);
+        // lo que aportan los demás campos: los contadores, los lados, el factor, los elegidos y el
+        // atacante
+        static uint64_t control (const EstadoPartida & estado);
+        static uint64_t calcula (const EstadoPartida & estado);
+
+        // cambia un campo de un personaje de 'estado' y su clave
+        static void cambia (
+                EstadoPartida & estado,
+                Campo           campo,
+                int             personaje,
+                int             subindice,
+                int16_t &       valor,
+                int             nuevo );
+
+    };
+
+
+}
@@ -0,0 +1,55 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  EstadoPartida.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Todo lo que cambia durante una partida, como valor: se copia con una asignación (o 'memcpy') 
+    // y no contiene punteros, así que una copia es una partida independiente. La configuración 
+    // está en 'ReglasPartida'; los personajes se identifican por su índice en ella.
+    struct EstadoPersonaje {
+        int16_t celda {TableroReglas::nula};
+        int16_t vitalidad {};
+        int16_t puntos_accion {};
+        // cambios de los valores de ataque y defensa por habilidades auto-aplicadas, por tipo
+        std::array <int16_t, ReglasPartida::maximoTiposEstadistica> cambio_ataque {};
+        std::array <int16_t, ReglasPartida::maximoTiposEstadistica> cambio_defensa {};
+    };
+
+
+    struct EstadoPartida {
+
+        static constexpr int8_t ninguno = -1;
+
+        std::array <EstadoPersonaje, ReglasPartida::maximoPersonajes> personajes {};
+        int8_t  cuenta_personajes {};
+
+        int16_t ronda {};
+        int16_t turno {};
+        int16_t jugada {};
+
+        // el lado que elige personaje mientras no hay atacante
+        LadoTablero lado_elige {LadoTablero::nulo};
+        // en el modo por equipos, el equipo inicial; en el modo libre, el equipo del turno
+        LadoTablero lado_actual {LadoTablero::nulo};
+        // en el modo por equipos, posición del atacante en el orden alterno de los dos equipos
+        int8_t factor {ninguno};
+        // personaje elegido en cada lado para el turno ('indiceLado')
+        std::array <int8_t, 2> elegido { ninguno, ninguno };
+        int8_t atacante {ninguno};
+
+        // de todo lo anterior; véase: 'ClaveZobrist'
+        uint64_t clave {};
+
+    };
+
+
+    static_assert (std::is_trivially_copyable_v <EstadoPartida>);
+
+
+}
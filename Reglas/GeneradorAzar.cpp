@@ -0,0 +1,56 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   GeneradorAzar.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    void GeneradorAzar::siembra (uint64_t semilla, uint64_t secuencia) {
+        semilla_   = semilla;
+        estado     = 0;
+        incremento = (secuencia << 1) | 1;
+        siguiente ();
+        estado += semilla;
+        siguiente ();
+    }
+
+
+    uint64_t GeneradorAzar::semilla () const {
+        return semilla_;
+    }
+
+
+    uint32_t GeneradorAzar::siguiente () {
+        uint64_t previo = estado;
+        estado = previo * 6364136223846793005ULL + incremento;
+        uint32_t mezcla = static_cast <uint32_t> (((previo >> 18) ^ previo) >> 27);
+        uint32_t giro   = static_cast <uint32_t> (previo >> 59);
+        return (mezcla >> giro) | (mezcla << ((0 - giro) & 31));
+    }
+
+
+    int GeneradorAzar::entero (uint32_t contador) {
+        assert (contador > 0);
+        // se descartan los valores del tramo final que no llena un ciclo completo de 'contador'
+        uint32_t umbral = (0 - contador) % contador;
+        uint32_t valor;
+        do {
+            valor = siguiente ();
+        } while (valor < umbral);
+        return static_cast <int> (valor % contador);
+    }
+
+
+    uint64_t GeneradorAzar::semillaSistema () {
+        std::random_device entropia {};
+        uint64_t alto = entropia ();
+        uint64_t bajo = entropia ();
+        return (alto << 32) | bajo;
+    }
+
+
+}
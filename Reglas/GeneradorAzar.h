@@ -0,0 +1,38 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  GeneradorAzar.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Generador PCG32 (XSH-RR): 16 bytes de estado y unas pocas operaciones por número. Con la misma 
+    // semilla y secuencia produce siempre la misma serie, lo que permite repetir una partida. Dos 
+    // generadores con la misma semilla y distinta secuencia dan series independientes.
+    class GeneradorAzar {
+    public:
+
+        void siembra (uint64_t semilla, uint64_t secuencia = 0);
+        uint64_t semilla () const;
+
+        uint32_t siguiente ();
+
+        // entero uniforme entre 0 y 'contador' - 1, sin sesgo
+        int entero (uint32_t contador);
+
+        // semilla tomada de la entropía del sistema
+        static uint64_t semillaSistema ();
+
+    private:
+
+        uint64_t estado {};
+        uint64_t incremento {};
+        uint64_t semilla_ {};
+
+    };
+
+
+}
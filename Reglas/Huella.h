@@ -0,0 +1,45 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  Huella.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Resumen de 64 bits (FNV-1a) de una serie de valores, para reconocer una configuración sin 
+    // compararla entera. No es criptográfico: solo distingue configuraciones distintas por descuido.
+    // Los valores se resumen con su representación en memoria; no debe usarse con tipos que 
+    // tengan relleno entre sus miembros.
+    class Huella {
+    public:
+
+        void agrega (const void * datos, size_t longitud) {
+            const unsigned char * octeto = static_cast <const unsigned char *> (datos);
+            for (size_t indc = 0; indc < longitud; ++ indc) {
+                valor_ ^= octeto [indc];
+                valor_ *= primo;
+            }
+        }
+
+        template <typename Tipo>
+        void agrega (const Tipo & dato) {
+            static_assert (std::is_trivially_copyable_v <Tipo>);
+            agrega (& dato, sizeof (Tipo));
+        }
+
+        uint64_t valor () const { return valor_; }
+
+    private:
+
+        static constexpr uint64_t base  = 14695981039346656037ull;
+        static constexpr uint64_t primo = 1099511628211ull;
+
+        uint64_t valor_ {base};
+
+    };
+
+
+}
@@ -0,0 +1,48 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  Jugada.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    enum class TipoJugada : int8_t {
+        // elección del personaje de un lado para el turno
+        elige,
+        // desplazamiento en línea recta hasta 'celda'
+        desplaza,
+        // habilidad auto-aplicada
+        habilidadSimple,
+        // habilidad sobre el personaje 'objetivo'
+        habilidadOponente,
+        // habilidad sobre el área centrada en 'celda'
+        habilidadArea,
+        // el atacante renuncia a los puntos de acción que le quedan
+        cede,
+    };
+
+
+    // Una decisión de un jugador, tal como la aplica 'MotorReglas'. Los campos que no usa el tipo
+    // de jugada valen 'ninguno'. 
+    struct Jugada {
+
+        static constexpr int8_t ninguno = -1;
+
+        TipoJugada tipo {TipoJugada::cede};
+        int8_t     personaje {ninguno};
+        // índice en 'ReglasPartida::habilidades'
+        int8_t     habilidad {ninguno};
+        int8_t     objetivo  {ninguno};
+        int16_t    celda {TableroReglas::nula};
+        // coste en puntos de acción
+        int16_t    puntos {};
+
+        bool operator == (const Jugada &) const = default;
+
+    };
+
+
+}
@@ -0,0 +1,840 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   MotorReglas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    using Campo = ClaveZobrist::Campo;
+
+
+    MotorReglas::MotorReglas (const ReglasPartida & reglas, ModoReglas modo) {
+        this->reglas_ = & reglas;
+        this->modo_   = modo;
+        assert (reglas_->compilada ());
+        for (int indc = 0; indc < reglas_->cuentaPersonajes (); ++ indc) {
+            personajes_lado [indiceLado (reglas_->personaje (indc).lado)].push_back (indc);
+        }
+        if (modo_ != ModoReglas::pares && personajes_lado [0].size () != personajes_lado [1].size ()) {
+            throw std::logic_error {"MotorReglas: los modos por equipos necesitan el mismo número de personajes en los dos lados"};
+        }
+    }
+
+
+    const ReglasPartida & MotorReglas::reglas () const {
+        return * reglas_;
+    }
+
+
+    ModoReglas MotorReglas::modo () const {
+        return modo_;
+    }
+
+
+    void MotorReglas::inicia (EstadoPartida & estado, const std::vector <int> & celdas, GeneradorAzar & azar) const {
+        int desempate = 0;
+        if (usaDesempateInicial ()) {
+            desempate = azar.entero (2);
+        }
+        inicia (estado, celdas, desempate);
+    }
+
+
+    void MotorReglas::inicia (EstadoPartida & estado, const std::vector <int> & celdas, int desempate) const {
+        assert (std::ssize (celdas) == reglas_->cuentaPersonajes ());
+        estado = EstadoPartida {};
+        estado.cuenta_personajes = static_cast <int8_t> (reglas_->cuentaPersonajes ());
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            EstadoPersonaje & persj = estado.personajes [indc];
+            persj.celda         = static_cast <int16_t> (celdas [indc]);
+            persj.vitalidad     = ReglasPartida::maximaVitalidad;
+            persj.puntos_accion = ReglasPartida::maximoPuntosAccion;
+        }
+        estado.ronda      = 1;
+        estado.turno      = 1;
+        estado.jugada     = 1;
+        switch (modo_) {
+        case ModoReglas::pares:
+            estado.lado_elige = LadoTablero::Izquierda;
+            break;
+        case ModoReglas::equipo:
+            // véase: 'tapete::ModoJuegoEquipo::entraPartida' y 'entraInicioJugada'
+            estado.lado_actual = equipoIniciativa (desempate);
+            buscaFactor (estado);
+            break;
+        case ModoReglas::libreDoble:
+            // véase: 'tapete::ModoJuegoLibreDoble::entraPartida'
+            estado.lado_actual = equipoIniciativa (desempate);
+            estado.lado_elige  = estado.lado_actual;
+            break;
+        }
+        estado.clave = ClaveZobrist::calcula (estado);
+    }
+
+
+    // véase: 'tapete::ModoJuegoBase::eligeEquipoIniciativa'
+    LadoTablero MotorReglas::equipoIniciativa (int desempate) const {
+        std::array <int, 2> iniciativa {};
+        for (int indc = 0; indc < reglas_->cuentaPersonajes (); ++ indc) {
+            int & maxima = iniciativa [indiceLado (reglas_->personaje (indc).lado)];
+            maxima = std::max (maxima, reglas_->personaje (indc).iniciativa);
+        }
+        if (iniciativa [0] > iniciativa [1]) {
+            return LadoTablero::Izquierda;
+        }
+        if (iniciativa [1] > iniciativa [0]) {
+            return LadoTablero::Derecha;
+        }
+        return desempate == 0 ? LadoTablero::Izquierda : LadoTablero::Derecha;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void MotorReglas::generaJugadas (const EstadoPartida & estado, std::vector <Jugada> & jugadas) const {
+        jugadas.clear ();
+        if (terminada (estado)) {
+            return;
+        }
+        if (estado.atacante == EstadoPartida::ninguno) {
+            for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+                if (reglas_->personaje (indc).lado == estado.lado_elige && puedeActuar (estado, indc)) {
+                    Jugada jugada {};
+                    jugada.tipo      = TipoJugada::elige;
+                    jugada.personaje = static_cast <int8_t> (indc);
+                    jugadas.push_back (jugada);
+                }
+            }
+            return;
+        }
+        //
+        TableroReglas::Celdas celdas_ocupadas = ocupadas (estado);
+        generaDesplazamientos (estado, celdas_ocupadas, jugadas);
+        generaHabilidades     (estado, celdas_ocupadas, jugadas);
+        if (jugadas.empty ()) {
+            Jugada jugada {};
+            jugada.tipo      = TipoJugada::cede;
+            jugada.personaje = estado.atacante;
+            jugada.puntos    = estado.personajes [estado.atacante].puntos_accion;
+            jugadas.push_back (jugada);
+        }
+    }
+
+
+    void MotorReglas::generaDesplazamientos (
+            const EstadoPartida &         estado, 
+            const TableroReglas::Celdas & ocupadas, 
+            std::vector <Jugada> &        jugadas  ) const {
+        // véase: 'tapete::AlcanceDesplaza::calcula', con un camino de una sola etapa
+        const EstadoPersonaje & atacante = estado.personajes [estado.atacante];
+        float desplaza = reglas_->puntosAccionDeDesplaza ();
+        float limite   = (atacante.puntos_accion + 0.5f) * desplaza;
+        if (reglas_->destinosPreparados ()) {
+            generaDestinos (estado, ocupadas, limite, jugadas);
+            return;
+        }
+        for (int celda = 0; celda < TableroReglas::cuentaCeldas; ++ celda) {
+            if (celda == atacante.celda || ocupadas.test (celda)) {
+                continue;
+            }
+            float longitud = TableroReglas::longitud (atacante.celda, celda);
+            if (longitud >= limite) {
+                continue;
+            }
+            int punts = static_cast <int> (std::round (longitud / desplaza));
+            // un desplazamiento sin coste no haría avanzar la partida
+            if (punts == 0 || punts > atacante.puntos_accion) {
+                continue;
+            }
+            if (! TableroReglas::segmentoLibre (ocupadas, atacante.celda, celda)) {
+                continue;
+            }
+            Jugada jugada {};
+            jugada.tipo      = TipoJugada::desplaza;
+            jugada.personaje = estado.atacante;
+            jugada.celda     = static_cast <int16_t> (celda);
+            jugada.puntos    = static_cast <int16_t> (punts);
+            jugadas.push_back (jugada);
+        }
+    }
+
+
+    void MotorReglas::generaDestinos (
+            const EstadoPartida &         estado, 
+            const TableroReglas::Celdas & ocupadas, 
+            float                         limite, 
+            std::vector <Jugada> &        jugadas  ) const {
+        // Los destinos preparados ya descartan los muros; falta descartar los segmentos que 
+        // atraviesan a otro personaje. El recorrido de 'segmentoLibre' es un camino mínimo por 
+        // vecinas que no se aparta de la recta más de media casilla, así que solo puede atravesar 
+        // una celda que esté entre origen y destino a la distancia justa y cerca de la recta; si 
+        // ningún personaje lo está, no hace falta recorrerlo.
+        const EstadoPersonaje & atacante = estado.personajes [estado.atacante];
+        std::array <int, ReglasPartida::maximoPersonajes> celdas_ocupantes {};
+        std::array <int, ReglasPartida::maximoPersonajes> distancias_ocupantes {};
+        int cuenta_ocupantes = 0;
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            int celda = estado.personajes [indc].celda;
+            if (indc != estado.atacante && celda != TableroReglas::nula) {
+                celdas_ocupantes     [cuenta_ocupantes] = celda;
+                distancias_ocupantes [cuenta_ocupantes] = TableroReglas::distancia (atacante.celda, celda);
+                cuenta_ocupantes ++;
+            }
+        }
+        for (const ReglasPartida::Destino & destino : reglas_->destinos (atacante.celda)) {
+            if (destino.longitud >= limite || destino.puntos > atacante.puntos_accion) {
+                continue;
+            }
+            if (ocupadas.test (destino.celda)) {
+                continue;
+            }
+            int distancia = TableroReglas::distancia (atacante.celda, destino.celda);
+            bool recorre = false;
+            for (int indc = 0; indc < cuenta_ocupantes; ++ indc) {
+                if (distancias_ocupantes [indc] + 
+                    TableroReglas::distancia (celdas_ocupantes [indc], destino.celda) == distancia && 
+                    TableroReglas::desviacion (atacante.celda, destino.celda, celdas_ocupantes [indc]) < 
+                    TableroReglas::ladoHexagono                                                           ) {
+                    recorre = true;
+                    break;
+                }
+            }
+            if (recorre && ! TableroReglas::segmentoLibre (ocupadas, atacante.celda, destino.celda)) {
+                continue;
+            }
+            Jugada jugada {};
+            jugada.tipo      = TipoJugada::desplaza;
+            jugada.personaje = estado.atacante;
+            jugada.celda     = destino.celda;
+            jugada.puntos    = destino.puntos;
+            jugadas.push_back (jugada);
+        }
+    }
+
+
+    void MotorReglas::generaHabilidades (
+            const EstadoPartida &         estado, 
+            const TableroReglas::Celdas & ocupadas, 
+            std::vector <Jugada> &        jugadas  ) const {
+        int atacante = estado.atacante;
+        const EstadoPersonaje & persj_ataca = estado.personajes [atacante];
+        LadoTablero lado_ataca = reglas_->personaje (atacante).lado;
+        for (int indice_habilidad : reglas_->personaje (atacante).habilidades) {
+            const ReglasPartida::Habilidad & habilidad = reglas_->habilidad (indice_habilidad);
+            if (habilidad.coste > persj_ataca.puntos_accion) {
+                continue;
+            }
+            Jugada jugada {};
+            jugada.personaje = static_cast <int8_t>  (atacante);
+            jugada.habilidad = static_cast <int8_t>  (indice_habilidad);
+            jugada.puntos    = static_cast <int16_t> (habilidad.coste);
+            switch (habilidad.enfoque) {
+            case EnfoqueHabilidad::si_mismo:
+                jugada.tipo = TipoJugada::habilidadSimple;
+                jugadas.push_back (jugada);
+                break;
+            case EnfoqueHabilidad::personaje:
+                // véase: 'tapete::ModoJuegoComun', los aliados solo para curar
+                jugada.tipo = TipoJugada::habilidadOponente;
+                for (int objetivo = 0; objetivo < estado.cuenta_personajes; ++ objetivo) {
+                    const EstadoPersonaje & persj_objtv = estado.personajes [objetivo];
+                    if (objetivo == atacante || persj_objtv.vitalidad <= 0) {
+                        continue;
+                    }
+                    bool aliado = reglas_->personaje (objetivo).lado == lado_ataca;
+                    if (aliado != (habilidad.antagonista == Antagonista::aliado)) {
+                        continue;
+                    }
+                    if (TableroReglas::distancia (persj_ataca.celda, persj_objtv.celda) > habilidad.alcance) {
+                        continue;
+                    }
+                    if (! accesoValido (ocupadas, habilidad, persj_ataca.celda, persj_objtv.celda)) {
+                        continue;
+                    }
+                    jugada.objetivo = static_cast <int8_t> (objetivo);
+                    jugadas.push_back (jugada);
+                }
+                break;
+            case EnfoqueHabilidad::area:
+                jugada.tipo = TipoJugada::habilidadArea;
+                for (int celda = 0; celda < TableroReglas::cuentaCeldas; ++ celda) {
+                    if (reglas_->muros ().test (celda)) {
+                        continue;
+                    }
+                    if (TableroReglas::distancia (persj_ataca.celda, celda) > habilidad.alcance) {
+                        continue;
+                    }
+                    if (! areaConPersonajes (estado, celda, habilidad.radio_alcance)) {
+                        continue;
+                    }
+                    if (! accesoValido (ocupadas, habilidad, persj_ataca.celda, celda)) {
+                        continue;
+                    }
+                    jugada.celda = static_cast <int16_t> (celda);
+                    jugadas.push_back (jugada);
+                }
+                break;
+            }
+        }
+    }
+
+
+    bool MotorReglas::accesoValido (
+            const TableroReglas::Celdas &    ocupadas, 
+            const ReglasPartida::Habilidad & habilidad, 
+            int celda_origen, int celda_destino ) const {
+        if (habilidad.acceso != AccesoHabilidad::directo) {
+            return true;
+        }
+        // 'tapete::CalculoCaminos::segmentoValido' no admite un segmento nulo
+        if (celda_origen == celda_destino) {
+            return false;
+        }
+        return TableroReglas::segmentoLibre (ocupadas, celda_origen, celda_destino);
+    }
+
+
+    bool MotorReglas::areaConPersonajes (
+            const EstadoPartida & estado, int celda_centro, int radio_alcance) const {
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            const EstadoPersonaje & persj = estado.personajes [indc];
+            if (persj.vitalidad > 0 && TableroReglas::distancia (celda_centro, persj.celda) <= radio_alcance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    bool MotorReglas::jugadaValida (const EstadoPartida & estado, const Jugada & jugada) const {
+        std::vector <Jugada> jugadas {};
+        generaJugadas (estado, jugadas);
+        return std::find (jugadas.begin (), jugadas.end (), jugada) != jugadas.end ();
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    bool MotorReglas::usaAleatorio (const Jugada & jugada) const {
+        return jugada.tipo == TipoJugada::habilidadOponente || 
+               jugada.tipo == TipoJugada::habilidadArea       ;
+    }
+
+
+    bool MotorReglas::usaDesempate (const EstadoPartida & estado, const Jugada & jugada) const {
+        if (modo_ != ModoReglas::pares || jugada.tipo != TipoJugada::elige) {
+            return false;
+        }
+        LadoTablero lado = reglas_->personaje (jugada.personaje).lado;
+        int otro = estado.elegido [indiceLado (opuesto (lado))];
+        if (otro == EstadoPartida::ninguno) {
+            return false;
+        }
+        return reglas_->personaje (jugada.personaje).iniciativa == reglas_->personaje (otro).iniciativa;
+    }
+
+
+    bool MotorReglas::usaDesempateInicial () const {
+        if (modo_ == ModoReglas::pares) {
+            return false;
+        }
+        return equipoIniciativa (0) != equipoIniciativa (1);
+    }
+
+
+    void MotorReglas::aplica (
+            EstadoPartida &    estado, 
+            const Jugada &     jugada, 
+            GeneradorAzar &    azar, 
+            ObservadorReglas * observador ) const {
+        int desempate     = 0;
+        int aleatorio_100 = 0;
+        if (usaDesempate (estado, jugada)) {
+            desempate = azar.entero (2);
+        }
+        if (usaAleatorio (jugada)) {
+            aleatorio_100 = azar.entero (100);
+        }
+        aplica (estado, jugada, aleatorio_100, desempate, observador);
+    }
+
+
+    void MotorReglas::aplica (
+            EstadoPartida &    estado, 
+            const Jugada &     jugada, 
+            int                aleatorio_100, 
+            int                desempate, 
+            ObservadorReglas * observador ) const {
+        assert (jugadaValida (estado, jugada));
+        assert (0 <= aleatorio_100 && aleatorio_100 < 100);
+        // los campos que no son de los personajes se cambian aquí y en 'asume': su parte de la 
+        // clave se quita antes y se vuelve a poner después
+        estado.clave ^= ClaveZobrist::control (estado);
+        if (jugada.tipo == TipoJugada::elige) {
+            elige (estado, jugada, desempate, observador);
+        } else {
+            efectua (estado, jugada, aleatorio_100, observador);
+            asume (estado, observador);
+        }
+        estado.clave ^= ClaveZobrist::control (estado);
+        assert (estado.clave == ClaveZobrist::calcula (estado));
+    }
+
+
+    void MotorReglas::elige (
+            EstadoPartida &    estado, 
+            const Jugada &     jugada, 
+            int                desempate, 
+            ObservadorReglas * observador ) const {
+        LadoTablero lado = reglas_->personaje (jugada.personaje).lado;
+        estado.elegido [indiceLado (lado)] = jugada.personaje;
+        if (observador != nullptr) {
+            observador->personajeElegido (jugada.personaje);
+        }
+        if (modo_ == ModoReglas::libreDoble) {
+            // véase: 'tapete::ModoJuegoLibreDoble::entraInicioJugada'
+            estado.atacante   = jugada.personaje;
+            estado.lado_elige = LadoTablero::nulo;
+            if (observador != nullptr) {
+                observador->atacanteEstablecido (estado.atacante);
+            }
+            return;
+        }
+        if (estado.elegido [indiceLado (opuesto (lado))] == EstadoPartida::ninguno) {
+            estado.lado_elige = opuesto (lado);
+            return;
+        }
+        // véase: 'tapete::ModoJuegoBase::eligeAtacanteIniciativa'
+        int iniciativa_izqrd = reglas_->personaje (estado.elegido [0]).iniciativa;
+        int iniciativa_derch = reglas_->personaje (estado.elegido [1]).iniciativa;
+        LadoTablero lado_ataca;
+        if (iniciativa_izqrd > iniciativa_derch) {
+            lado_ataca = LadoTablero::Izquierda;
+        } else if (iniciativa_izqrd < iniciativa_derch) {
+            lado_ataca = LadoTablero::Derecha;
+        } else {
+            lado_ataca = desempate == 0 ? LadoTablero::Izquierda : LadoTablero::Derecha;
+        }
+        estado.atacante   = estado.elegido [indiceLado (lado_ataca)];
+        estado.lado_elige = LadoTablero::nulo;
+        if (observador != nullptr) {
+            observador->atacanteEstablecido (estado.atacante);
+        }
+    }
+
+
+    void MotorReglas::efectua (
+            EstadoPartida &    estado, 
+            const Jugada &     jugada, 
+            int                aleatorio_100, 
+            ObservadorReglas * observador ) const {
+        assert (estado.atacante != EstadoPartida::ninguno && jugada.personaje == estado.atacante);
+        assert (0 <= aleatorio_100 && aleatorio_100 < 100);
+        //
+        EstadoPersonaje & atacante = estado.personajes [estado.atacante];
+        switch (jugada.tipo) {
+        case TipoJugada::desplaza: {
+            int celda_sale = atacante.celda;
+            ClaveZobrist::cambia (estado, Campo::celda, estado.atacante, 0, atacante.celda, jugada.celda);
+            ClaveZobrist::cambia (estado, Campo::puntosAccion, estado.atacante, 0, 
+                                  atacante.puntos_accion, atacante.puntos_accion - jugada.puntos);
+            if (observador != nullptr) {
+                observador->fichaDesplazada (estado.atacante, celda_sale, jugada.celda);
+            }
+            break;
+        }
+        case TipoJugada::habilidadSimple:
+        case TipoJugada::habilidadOponente:
+        case TipoJugada::habilidadArea:
+            aplicaHabilidad (estado, jugada, aleatorio_100, observador);
+            break;
+        case TipoJugada::cede:
+            ClaveZobrist::cambia (estado, Campo::puntosAccion, estado.atacante, 0, atacante.puntos_accion, 0);
+            break;
+        default:
+            assert (false);
+        }
+    }
+
+
+    void MotorReglas::aplicaHabilidad (
+            EstadoPartida &    estado, 
+            const Jugada &     jugada, 
+            int                aleatorio_100, 
+            ObservadorReglas * observador ) const {
+        const ReglasPartida::Habilidad & habilidad = reglas_->habilidad (jugada.habilidad);
+        EstadoPersonaje & atacante = estado.personajes [jugada.personaje];
+        if (observador != nullptr) {
+            observador->habilidadAplicada (
+                    jugada.personaje, jugada.habilidad, usaAleatorio (jugada) ? aleatorio_100 : 0);
+        }
+        switch (habilidad.enfoque) {
+        case EnfoqueHabilidad::si_mismo:
+            // véase: 'tapete::SistemaAtaque::calcula', el cambio sustituye al anterior
+            for (const std::pair <int, int> & efecto : habilidad.efectos_ataque) {
+                ClaveZobrist::cambia (estado, Campo::cambioAtaque, jugada.personaje, efecto.first, 
+                                      atacante.cambio_ataque [efecto.first], efecto.second);
+            }
+            for (const std::pair <int, int> & efecto : habilidad.efectos_defensa) {
+                ClaveZobrist::cambia (estado, Campo::cambioDefensa, jugada.personaje, efecto.first, 
+                                      atacante.cambio_defensa [efecto.first], efecto.second);
+            }
+            break;
+        case EnfoqueHabilidad::personaje:
+            afectaPersonaje (
+                    estado, jugada.personaje, jugada.habilidad, jugada.objetivo, 
+                    aleatorio_100, observador);
+            break;
+        case EnfoqueHabilidad::area: {
+            std::vector <int> afectados {};
+            personajesArea (estado, jugada.celda, habilidad.radio_alcance, afectados);
+            for (int objetivo : afectados) {
+                afectaPersonaje (
+                        estado, jugada.personaje, jugada.habilidad, objetivo, 
+                        aleatorio_100, observador);
+            }
+            break;
+        }
+        }
+        ClaveZobrist::cambia (estado, Campo::puntosAccion, jugada.personaje, 0, 
+                              atacante.puntos_accion, atacante.puntos_accion - habilidad.coste);
+    }
+
+
+    void MotorReglas::afectaPersonaje (
+            EstadoPartida &    estado, 
+            int                atacante, 
+            int                habilidad, 
+            int                objetivo, 
+            int                aleatorio_100,
+            ObservadorReglas * observador ) const {
+        EstadoPersonaje & persj_objtv = estado.personajes [objetivo];
+        int vitalidad_origen = persj_objtv.vitalidad;
+        if (vitalidad_origen <= 0) {
+            return;
+        }
+        int vitalidad_final;
+        if (reglas_->habilidad (habilidad).antagonista == Antagonista::oponente) {
+            vitalidad_final = vitalidad_origen - danoAtaque (estado, atacante, habilidad, objetivo, aleatorio_100);
+        } else {
+            vitalidad_final = vitalidad_origen + reglas_->habilidad (habilidad).valor_curacion;
+        }
+        vitalidad_final = std::clamp (vitalidad_final, 0, ReglasPartida::maximaVitalidad);
+        ClaveZobrist::cambia (estado, Campo::vitalidad, objetivo, 0, persj_objtv.vitalidad, vitalidad_final);
+        if (observador != nullptr) {
+            observador->vitalidadCambiada (objetivo, vitalidad_origen, vitalidad_final);
+        }
+    }
+
+
+    void MotorReglas::asume (EstadoPartida & estado, ObservadorReglas * observador) const {
+        if (modo_ == ModoReglas::equipo) {
+            asumeEquipo (estado, observador);
+            return;
+        }
+        if (modo_ == ModoReglas::libreDoble) {
+            asumeLibre (estado, observador);
+            return;
+        }
+        // véase: 'tapete::ModoJuegoPares::asume' e 'ignoraPersonajeAgotado'
+        int activo = estado.atacante;
+        int otro   = estado.elegido [indiceLado (opuesto (reglas_->personaje (activo).lado))];
+        estado.jugada ++;
+        if (puedeActuar (estado, otro)) {
+            estado.atacante = static_cast <int8_t> (otro);
+        } else if (! puedeActuar (estado, activo)) {
+            terminaTurno (estado, observador);
+            return;
+        }
+        if (observador != nullptr) {
+            observador->atacanteEstablecido (estado.atacante);
+        }
+    }
+
+
+    void MotorReglas::terminaTurno (EstadoPartida & estado, ObservadorReglas * observador) const {
+        // véase: 'tapete::ModoJuegoPares::reiniciaTurno'
+        estado.elegido    = { EstadoPartida::ninguno, EstadoPartida::ninguno };
+        estado.atacante   = EstadoPartida::ninguno;
+        estado.lado_elige = LadoTablero::Izquierda;
+        if (observador != nullptr) {
+            observador->turnoTerminado ();
+        }
+        if (disponiblesAmbos (estado)) {
+            estado.turno ++;
+            estado.jugada = 1;
+            return;
+        }
+        terminaRonda (estado, observador);
+    }
+
+
+    void MotorReglas::asumeEquipo (EstadoPartida & estado, ObservadorReglas * observador) const {
+        // véase: 'tapete::ModoJuegoEquipo::asume' y 'entraInicioJugada'
+        estado.elegido  = { EstadoPartida::ninguno, EstadoPartida::ninguno };
+        estado.atacante = EstadoPartida::ninguno;
+        if (! buscaFactor (estado)) {
+            if (observador != nullptr) {
+                observador->turnoTerminado ();
+            }
+            estado.factor = EstadoPartida::ninguno;
+            if (disponiblesAmbos (estado)) {
+                estado.turno ++;
+                estado.jugada = 1;
+            } else {
+                terminaRonda (estado, observador);
+            }
+            if (! buscaFactor (estado)) {
+                // no queda nadie vivo
+                return;
+            }
+        }
+        if (observador != nullptr) {
+            observador->atacanteEstablecido (estado.atacante);
+        }
+    }
+
+
+    // véase: 'tapete::ModoJuegoEquipo::buscaJugada'; cada posición que avanza es una jugada
+    bool MotorReglas::buscaFactor (EstadoPartida & estado) const {
+        int cuenta_factores = static_cast <int> (personajes_lado [0].size () * 2);
+        while (true) {
+            if (estado.factor == EstadoPartida::ninguno) {
+                estado.factor = 0;
+            } else {
+                estado.factor ++;
+                if (estado.factor >= cuenta_factores) {
+                    return false;
+                }
+                estado.jugada ++;
+            }
+            LadoTablero lado = estado.factor % 2 == 0 ? estado.lado_actual : opuesto (estado.lado_actual);
+            int personaje = personajes_lado [indiceLado (lado)] [estado.factor / 2];
+            if (puedeActuar (estado, personaje)) {
+                estado.elegido [indiceLado (lado)] = static_cast <int8_t> (personaje);
+                estado.atacante = static_cast <int8_t> (personaje);
+                return true;
+            }
+        }
+    }
+
+
+    void MotorReglas::asumeLibre (EstadoPartida & estado, ObservadorReglas * observador) const {
+        // véase: 'tapete::ModoJuegoLibreDoble::asume' e 'ignoraPersonajeAgotado'
+        if (estado.jugada == 1 && puedeActuar (estado, estado.atacante)) {
+            estado.jugada ++;
+            if (observador != nullptr) {
+                observador->atacanteEstablecido (estado.atacante);
+            }
+            return;
+        }
+        estado.elegido     = { EstadoPartida::ninguno, EstadoPartida::ninguno };
+        estado.atacante    = EstadoPartida::ninguno;
+        estado.lado_actual = opuesto (estado.lado_actual);
+        if (observador != nullptr) {
+            observador->turnoTerminado ();
+        }
+        if (disponiblesAmbos (estado)) {
+            estado.turno ++;
+            estado.jugada = 1;
+        } else {
+            terminaRonda (estado, observador);
+        }
+        estado.lado_elige = estado.lado_actual;
+    }
+
+
+    // véase: 'tapete::ModoJuegoBase::turnosDisponiblesAmbos'
+    bool MotorReglas::disponiblesAmbos (const EstadoPartida & estado) const {
+        std::array <bool, 2> disponible {};
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            if (puedeActuar (estado, indc)) {
+                disponible [indiceLado (reglas_->personaje (indc).lado)] = true;
+            }
+        }
+        return disponible [0] && disponible [1];
+    }
+
+
+    void MotorReglas::terminaRonda (EstadoPartida & estado, ObservadorReglas * observador) const {
+        // véase: 'tapete::ModoJuegoBase::avanzaRonda' y 'restauraPersonajes'
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            EstadoPersonaje & persj = estado.personajes [indc];
+            estado.clave ^= ClaveZobrist::personaje (persj, indc);
+            persj.puntos_accion = ReglasPartida::maximoPuntosAccion;
+            persj.cambio_ataque .fill (0);
+            persj.cambio_defensa.fill (0);
+            estado.clave ^= ClaveZobrist::personaje (persj, indc);
+        }
+        estado.ronda ++;
+        estado.turno  = 1;
+        estado.jugada = 1;
+        if (observador != nullptr) {
+            observador->rondaTerminada ();
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    bool MotorReglas::terminada (const EstadoPartida & estado) const {
+        return ganador (estado) != LadoTablero::nulo || 
+               std::none_of (estado.personajes.begin (), estado.personajes.begin () + estado.cuenta_personajes, 
+                             [] (const EstadoPersonaje & persj) { return persj.vitalidad > 0; });
+    }
+
+
+    LadoTablero MotorReglas::ganador (const EstadoPartida & estado) const {
+        std::array <bool, 2> vivo {};
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            if (estado.personajes [indc].vitalidad > 0) {
+                vivo [indiceLado (reglas_->personaje (indc).lado)] = true;
+            }
+        }
+        if (vivo [0] == vivo [1]) {
+            return LadoTablero::nulo;
+        }
+        return vivo [0] ? LadoTablero::Izquierda : LadoTablero::Derecha;
+    }
+
+
+    bool MotorReglas::puedeActuar (const EstadoPartida & estado, int personaje) const {
+        const EstadoPersonaje & persj = estado.personajes [personaje];
+        return persj.vitalidad > 0 && persj.puntos_accion > 0;
+    }
+
+
+    LadoTablero MotorReglas::ladoDecide (const EstadoPartida & estado) const {
+        if (estado.atacante == EstadoPartida::ninguno) {
+            return estado.lado_elige;
+        }
+        return reglas_->personaje (estado.atacante).lado;
+    }
+
+
+    TableroReglas::Celdas MotorReglas::ocupadas (const EstadoPartida & estado) const {
+        TableroReglas::Celdas celdas = reglas_->muros ();
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            if (estado.personajes [indc].celda != TableroReglas::nula) {
+                celdas.set (estado.personajes [indc].celda);
+            }
+        }
+        return celdas;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    int MotorReglas::valorAtaque (const EstadoPartida & estado, int personaje, int tipo_ataque) const {
+        assert (reglas_->personaje (personaje).aparece_ataque.test (tipo_ataque));
+        return reglas_->personaje (personaje).ataque [tipo_ataque] + 
+               estado.personajes [personaje].cambio_ataque [tipo_ataque];
+    }
+
+
+    int MotorReglas::valorDefensa (const EstadoPartida & estado, int personaje, int tipo_defensa) const {
+        assert (reglas_->personaje (personaje).aparece_defensa.test (tipo_defensa));
+        return reglas_->personaje (personaje).defensa [tipo_defensa] + 
+               estado.personajes [personaje].cambio_defensa [tipo_defensa];
+    }
+
+
+    int MotorReglas::danoAtaque (
+            const EstadoPartida & estado, 
+            int atacante, int habilidad, int objetivo, 
+            int aleatorio_100 ) const {
+        const ReglasPartida::Habilidad & habld = reglas_->habilidad (habilidad);
+        assert (habld.antagonista == Antagonista::oponente);
+        // véase: 'tapete::SistemaAtaque::valoresAtaque'
+        int valor_ataque  = valorAtaque  (estado, atacante, habld.tipo_ataque);
+        int valor_defensa = valorDefensa (estado, objetivo, habld.tipo_defensa);
+        if (valor_ataque <= 0 || ReglasPartida::maximaVitalidad < valor_ataque) {
+            throw std::logic_error {"Reglas de partida mal configuradas, aplicando ataque: valor de ataque inválido"};
+        }
+        if (valor_defensa <= 0 || ReglasPartida::maximaVitalidad < valor_defensa) {
+            throw std::logic_error {"Reglas de partida mal configuradas, aplicando ataque: valor de defensa inválido"};
+        }
+        int valor_final_ataque = valor_ataque - valor_defensa + aleatorio_100;
+        int valor_reduce_dano  = reglas_->personaje (objetivo).reduce_dano [habld.tipo_dano];
+        return ajustaDano (habld.valor_dano, reglas_->porcentajeDano (valor_final_ataque)) - valor_reduce_dano;
+    }
+
+
+    void MotorReglas::distribucionDano (
+            const ReglasPartida &    reglas, 
+            int valor_dano, int ventaja, int reduce_dano, 
+            std::vector <CasoDano> & casos            ) {
+        casos.clear ();
+        for (const ReglasPartida::TramoVentaja & tramo : reglas.tramosVentaja (ventaja)) {
+            casos.push_back ({ ajustaDano (valor_dano, tramo.porcentaje) - reduce_dano, tramo.casos });
+        }
+        std::sort (casos.begin (), casos.end (), 
+                   [] (const CasoDano & uno, const CasoDano & otro) { return uno.dano < otro.dano; });
+        // un mismo daño puede salir de varios tramos
+        size_t destino = 0;
+        for (size_t indc = 0; indc < casos.size (); ++ indc) {
+            if (destino > 0 && casos [destino - 1].dano == casos [indc].dano) {
+                casos [destino - 1].casos += casos [indc].casos;
+            } else {
+                casos [destino ++] = casos [indc];
+            }
+        }
+        casos.resize (destino);
+    }
+
+
+    double MotorReglas::danoEsperado (
+            const EstadoPartida & estado, 
+            int atacante, int habilidad, int objetivo ) const {
+        const ReglasPartida::Habilidad & habld = reglas_->habilidad (habilidad);
+        int vitalidad = estado.personajes [objetivo].vitalidad;
+        if (vitalidad <= 0) {
+            return 0.0;
+        }
+        // véase: 'afectaPersonaje'
+        if (habld.antagonista != Antagonista::oponente) {
+            return - static_cast <double> (std::min (vitalidad + habld.valor_curacion, ReglasPartida::maximaVitalidad) - vitalidad);
+        }
+        // 'danoAtaque' por tramos de 'aleatorio_100'; sin ordenar, porque solo cuenta la suma
+        int ventaja = valorAtaque  (estado, atacante, habld.tipo_ataque) - 
+                      valorDefensa (estado, objetivo, habld.tipo_defensa);
+        int reduce  = reglas_->personaje (objetivo).reduce_dano [habld.tipo_dano];
+        int total   = 0;
+        for (const ReglasPartida::TramoVentaja & tramo : reglas_->tramosVentaja (ventaja)) {
+            int dano = ajustaDano (habld.valor_dano, tramo.porcentaje) - reduce;
+            total += tramo.casos * (vitalidad - std::clamp (vitalidad - dano, 0, ReglasPartida::maximaVitalidad));
+        }
+        return total / 100.0;
+    }
+
+
+    void MotorReglas::personajesArea (
+            const EstadoPartida & estado, 
+            int celda_centro, int radio_alcance, 
+            std::vector <int> & afectados ) const {
+        // véase: 'tapete::ModoJuegoBase::personajesAreaCeldas'; las fichas nunca están en muros
+        afectados.clear ();
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            int celda = estado.personajes [indc].celda;
+            if (celda != TableroReglas::nula && TableroReglas::distancia (celda_centro, celda) <= radio_alcance) {
+                afectados.push_back (indc);
+            }
+        }
+    }
+
+
+    int MotorReglas::ajustaDano (int valor_dano, int porcentaje_dano) {
+        // véase: 'tapete::SistemaAtaque::ajustaDano'
+        return (int) (valor_dano * (((float) porcentaje_dano) / 100.0f));
+    }
+
+
+}
@@ -0,0 +1,201 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  MotorReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Avisos de 'MotorReglas' mientras aplica una jugada, para que una presentación siga la 
+    // partida sin conocer las reglas. Por omisión no hacen nada.
+    class ObservadorReglas {
+    public:
+
+        virtual ~ObservadorReglas () = default;
+
+        // el personaje, las celdas y las vitalidades como en 'EstadoPartida'
+        virtual void personajeElegido (int /*personaje*/) {}
+        virtual void atacanteEstablecido (int /*personaje*/) {}
+        virtual void fichaDesplazada (int /*personaje*/, int /*celda_sale*/, int /*celda_llega*/) {}
+        virtual void habilidadAplicada (int /*personaje*/, int /*habilidad*/, int /*aleatorio_100*/) {}
+        virtual void vitalidadCambiada (int /*personaje*/, int /*vitalidad_origen*/, int /*vitalidad_final*/) {}
+        virtual void turnoTerminado () {}
+        virtual void rondaTerminada () {}
+
+    };
+
+
+    // Las reglas de los modos de 'tapete' sobre 'EstadoPartida'. En el modo por parejas 
+    // ('tapete::ModoJuegoPares'):
+    //  *   Mientras no hay atacante, cada lado elige un personaje vivo y con puntos de acción; con
+    //      los dos elegidos, ataca primero el de mayor iniciativa (al azar si empatan).
+    //  *   Cada jugada es una acción del atacante; después, el turno pasa al otro elegido si aún 
+    //      puede actuar. Cuando ninguno puede, termina el turno; y cuando un lado se queda sin 
+    //      personajes que puedan actuar, termina la ronda y se restauran puntos y estadísticas.
+    // En el modo por equipos ('tapete::ModoJuegoEquipo') los personajes de los dos equipos actúan
+    // alternos, empezando por el equipo de mayor iniciativa, una jugada cada uno; en el modo libre 
+    // ('tapete::ModoJuegoLibreDoble') los equipos alternan turnos en los que el jugador elige un 
+    // personaje que hace dos jugadas. En los dos, la ronda termina como en el modo por parejas.
+    // En todos los modos la partida termina cuando un lado no tiene personajes vivos.
+    // Solo se generan jugadas con efecto: desplazamientos de una etapa (los caminos de varias 
+    // etapas se juegan como varias jugadas), habilidades sobre personajes vivos y áreas con algún 
+    // personaje vivo. 'cede' solo se genera cuando el atacante no tiene otra jugada.
+    class MotorReglas {
+    public:
+
+        explicit MotorReglas (const ReglasPartida & reglas, ModoReglas modo = ModoReglas::pares);
+
+        const ReglasPartida & reglas () const;
+        ModoReglas modo () const;
+
+        // ronda, turno y jugada primeros, vitalidad y puntos de acción máximos; 'celdas' tiene la
+        // celda inicial de cada personaje; 'desempate' elige el equipo inicial si 
+        // 'usaDesempateInicial' (0 la izquierda, 1 la derecha)
+        void inicia (EstadoPartida & estado, const std::vector <int> & celdas, int desempate = 0) const;
+        // con el desempate sacado de 'azar' como 'tapete::ModoJuegoBase::eligeEquipoIniciativa'
+        void inicia (EstadoPartida & estado, const std::vector <int> & celdas, GeneradorAzar & azar) const;
+
+        void generaJugadas (const EstadoPartida & estado, std::vector <Jugada> & jugadas) const;
+        bool jugadaValida (const EstadoPartida & estado, const Jugada & jugada) const;
+
+        // Aplica una jugada válida. Los valores al azar se sacan de 'azar' en el mismo orden que 
+        // 'tapete::ModoJuegoBase': un entero de 0 a 1 si empatan las iniciativas y un entero de 
+        // 0 a 99 por cada habilidad que afecta a otros personajes.
+        void aplica (
+                EstadoPartida &    estado, 
+                const Jugada &     jugada, 
+                GeneradorAzar &    azar, 
+                ObservadorReglas * observador = nullptr ) const;
+        // con los valores al azar dados, para recorrer los casos posibles
+        void aplica (
+                EstadoPartida &    estado, 
+                const Jugada &     jugada, 
+                int                aleatorio_100, 
+                int                desempate, 
+                ObservadorReglas * observador = nullptr ) const;
+        // Solo el efecto de la acción del atacante, sin lo que 'aplica' asume después (siguiente 
+        // atacante, final del turno o de la ronda): los modos de 'tapete' pasan antes por sus 
+        // propios estados. No comprueba la jugada; un desplazamiento puede tener varias etapas, 
+        // y 'jugada.puntos' es entonces el coste del camino completo. Mantiene 'estado.clave'.
+        void efectua (
+                EstadoPartida &    estado, 
+                const Jugada &     jugada, 
+                int                aleatorio_100, 
+                ObservadorReglas * observador = nullptr ) const;
+
+        // si la jugada usa 'aleatorio_100' o 'desempate'
+        bool usaAleatorio (const Jugada & jugada) const;
+        bool usaDesempate (const EstadoPartida & estado, const Jugada & jugada) const;
+        // si el equipo inicial se elige al azar (modos por equipos y libre, con las mismas 
+        // iniciativas máximas en los dos lados)
+        bool usaDesempateInicial () const;
+
+        bool terminada (const EstadoPartida & estado) const;
+        // nulo si la partida no ha terminado o no queda nadie vivo
+        LadoTablero ganador (const EstadoPartida & estado) const;
+
+        bool puedeActuar (const EstadoPartida & estado, int personaje) const;
+        // el lado de quien decide la próxima jugada: el que elige o el del atacante
+        LadoTablero ladoDecide (const EstadoPartida & estado) const;
+
+        // muros y fichas (también las de los personajes muertos)
+        TableroReglas::Celdas ocupadas (const EstadoPartida & estado) const;
+
+        int valorAtaque  (const EstadoPartida & estado, int personaje, int tipo_ataque) const;
+        int valorDefensa (const EstadoPartida & estado, int personaje, int tipo_defensa) const;
+
+        // daño que resta a la vitalidad del objetivo; véase 'tapete::SistemaAtaque::calculaAtaque'
+        int danoAtaque (
+                const EstadoPartida & estado, 
+                int atacante, int habilidad, int objetivo, 
+                int aleatorio_100 ) const;
+
+        // La distribución del daño de una habilidad "de ataque" con 'valor_dano', 'ventaja' 
+        // (ataque menos defensa) y 'reduce_dano' para los cien valores de 'aleatorio_100': cada 
+        // daño, de menor a mayor, con cuántos valores lo producen. Sale de 
+        // 'ReglasPartida::tramosVentaja', como 'danoEsperado'; la usa 'tapete::SistemaAtaque'.
+        struct CasoDano {
+            int dano {};
+            int casos {};
+        };
+        static void distribucionDano (
+                const ReglasPartida &    reglas, 
+                int valor_dano, int ventaja, int reduce_dano, 
+                std::vector <CasoDano> & casos            );
+
+        // media, para los cien valores de 'aleatorio_100', de la vitalidad que quita la habilidad 
+        // al objetivo (negativa si la devuelve); para las políticas y las búsquedas
+        double danoEsperado (
+                const EstadoPartida & estado, 
+                int atacante, int habilidad, int objetivo ) const;
+
+        // personajes con la ficha en el área, incluido el atacante
+        void personajesArea (
+                const EstadoPartida & estado, 
+                int celda_centro, int radio_alcance, 
+                std::vector <int> & afectados ) const;
+
+        static int ajustaDano (int valor_dano, int porcentaje_dano);
+
+    private:
+
+        const ReglasPartida * reglas_ {};
+        ModoReglas            modo_ {};
+        // índices de los personajes de cada lado, en orden ('indiceLado')
+        std::array <std::vector <int>, 2> personajes_lado {};
+
+        void generaDesplazamientos (
+                const EstadoPartida &         estado, 
+                const TableroReglas::Celdas & ocupadas, 
+                std::vector <Jugada> &        jugadas  ) const;
+        // con los destinos preparados en las reglas
+        void generaDestinos (
+                const EstadoPartida &         estado, 
+                const TableroReglas::Celdas & ocupadas, 
+                float                         limite, 
+                std::vector <Jugada> &        jugadas  ) const;
+        void generaHabilidades (
+                const EstadoPartida &         estado, 
+                const TableroReglas::Celdas & ocupadas, 
+                std::vector <Jugada> &        jugadas  ) const;
+
+        bool accesoValido (
+                const TableroReglas::Celdas & ocupadas, 
+                const ReglasPartida::Habilidad & habilidad, 
+                int celda_origen, int celda_destino ) const;
+        bool areaConPersonajes (const EstadoPartida & estado, int celda_centro, int radio_alcance) const;
+
+        void elige (
+                EstadoPartida &    estado, 
+                const Jugada &     jugada, 
+                int                desempate, 
+                ObservadorReglas * observador ) const;
+        void aplicaHabilidad (
+                EstadoPartida &    estado, 
+                const Jugada &     jugada, 
+                int                aleatorio_100, 
+                ObservadorReglas * observador ) const;
+        void afectaPersonaje (
+                EstadoPartida &    estado, 
+                int                atacante, 
+                int                habilidad, 
+                int                objetivo, 
+                int                aleatorio_100,
+                ObservadorReglas * observador ) const;
+        void asume (EstadoPartida & estado, ObservadorReglas * observador) const;
+        void asumeEquipo (EstadoPartida & estado, ObservadorReglas * observador) const;
+        void asumeLibre (EstadoPartida & estado, ObservadorReglas * observador) const;
+        void terminaTurno (EstadoPartida & estado, ObservadorReglas * observador) const;
+        void terminaRonda (EstadoPartida & estado, ObservadorReglas * observador) const;
+
+        LadoTablero equipoIniciativa (int desempate) const;
+        bool disponiblesAmbos (const EstadoPartida & estado) const;
+        bool buscaFactor (EstadoPartida & estado) const;
+
+    };
+
+
+}
@@ -0,0 +1,196 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   PoliticaJuego.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    int PoliticaAzar::elige (
+            const MotorReglas &          /*motor*/, 
+            const EstadoPartida &        /*estado*/, 
+            const std::vector <Jugada> & jugadas, 
+            GeneradorAzar &              azar    ) {
+        assert (! jugadas.empty ());
+        constexpr int cuentaTipos = static_cast <int> (TipoJugada::cede) + 1;
+        std::array <int, cuentaTipos> cuenta {};
+        for (const Jugada & jugada : jugadas) {
+            cuenta [static_cast <int> (jugada.tipo)] ++;
+        }
+        int tipos = static_cast <int> (std::count_if (cuenta.begin (), cuenta.end (), [] (int c) { return c > 0; }));
+        int tipo  = azar.entero (tipos);
+        for (int indc = 0; indc < cuentaTipos; ++ indc) {
+            if (cuenta [indc] > 0 && tipo -- == 0) {
+                tipo = indc;
+                break;
+            }
+        }
+        int elegida = azar.entero (cuenta [tipo]);
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            if (static_cast <int> (jugadas [indc].tipo) == tipo && elegida -- == 0) {
+                return indc;
+            }
+        }
+        assert (false);
+        return 0;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    int PoliticaGuion::elige (
+            const MotorReglas &          motor, 
+            const EstadoPartida &        estado, 
+            const std::vector <Jugada> & jugadas, 
+            GeneradorAzar &              /*azar*/ ) {
+        assert (! jugadas.empty ());
+        const ReglasPartida & reglas = motor.reglas ();
+        if (jugadas [0].tipo == TipoJugada::elige) {
+            int elegida = 0;
+            for (int indc = 1; indc < std::ssize (jugadas); ++ indc) {
+                if (estado.personajes [jugadas [indc]   .personaje].vitalidad > 
+                    estado.personajes [jugadas [elegida].personaje].vitalidad   ) {
+                    elegida = indc;
+                }
+            }
+            return elegida;
+        }
+        //
+        esperados.assign (reglas.habilidades ().size () * ReglasPartida::maximoPersonajes, std::nan (""));
+        int    elegida = -1;
+        double balance_elegida = 0.0;
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            const Jugada & jugada = jugadas [indc];
+            if (! motor.usaAleatorio (jugada)) {
+                continue;
+            }
+            // curar solo a quien lo necesita
+            if (jugada.tipo == TipoJugada::habilidadOponente && 
+                reglas.habilidad (jugada.habilidad).antagonista == Antagonista::aliado &&
+                estado.personajes [jugada.objetivo].vitalidad > ReglasPartida::maximaVitalidad / 2) {
+                continue;
+            }
+            double balance = balanceVitalidad (motor, estado, jugada);
+            if (balance > balance_elegida) {
+                elegida = indc;
+                balance_elegida = balance;
+            }
+        }
+        if (elegida != -1) {
+            return elegida;
+        }
+        //
+        const EstadoPersonaje & atacante = estado.personajes [estado.atacante];
+        int reserva = ReglasPartida::maximoPuntosAccion;
+        for (int habilidad : reglas.personaje (estado.atacante).habilidades) {
+            if (reglas.habilidad (habilidad).antagonista == Antagonista::oponente) {
+                reserva = std::min (reserva, reglas.habilidad (habilidad).coste);
+            }
+        }
+        if (reserva == ReglasPartida::maximoPuntosAccion) {
+            reserva = 0;
+        }
+        int distancia_elegida = distanciaOponente (motor, estado, atacante.celda);
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            const Jugada & jugada = jugadas [indc];
+            if (jugada.tipo != TipoJugada::desplaza || jugada.puntos > atacante.puntos_accion - reserva) {
+                continue;
+            }
+            int distancia = distanciaOponente (motor, estado, jugada.celda);
+            if (distancia < distancia_elegida || 
+                (distancia == distancia_elegida && elegida != -1 && jugada.puntos < jugadas [elegida].puntos)) {
+                elegida = indc;
+                distancia_elegida = distancia;
+            }
+        }
+        if (elegida != -1) {
+            return elegida;
+        }
+        //
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            if (jugadas [indc].tipo == TipoJugada::habilidadSimple && ! cambiosAplicados (motor, estado, jugadas [indc])) {
+                return indc;
+            }
+            if (jugadas [indc].tipo == TipoJugada::cede) {
+                return indc;
+            }
+        }
+        // sin nada útil que hacer, gasta puntos acercándose
+        distancia_elegida = std::numeric_limits <int>::max ();
+        elegida = 0;
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            if (jugadas [indc].tipo != TipoJugada::desplaza) {
+                continue;
+            }
+            int distancia = distanciaOponente (motor, estado, jugadas [indc].celda);
+            if (distancia < distancia_elegida) {
+                elegida = indc;
+                distancia_elegida = distancia;
+            }
+        }
+        return elegida;
+    }
+
+
+    double PoliticaGuion::balanceVitalidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada) {
+        const ReglasPartida & reglas = motor.reglas ();
+        LadoTablero lado = reglas.personaje (jugada.personaje).lado;
+        std::vector <int> afectados {};
+        if (jugada.tipo == TipoJugada::habilidadOponente) {
+            afectados.push_back (jugada.objetivo);
+        } else {
+            motor.personajesArea (estado, jugada.celda, reglas.habilidad (jugada.habilidad).radio_alcance, afectados);
+        }
+        double balance = 0.0;
+        for (int objetivo : afectados) {
+            double dano = esperado (motor, estado, jugada.habilidad, objetivo);
+            balance += reglas.personaje (objetivo).lado == lado ? - dano : dano;
+        }
+        return balance;
+    }
+
+
+    double PoliticaGuion::esperado (const MotorReglas & motor, const EstadoPartida & estado, int habilidad, int objetivo) {
+        double & valor = esperados [habilidad * ReglasPartida::maximoPersonajes + objetivo];
+        if (std::isnan (valor)) {
+            valor = motor.danoEsperado (estado, estado.atacante, habilidad, objetivo);
+        }
+        return valor;
+    }
+
+
+    int PoliticaGuion::distanciaOponente (const MotorReglas & motor, const EstadoPartida & estado, int celda) {
+        LadoTablero lado = motor.reglas ().personaje (estado.atacante).lado;
+        int minima = std::numeric_limits <int>::max ();
+        for (int indc = 0; indc < estado.cuenta_personajes; ++ indc) {
+            const EstadoPersonaje & persj = estado.personajes [indc];
+            if (persj.vitalidad > 0 && motor.reglas ().personaje (indc).lado != lado) {
+                minima = std::min (minima, TableroReglas::distancia (celda, persj.celda));
+            }
+        }
+        return minima;
+    }
+
+
+    bool PoliticaGuion::cambiosAplicados (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada) {
+        const ReglasPartida::Habilidad & habilidad = motor.reglas ().habilidad (jugada.habilidad);
+        const EstadoPersonaje & persj = estado.personajes [jugada.personaje];
+        for (const std::pair <int, int> & efecto : habilidad.efectos_ataque) {
+            if (persj.cambio_ataque [efecto.first] != efecto.second) {
+                return false;
+            }
+        }
+        for (const std::pair <int, int> & efecto : habilidad.efectos_defensa) {
+            if (persj.cambio_defensa [efecto.first] != efecto.second) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+}
@@ -0,0 +1,77 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  PoliticaJuego.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Quien decide las jugadas de un lado en una partida sin presentación (torneos, jugadores 
+    // automáticos). Una política puede guardar estado entre jugadas, así que cada hilo y cada 
+    // lado usa la suya.
+    class PoliticaJuego {
+    public:
+
+        virtual ~PoliticaJuego () = default;
+
+        // índice en 'jugadas', que son las de 'MotorReglas::generaJugadas' (nunca vacías); 'azar' 
+        // es de la política, no el de la partida
+        virtual int elige (
+                const MotorReglas &          motor, 
+                const EstadoPartida &        estado, 
+                const std::vector <Jugada> & jugadas, 
+                GeneradorAzar &              azar    ) = 0;
+
+    };
+
+
+    // Al azar, primero el tipo de jugada y después una de ese tipo: así los desplazamientos, que 
+    // son muchos más, no tapan a las habilidades.
+    class PoliticaAzar : public PoliticaJuego {
+    public:
+
+        int elige (
+                const MotorReglas &          motor, 
+                const EstadoPartida &        estado, 
+                const std::vector <Jugada> & jugadas, 
+                GeneradorAzar &              azar    ) override;
+
+    };
+
+
+    // Un guion fijo, como jugaría un principiante prudente:
+    //  *   elige al personaje con más vitalidad;
+    //  *   aplica la habilidad con más daño esperado a los oponentes (descontando el que hace a sus
+    //      aliados), o cura al aliado más herido si está por debajo de la mitad de su vitalidad;
+    //  *   si no, se acerca al oponente vivo más próximo guardando los puntos de su ataque más 
+    //      barato, o aplica una habilidad auto-aplicada que aún no tenga.
+    class PoliticaGuion : public PoliticaJuego {
+    public:
+
+        int elige (
+                const MotorReglas &          motor, 
+                const EstadoPartida &        estado, 
+                const std::vector <Jugada> & jugadas, 
+                GeneradorAzar &              azar    ) override;
+
+    private:
+
+        // 'MotorReglas::danoEsperado' por habilidad y objetivo, para el atacante de la jugada en curso; 
+        // NaN si aún no se ha calculado
+        std::vector <double> esperados {};
+
+
+        // lo que la jugada quita a los oponentes y devuelve a los aliados, menos lo que les quita
+        double balanceVitalidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada);
+        double esperado (const MotorReglas & motor, const EstadoPartida & estado, int habilidad, int objetivo);
+
+        static int distanciaOponente (const MotorReglas & motor, const EstadoPartida & estado, int celda);
+        static bool cambiosAplicados (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada);
+
+    };
+
+
+}
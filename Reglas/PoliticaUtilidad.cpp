@@ -0,0 +1,331 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   PoliticaUtilidad.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    PoliticaUtilidad::PoliticaUtilidad (const Pesos & pesos) :
+            pesos_ {pesos} {
+    }
+
+
+    int PoliticaUtilidad::elige (
+            const MotorReglas &          motor, 
+            const EstadoPartida &        estado, 
+            const std::vector <Jugada> & jugadas, 
+            GeneradorAzar &              /*azar*/ ) {
+        assert (! jugadas.empty ());
+        const ReglasPartida & reglas = motor.reglas ();
+        casillas_punto = reglas.puntosAccionDeDesplaza () / (2.0 * TableroReglas::seno60 * TableroReglas::ladoHexagono);
+        esperados.assign (ReglasPartida::maximoPersonajes * reglas.habilidades ().size () * ReglasPartida::maximoPersonajes, 
+                          std::nan (""));
+        actualizaMapas (motor, estado);
+        if (jugadas [0].tipo != TipoJugada::elige) {
+            preparaAtaques (motor, estado, estado.atacante);
+        }
+        //
+        int    elegida = 0;
+        double utilidad_elegida = - std::numeric_limits <double>::infinity ();
+        for (int indc = 0; indc < std::ssize (jugadas); ++ indc) {
+            double valor = utilidad (motor, estado, jugadas [indc]);
+            if (valor > utilidad_elegida) {
+                elegida = indc;
+                utilidad_elegida = valor;
+            }
+        }
+        return elegida;
+    }
+
+
+    int PoliticaUtilidad::influencia (LadoTablero lado, int celda) const {
+        if (mapas [0].empty ()) {
+            return 0;
+        }
+        return mapas [indiceLado (lado)] [celda];
+    }
+
+
+    void PoliticaUtilidad::actualizaMapas (const MotorReglas & motor, const EstadoPartida & estado) {
+        if (mapas [0].empty ()) {
+            for (std::vector <int> & mapa : mapas) {
+                mapa.assign (TableroReglas::cuentaCeldas, 0);
+            }
+        }
+        // la política sirve para partidas sucesivas, con otras reglas: el sello guarda lo que 
+        // hace falta para quitarlo
+        const ReglasPartida & reglas = motor.reglas ();
+        int desplaza = casillasDesplaza (ReglasPartida::maximoPuntosAccion);
+        for (int indc = 0; indc < ReglasPartida::maximoPersonajes; ++ indc) {
+            Sello sello {};
+            if (indc < estado.cuenta_personajes && estado.personajes [indc].vitalidad > 0) {
+                sello.celda     = estado.personajes [indc].celda;
+                // más allá, el sello ya cubre todo el tablero
+                sello.radio     = static_cast <int16_t> (std::min (desplaza + alcanceHabilidades (reglas, indc), 
+                                                                   TableroReglas::filas));
+                sello.vitalidad = estado.personajes [indc].vitalidad;
+                sello.lado      = static_cast <int8_t> (indiceLado (reglas.personaje (indc).lado));
+            }
+            if (sello != sellos [indc]) {
+                sella (sellos [indc], -1);
+                sella (sello, 1);
+                sellos [indc] = sello;
+            }
+        }
+    }
+
+
+    void PoliticaUtilidad::sella (const Sello & sello, int signo) {
+        if (sello.celda == TableroReglas::nula) {
+            return;
+        }
+        // la división entera redondea igual al poner y al quitar
+        int radio = sello.radio;
+        std::array <int, TableroReglas::filas + 1> valores {};
+        for (int distancia = 0; distancia <= radio; ++ distancia) {
+            valores [distancia] = signo * sello.vitalidad * (radio + 1 - distancia) / (radio + 1);
+        }
+        // las celdas a distancia hasta 'radio' en coordenadas axiales (véase: 
+        // 'TableroReglas::distancia'), por columnas: en una columna, cada 'dr' son dos filas más y 
+        // 'columnas' celdas más
+        int * mapa = mapas [sello.lado].data ();
+        int fila = TableroReglas::fila (sello.celda);
+        int coln = TableroReglas::coln (sello.celda);
+        for (int dq = std::max (- radio, 1 - coln); dq <= std::min (radio, TableroReglas::columnas - coln); ++ dq) {
+            int desde = std::max (- radio, - dq - radio);
+            int hasta = std::min (radio, - dq + radio);
+            while (fila + dq + 2 * desde < 1) {
+                desde ++;
+            }
+            while (fila + dq + 2 * hasta > TableroReglas::filas) {
+                hasta --;
+            }
+            int celda = TableroReglas::celda (fila + dq + 2 * desde, coln + dq);
+            for (int dr = desde; dr <= hasta; ++ dr, celda += TableroReglas::columnas) {
+                mapa [celda] += valores [(std::abs (dq) + std::abs (dr) + std::abs (dq + dr)) / 2];
+            }
+        }
+    }
+
+
+    double PoliticaUtilidad::utilidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada) {
+        double valor = - pesos_.puntos * jugada.puntos;
+        switch (jugada.tipo) {
+        case TipoJugada::elige:
+            return utilidadElige (motor, estado, jugada.personaje);
+        case TipoJugada::desplaza:
+            return valor + utilidadDesplaza (motor, estado, jugada);
+        case TipoJugada::habilidadSimple:
+        case TipoJugada::habilidadOponente:
+        case TipoJugada::habilidadArea:
+            return valor + utilidadHabilidad (motor, estado, jugada);
+        case TipoJugada::cede:
+            return 0.0;
+        }
+        return valor;
+    }
+
+
+    double PoliticaUtilidad::utilidadElige (const MotorReglas & motor, const EstadoPartida & estado, int personaje) {
+        const EstadoPersonaje & persj = estado.personajes [personaje];
+        int otro = 1 - indiceLado (motor.reglas ().personaje (personaje).lado);
+        // el riesgo pesa más cuanta menos vitalidad le queda
+        double peligro = static_cast <double> (mapas [otro] [persj.celda]) / ReglasPartida::maximaVitalidad;
+        double herida  = 1.0 - static_cast <double> (persj.vitalidad) / ReglasPartida::maximaVitalidad;
+        preparaAtaques (motor, estado, personaje);
+        return oportunidad (persj.celda, persj.puntos_accion) - pesos_.peligro * peligro * herida;
+    }
+
+
+    double PoliticaUtilidad::utilidadHabilidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada) {
+        const ReglasPartida & reglas = motor.reglas ();
+        const ReglasPartida::Habilidad & habilidad = reglas.habilidad (jugada.habilidad);
+        if (jugada.tipo == TipoJugada::habilidadSimple) {
+            const EstadoPersonaje & persj = estado.personajes [jugada.personaje];
+            for (const std::pair <int, int> & efecto : habilidad.efectos_ataque) {
+                if (persj.cambio_ataque [efecto.first] != efecto.second) {
+                    return pesos_.refuerzo;
+                }
+            }
+            for (const std::pair <int, int> & efecto : habilidad.efectos_defensa) {
+                if (persj.cambio_defensa [efecto.first] != efecto.second) {
+                    return pesos_.refuerzo;
+                }
+            }
+            return - pesos_.refuerzo;
+        }
+        //
+        LadoTablero lado = reglas.personaje (jugada.personaje).lado;
+        afectados.clear ();
+        if (jugada.tipo == TipoJugada::habilidadOponente) {
+            afectados.push_back (jugada.objetivo);
+        } else {
+            motor.personajesArea (estado, jugada.celda, habilidad.radio_alcance, afectados);
+        }
+        double valor = 0.0;
+        for (int objetivo : afectados) {
+            double dano = esperado (motor, estado, jugada.personaje, jugada.habilidad, objetivo);
+            if (reglas.personaje (objetivo).lado != lado) {
+                valor += dano + premio (estado, objetivo, dano);
+            } else if (dano < 0.0) {
+                // la curación vale más cuanto más le falta
+                double falta = 1.0 - static_cast <double> (estado.personajes [objetivo].vitalidad) / ReglasPartida::maximaVitalidad;
+                valor -= 2.0 * falta * dano;
+            } else {
+                valor -= dano + premio (estado, objetivo, dano);
+            }
+        }
+        return valor;
+    }
+
+
+    double PoliticaUtilidad::utilidadDesplaza (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada) {
+        const ReglasPartida & reglas = motor.reglas ();
+        const EstadoPersonaje & atacante = estado.personajes [jugada.personaje];
+        int propio = indiceLado (reglas.personaje (jugada.personaje).lado);
+        int otro   = 1 - propio;
+        int puntos = atacante.puntos_accion - jugada.puntos;
+        double valor = pesos_.oportunidad * oportunidad (jugada.celda, puntos);
+        // el apoyo no cuenta el del propio atacante
+        const Sello & sello = sellos [jugada.personaje];
+        int distancia_sello = TableroReglas::distancia (sello.celda, jugada.celda);
+        int apoyo = mapas [propio] [jugada.celda];
+        if (distancia_sello <= sello.radio) {
+            apoyo -= sello.vitalidad * (sello.radio + 1 - distancia_sello) / (sello.radio + 1);
+        }
+        valor -= pesos_.peligro * mapas [otro] [jugada.celda] / ReglasPartida::maximaVitalidad;
+        valor += pesos_.apoyo * apoyo / ReglasPartida::maximaVitalidad;
+        valor += pesos_.cobertura * murosVecinos (reglas, jugada.celda);
+        //
+        int q, r;
+        axiales (jugada.celda, q, r);
+        int minima = TableroReglas::cuentaCeldas;
+        for (const std::pair <int, int> & oponente : oponentes) {
+            minima = std::min (minima, distanciaAxial (q, r, oponente.first, oponente.second));
+        }
+        return valor - pesos_.acercamiento * minima;
+    }
+
+
+    void PoliticaUtilidad::preparaAtaques (const MotorReglas & motor, const EstadoPartida & estado, int personaje) {
+        const ReglasPartida & reglas = motor.reglas ();
+        LadoTablero lado = reglas.personaje (personaje).lado;
+        ataques.clear ();
+        oponentes.clear ();
+        for (int objetivo = 0; objetivo < estado.cuenta_personajes; ++ objetivo) {
+            const EstadoPersonaje & persj = estado.personajes [objetivo];
+            if (persj.vitalidad <= 0 || reglas.personaje (objetivo).lado == lado) {
+                continue;
+            }
+            int q, r;
+            axiales (persj.celda, q, r);
+            oponentes.emplace_back (q, r);
+            for (int habilidad : reglas.personaje (personaje).habilidades) {
+                const ReglasPartida::Habilidad & habld = reglas.habilidad (habilidad);
+                if (habld.antagonista != Antagonista::oponente) {
+                    continue;
+                }
+                Ataque ataque {};
+                ataque.coste   = habld.coste;
+                ataque.alcance = habld.alcance + (habld.enfoque == EnfoqueHabilidad::area ? habld.radio_alcance : 0);
+                ataque.q       = q;
+                ataque.r       = r;
+                double dano    = esperado (motor, estado, personaje, habilidad, objetivo);
+                ataque.valor   = dano + premio (estado, objetivo, dano) - pesos_.puntos * habld.coste;
+                if (ataque.valor > 0.0) {
+                    ataques.push_back (ataque);
+                }
+            }
+        }
+        std::sort (ataques.begin (), ataques.end (), [] (const Ataque & ataque_1, const Ataque & ataque_2) {
+            return ataque_1.valor > ataque_2.valor;
+        });
+    }
+
+
+    double PoliticaUtilidad::oportunidad (int celda, int puntos) const {
+        int q, r;
+        axiales (celda, q, r);
+        for (const Ataque & ataque : ataques) {
+            // desplazándose con los puntos que no cuesta la habilidad; sin mirar muros ni fichas en 
+            // medio: es una estimación
+            if (ataque.coste <= puntos && 
+                distanciaAxial (q, r, ataque.q, ataque.r) <= ataque.alcance + casillasDesplaza (puntos - ataque.coste)) {
+                return ataque.valor;
+            }
+        }
+        return 0.0;
+    }
+
+
+    double PoliticaUtilidad::esperado (
+            const MotorReglas &   motor, 
+            const EstadoPartida & estado, 
+            int atacante, int habilidad, int objetivo ) {
+        const ReglasPartida & reglas = motor.reglas ();
+        double & valor = esperados [(atacante * reglas.habilidades ().size () + habilidad) * ReglasPartida::maximoPersonajes + objetivo];
+        if (! std::isnan (valor)) {
+            return valor;
+        }
+        valor = motor.danoEsperado (estado, atacante, habilidad, objetivo);
+        return valor;
+    }
+
+
+    double PoliticaUtilidad::premio (const EstadoPartida & estado, int objetivo, double dano) const {
+        return dano >= estado.personajes [objetivo].vitalidad ? pesos_.remate : 0.0;
+    }
+
+
+    int PoliticaUtilidad::casillasDesplaza (int puntos) const {
+        return static_cast <int> (puntos * casillas_punto);
+    }
+
+
+    void PoliticaUtilidad::axiales (int celda, int & q, int & r) {
+        q = TableroReglas::coln (celda);
+        r = (TableroReglas::fila (celda) - q) / 2;
+    }
+
+
+    int PoliticaUtilidad::distanciaAxial (int q_1, int r_1, int q_2, int r_2) {
+        int dq = q_2 - q_1;
+        int dr = r_2 - r_1;
+        return (std::abs (dq) + std::abs (dr) + std::abs (dq + dr)) / 2;
+    }
+
+
+    int PoliticaUtilidad::alcanceHabilidades (const ReglasPartida & reglas, int personaje) {
+        int alcance = 0;
+        for (int habilidad : reglas.personaje (personaje).habilidades) {
+            const ReglasPartida::Habilidad & habld = reglas.habilidad (habilidad);
+            if (habld.antagonista == Antagonista::oponente) {
+                alcance = std::max (alcance, habld.alcance + (habld.enfoque == EnfoqueHabilidad::area ? habld.radio_alcance : 0));
+            }
+        }
+        return alcance;
+    }
+
+
+    int PoliticaUtilidad::murosVecinos (const ReglasPartida & reglas, int celda) {
+        // las seis vecinas en coordenadas dobladas
+        static constexpr std::array <std::pair <int, int>, 6> vecinas {{ 
+                {-2, 0}, {2, 0}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1} }};
+        int fila = TableroReglas::fila (celda);
+        int coln = TableroReglas::coln (celda);
+        int muros = 0;
+        for (const std::pair <int, int> & vecina : vecinas) {
+            int celda_vecina = TableroReglas::celda (fila + vecina.first, coln + vecina.second);
+            if (celda_vecina != TableroReglas::nula && reglas.muros ().test (celda_vecina)) {
+                muros ++;
+            }
+        }
+        return muros;
+    }
+
+
+}
@@ -0,0 +1,128 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  PoliticaUtilidad.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Una utilidad por jugada y la mayor gana, sin búsqueda: para partidas con muchos personajes 
+    // (en el modo por equipos, cada factor que elige 'tapete::ModoJuegoEquipo::buscaJugada' decide 
+    // por su cuenta) y para las simulaciones de las búsquedas.
+    // Cada lado tiene un mapa de influencia: en cada celda, la vitalidad de sus personajes vivos, 
+    // que decae con la distancia hasta anularse más allá de lo que alcanzan en un turno 
+    // (desplazamiento con todos los puntos y alcance de sus habilidades). Los mapas se guardan 
+    // entre jugadas y solo se retocan los personajes que han cambiado de celda o de vitalidad, así 
+    // que decidir cuesta unos microsegundos.
+    //  *   Las habilidades valen el daño esperado a los oponentes menos el de los aliados (las 
+    //      curaciones, lo devuelto según lo que le falta al aliado), con un premio si el daño 
+    //      esperado acaba con el objetivo.
+    //  *   Los desplazamientos valen lo que el atacante podría hacer desde la llegada con los puntos 
+    //      que le quedan, menos la influencia oponente que soporta allí, más la de su lado y los 
+    //      muros vecinos que le cubren; y se acercan al oponente más próximo.
+    //  *   Se elige al personaje que más daño puede hacer en el turno con menos riesgo.
+    // Todas las jugadas descuentan los puntos de acción que gastan.
+    class PoliticaUtilidad : public PoliticaJuego {
+    public:
+
+        struct Pesos {
+            // por personaje oponente entero (con toda su vitalidad) que alcanza la celda
+            double peligro {8.0};
+            double apoyo {2.0};
+            // por muro vecino
+            double cobertura {1.0};
+            // si el daño esperado acaba con el objetivo
+            double remate {20.0};
+            // por casilla hasta el oponente más próximo
+            double acercamiento {1.0};
+            // lo que se espera hacer desde la llegada de un desplazamiento, frente a hacerlo ya
+            double oportunidad {0.8};
+            // habilidad auto-aplicada que aún no tiene el atacante
+            double refuerzo {4.0};
+            // por punto de acción gastado
+            double puntos {0.05};
+        };
+
+
+        PoliticaUtilidad () = default;
+        explicit PoliticaUtilidad (const Pesos & pesos);
+
+        int elige (
+                const MotorReglas &          motor, 
+                const EstadoPartida &        estado, 
+                const std::vector <Jugada> & jugadas, 
+                GeneradorAzar &              azar    ) override;
+
+        // influencia de un lado en la celda, en puntos de vitalidad, según el último 'elige'
+        int influencia (LadoTablero lado, int celda) const;
+
+    private:
+
+        // la aportación de un personaje a un mapa
+        struct Sello {
+            int16_t celda {TableroReglas::nula};
+            int16_t radio {};
+            int16_t vitalidad {};
+            int8_t  lado {};
+
+            bool operator == (const Sello &) const = default;
+        };
+
+        // una habilidad ofensiva de un personaje sobre un oponente, en coordenadas axiales
+        struct Ataque {
+            int    coste {};
+            int    alcance {};
+            int    q {};
+            int    r {};
+            double valor {};
+        };
+
+        Pesos pesos_ {};
+
+        std::array <std::vector <int>, 2>                   mapas {};
+        std::array <Sello, ReglasPartida::maximoPersonajes> sellos {};
+
+        // daño esperado por habilidad y objetivo, para el atacante de la jugada en curso; NaN si 
+        // aún no se ha calculado
+        std::vector <double> esperados {};
+        // casillas que se recorren con un punto de acción, en las reglas de la jugada en curso
+        double               casillas_punto {};
+        std::vector <int>    afectados {};
+        // los del personaje que se está valorando, de más a menos valor
+        std::vector <Ataque> ataques {};
+        // oponentes vivos del atacante, en coordenadas axiales
+        std::vector <std::pair <int, int>> oponentes {};
+
+
+        void actualizaMapas (const MotorReglas & motor, const EstadoPartida & estado);
+        void sella (const Sello & sello, int signo);
+
+        double utilidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada);
+        double utilidadElige (const MotorReglas & motor, const EstadoPartida & estado, int personaje);
+        double utilidadHabilidad (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada);
+        double utilidadDesplaza (const MotorReglas & motor, const EstadoPartida & estado, const Jugada & jugada);
+
+        void preparaAtaques (const MotorReglas & motor, const EstadoPartida & estado, int personaje);
+        // el mejor de 'ataques' con los puntos dados, desde la celda o desde donde llegue con ellos
+        double oportunidad (int celda, int puntos) const;
+        double esperado (
+                const MotorReglas &   motor, 
+                const EstadoPartida & estado, 
+                int atacante, int habilidad, int objetivo );
+        double premio (const EstadoPartida & estado, int objetivo, double dano) const;
+
+        // casillas que recorre el personaje con los puntos dados
+        int casillasDesplaza (int puntos) const;
+        // véase: 'TableroReglas::distancia'
+        static void axiales (int celda, int & q, int & r);
+        static int distanciaAxial (int q_1, int r_1, int q_2, int r_2);
+        static int alcanceHabilidades (const ReglasPartida & reglas, int personaje);
+        static int murosVecinos (const ReglasPartida & reglas, int celda);
+
+    };
+
+
+}
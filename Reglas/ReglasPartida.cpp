@@ -0,0 +1,254 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   ReglasPartida.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    int ReglasPartida::agregaHabilidad (const Habilidad & habilidad) {
+        habilidades_.push_back (habilidad);
+        compilada_ = false;
+        return static_cast <int> (habilidades_.size ()) - 1;
+    }
+
+
+    int ReglasPartida::agregaPersonaje (const Personaje & personaje) {
+        if (personajes_.size () == maximoPersonajes) {
+            throw std::logic_error {"Reglas de partida mal configuradas: demasiados personajes"};
+        }
+        if (personaje.habilidades.size () > maximoHabilidades) {
+            throw std::logic_error {"Reglas de partida mal configuradas: demasiadas habilidades en un personaje"};
+        }
+        personajes_.push_back (personaje);
+        compilada_ = false;
+        return static_cast <int> (personajes_.size ()) - 1;
+    }
+
+
+    void ReglasPartida::agregaEfectividad (int valor_superior_ataque, int porcentaje_dano) {
+        efectividades.push_back ({ valor_superior_ataque, porcentaje_dano });
+        compilada_ = false;
+    }
+
+
+    void ReglasPartida::agregaMuro (int celda) {
+        assert (0 <= celda && celda < TableroReglas::cuentaCeldas);
+        muros_.set (celda);
+        destinos_.reset ();
+    }
+
+
+    void ReglasPartida::ponPuntosAccionDeDesplaza (float valor) {
+        puntos_accion_de_desplaza = valor;
+        destinos_.reset ();
+    }
+
+
+    void ReglasPartida::compila () {
+        for (const Personaje & personaje : personajes_) {
+            for (int indice : personaje.habilidades) {
+                if (indice < 0 || indice >= std::ssize (habilidades_)) {
+                    throw std::logic_error {"Reglas de partida mal configuradas: habilidad inexistente en un personaje"};
+                }
+            }
+        }
+        if (puntos_accion_de_desplaza <= 0.0f) {
+            throw std::logic_error {"Reglas de partida mal configuradas: coste de desplazamiento no establecido"};
+        }
+        // el mismo criterio que 'SistemaAtaque::compilaEfectividades': el primer grado que acota
+        for (int valor = minimoFinalAtaque; valor <= maximoFinalAtaque; ++ valor) {
+            int porcentaje = 0;
+            for (const std::pair <int, int> & grado : efectividades) {
+                if (valor <= grado.first) {
+                    porcentaje = grado.second;
+                    break;
+                }
+            }
+            porcentaje_final_ataque [valor - minimoFinalAtaque] = static_cast <short> (porcentaje);
+        }
+        tramos_ventaja.assign (cuentaVentajas, {});
+        for (int indc = 0; indc < cuentaVentajas; ++ indc) {
+            std::vector <TramoVentaja> & tramos = tramos_ventaja [indc];
+            for (int aleatorio_100 = 0; aleatorio_100 < 100; ++ aleatorio_100) {
+                short porcentaje = porcentaje_final_ataque [indc + aleatorio_100];
+                if (! tramos.empty () && tramos.back ().porcentaje == porcentaje) {
+                    tramos.back ().casos ++;
+                } else {
+                    tramos.push_back ({ porcentaje, 1 });
+                }
+            }
+        }
+        compilada_ = true;
+    }
+
+
+    bool ReglasPartida::compilada () const {
+        return compilada_;
+    }
+
+
+    void ReglasPartida::preparaDestinos () {
+        if (! compilada_) {
+            throw std::logic_error {"Reglas de partida sin compilar"};
+        }
+        // los mismos criterios que 'MotorReglas::generaDesplazamientos' con los muros como únicas 
+        // celdas ocupadas
+        float limite = (maximoPuntosAccion + 0.5f) * puntos_accion_de_desplaza;
+        auto destinos = std::make_shared <std::vector <std::vector <Destino>>> (TableroReglas::cuentaCeldas);
+        for (int origen = 0; origen < TableroReglas::cuentaCeldas; ++ origen) {
+            for (int celda = 0; celda < TableroReglas::cuentaCeldas; ++ celda) {
+                if (celda == origen || muros_.test (celda)) {
+                    continue;
+                }
+                float longitud = TableroReglas::longitud (origen, celda);
+                if (longitud >= limite) {
+                    continue;
+                }
+                int punts = static_cast <int> (std::round (longitud / puntos_accion_de_desplaza));
+                if (punts == 0 || punts > maximoPuntosAccion) {
+                    continue;
+                }
+                if (! TableroReglas::segmentoLibre (muros_, origen, celda)) {
+                    continue;
+                }
+                Destino destino {};
+                destino.celda    = static_cast <int16_t> (celda);
+                destino.puntos   = static_cast <int16_t> (punts);
+                destino.longitud = longitud;
+                (* destinos) [origen].push_back (destino);
+            }
+        }
+        destinos_ = destinos;
+    }
+
+
+    bool ReglasPartida::destinosPreparados () const {
+        return destinos_ != nullptr;
+    }
+
+
+    const std::vector <ReglasPartida::Destino> & ReglasPartida::destinos (int celda_origen) const {
+        assert (destinos_ != nullptr);
+        assert (0 <= celda_origen && celda_origen < TableroReglas::cuentaCeldas);
+        return (* destinos_) [celda_origen];
+    }
+
+
+    ReglasPartida ReglasPartida::alinea (const std::vector <int> & izquierda, const std::vector <int> & derecha) const {
+        ReglasPartida alineadas {* this};
+        alineadas.personajes_.clear ();
+        for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+            for (int indice : lado == LadoTablero::Izquierda ? izquierda : derecha) {
+                Personaje personaje = this->personaje (indice);
+                personaje.lado = lado;
+                alineadas.agregaPersonaje (personaje);
+            }
+        }
+        alineadas.compila ();
+        return alineadas;
+    }
+
+
+    const std::vector <ReglasPartida::Habilidad> & ReglasPartida::habilidades () const {
+        return habilidades_;
+    }
+
+
+    const ReglasPartida::Habilidad & ReglasPartida::habilidad (int indice) const {
+        assert (0 <= indice && indice < std::ssize (habilidades_));
+        return habilidades_ [indice];
+    }
+
+
+    const std::vector <ReglasPartida::Personaje> & ReglasPartida::personajes () const {
+        return personajes_;
+    }
+
+
+    const ReglasPartida::Personaje & ReglasPartida::personaje (int indice) const {
+        assert (0 <= indice && indice < std::ssize (personajes_));
+        return personajes_ [indice];
+    }
+
+
+    int ReglasPartida::cuentaPersonajes () const {
+        return static_cast <int> (personajes_.size ());
+    }
+
+
+    const TableroReglas::Celdas & ReglasPartida::muros () const {
+        return muros_;
+    }
+
+
+    float ReglasPartida::puntosAccionDeDesplaza () const {
+        return puntos_accion_de_desplaza;
+    }
+
+
+    int ReglasPartida::porcentajeDano (int valor_final_ataque) const {
+        assert (compilada_);
+        assert (minimoFinalAtaque <= valor_final_ataque && valor_final_ataque <= maximoFinalAtaque);
+        return porcentaje_final_ataque [valor_final_ataque - minimoFinalAtaque];
+    }
+
+
+    const std::vector <ReglasPartida::TramoVentaja> & ReglasPartida::tramosVentaja (int ventaja) const {
+        assert (compilada_);
+        assert (minimoFinalAtaque <= ventaja && ventaja < minimoFinalAtaque + cuentaVentajas);
+        return tramos_ventaja [ventaja - minimoFinalAtaque];
+    }
+
+
+    uint64_t ReglasPartida::huella () const {
+        Huella resumen {};
+        resumen.agrega (habilidades_.size ());
+        for (const Habilidad & habilidad : habilidades_) {
+            resumen.agrega (habilidad.enfoque);
+            resumen.agrega (habilidad.acceso);
+            resumen.agrega (habilidad.antagonista);
+            resumen.agrega (habilidad.coste);
+            resumen.agrega (habilidad.alcance);
+            resumen.agrega (habilidad.radio_alcance);
+            resumen.agrega (habilidad.tipo_ataque);
+            resumen.agrega (habilidad.tipo_defensa);
+            resumen.agrega (habilidad.tipo_dano);
+            resumen.agrega (habilidad.valor_dano);
+            resumen.agrega (habilidad.valor_curacion);
+            resumen.agrega (habilidad.efectos_ataque.size ());
+            resumen.agrega (habilidad.efectos_ataque.data (), 
+                            habilidad.efectos_ataque.size () * sizeof (std::pair <int, int>));
+            resumen.agrega (habilidad.efectos_defensa.size ());
+            resumen.agrega (habilidad.efectos_defensa.data (), 
+                            habilidad.efectos_defensa.size () * sizeof (std::pair <int, int>));
+        }
+        resumen.agrega (personajes_.size ());
+        for (const Personaje & personaje : personajes_) {
+            resumen.agrega (personaje.lado);
+            resumen.agrega (personaje.iniciativa);
+            resumen.agrega (personaje.ataque);
+            resumen.agrega (personaje.defensa);
+            resumen.agrega (personaje.reduce_dano);
+            resumen.agrega (personaje.aparece_ataque.to_ullong ());
+            resumen.agrega (personaje.aparece_defensa.to_ullong ());
+            resumen.agrega (personaje.aparece_reduce_dano.to_ullong ());
+            resumen.agrega (personaje.habilidades.size ());
+            resumen.agrega (personaje.habilidades.data (), personaje.habilidades.size () * sizeof (int));
+        }
+        resumen.agrega (efectividades.size ());
+        resumen.agrega (efectividades.data (), efectividades.size () * sizeof (std::pair <int, int>));
+        for (int celda = 0; celda < TableroReglas::cuentaCeldas; ++ celda) {
+            if (muros_.test (celda)) {
+                resumen.agrega (celda);
+            }
+        }
+        resumen.agrega (puntos_accion_de_desplaza);
+        return resumen.valor ();
+    }
+
+
+}
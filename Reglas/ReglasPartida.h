@@ -0,0 +1,143 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  ReglasPartida.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // La configuración de una partida que no cambia mientras se juega: personajes, habilidades, 
+    // estadísticas, grados de efectividad, muros y coste del desplazamiento. Los objetos se 
+    // identifican por su índice (el mismo que en 'tapete::JuegoMesaBase'); los tipos de ataque, 
+    // defensa y daño, por el índice de su 'TipoEstadistica'.
+    // Se llena una vez, se compila y desde entonces solo se consulta.
+    class ReglasPartida {
+    public:
+
+        static constexpr int maximaVitalidad       = 150;
+        static constexpr int maximoPuntosAccion    = 20;
+        static constexpr int maximoPersonajes      = 12;
+        static constexpr int maximoHabilidades     = 10;
+        static constexpr int maximoTiposEstadistica = 16;
+
+        // extremos de 'ventaja + aleatorio_100' con valores de ataque y defensa entre 1 y 
+        // 'maximaVitalidad' (véase: 'ValidacionJuego::EstadisticasPersonajes')
+        static constexpr int minimoFinalAtaque = 1 - maximaVitalidad;
+        static constexpr int maximoFinalAtaque = maximaVitalidad - 1 + 99;
+
+        static constexpr int sinTipo = -1;
+
+        struct Habilidad {
+            EnfoqueHabilidad enfoque {};
+            AccesoHabilidad  acceso {};
+            Antagonista      antagonista {};
+            int              coste {};
+            int              alcance {};
+            int              radio_alcance {};
+            int              tipo_ataque  {sinTipo};
+            int              tipo_defensa {sinTipo};
+            int              tipo_dano    {sinTipo};
+            int              valor_dano {};
+            int              valor_curacion {};
+            // (tipo, valor de cambio)
+            std::vector <std::pair <int, int>> efectos_ataque {};
+            std::vector <std::pair <int, int>> efectos_defensa {};
+        };
+
+        using TablaTipos = std::array <int, maximoTiposEstadistica>;
+
+        struct Personaje {
+            LadoTablero lado {LadoTablero::nulo};
+            int         iniciativa {};
+            TablaTipos  ataque {};
+            TablaTipos  defensa {};
+            TablaTipos  reduce_dano {};
+            std::bitset <maximoTiposEstadistica> aparece_ataque {};
+            std::bitset <maximoTiposEstadistica> aparece_defensa {};
+            std::bitset <maximoTiposEstadistica> aparece_reduce_dano {};
+            // índices en 'habilidades ()'
+            std::vector <int> habilidades {};
+        };
+
+        // valores consecutivos de 'aleatorio_100' con el mismo porcentaje de daño (véase: 
+        // 'tramosVentaja')
+        struct TramoVentaja {
+            int16_t porcentaje {};
+            int16_t casos {};
+        };
+
+        // destino de un desplazamiento en línea recta (véase: 'MotorReglas::generaDesplazamientos')
+        struct Destino {
+            int16_t celda {};
+            int16_t puntos {};
+            float   longitud {};
+        };
+
+
+        int agregaHabilidad (const Habilidad & habilidad);
+        int agregaPersonaje (const Personaje & personaje);
+        // en orden creciente de 'valor_superior', como 'SistemaAtaque::agregaEfectividad'
+        void agregaEfectividad (int valor_superior_ataque, int porcentaje_dano);
+        void agregaMuro (int celda);
+        void ponPuntosAccionDeDesplaza (float valor);
+
+        void compila ();
+        bool compilada () const;
+
+        // Desde cada celda, los destinos que no son muros y a los que se llega con hasta 
+        // 'maximoPuntosAccion' sin atravesar muros ni salir del tablero, en orden de celda. Cuesta 
+        // unas décimas de segundo, así que solo se preparan para jugar muchas partidas en el mismo 
+        // mapa; las copias (y 'alinea') los comparten.
+        void preparaDestinos ();
+        bool destinosPreparados () const;
+        const std::vector <Destino> & destinos (int celda_origen) const;
+
+        // Las mismas reglas con otros equipos: copias de los personajes 'izquierda' y 'derecha' 
+        // (índices en estas reglas, que pueden repetirse entre los dos lados), en ese orden y con 
+        // el lado cambiado; ya compiladas.
+        ReglasPartida alinea (const std::vector <int> & izquierda, const std::vector <int> & derecha) const;
+
+        const std::vector <Habilidad> & habilidades () const;
+        const Habilidad & habilidad (int indice) const;
+        const std::vector <Personaje> & personajes () const;
+        const Personaje & personaje (int indice) const;
+        int cuentaPersonajes () const;
+
+        const TableroReglas::Celdas & muros () const;
+        float puntosAccionDeDesplaza () const;
+
+        // porcentaje de daño para 'ventaja + aleatorio_100'; cero si ningún grado lo acota
+        int porcentajeDano (int valor_final_ataque) const;
+        // Los cien valores de 'aleatorio_100' de un ataque con 'ventaja' (ataque menos defensa), 
+        // en tramos con el mismo porcentaje de daño, de menor a mayor valor; se preparan al 
+        // compilar (véase: 'MotorReglas::distribucionDano').
+        const std::vector <TramoVentaja> & tramosVentaja (int ventaja) const;
+
+        // resumen de toda la configuración; dos partidas con la misma huella tienen las mismas reglas
+        uint64_t huella () const;
+
+    private:
+
+        static constexpr int cuentaFinalAtaque = maximoFinalAtaque - minimoFinalAtaque + 1;
+        // las ventajas van de 'minimoFinalAtaque' a 'maximoFinalAtaque - 99'
+        static constexpr int cuentaVentajas = cuentaFinalAtaque - 99;
+
+        std::vector <Habilidad> habilidades_ {};
+        std::vector <Personaje> personajes_ {};
+        std::vector <std::pair <int, int>> efectividades {};
+        TableroReglas::Celdas muros_ {};
+        float puntos_accion_de_desplaza {};
+
+        bool compilada_ {};
+        std::array <short, cuentaFinalAtaque> porcentaje_final_ataque {};
+        std::vector <std::vector <TramoVentaja>> tramos_ventaja {};
+
+        std::shared_ptr <const std::vector <std::vector <Destino>>> destinos_ {};
+
+    };
+
+
+}
@@ -0,0 +1,241 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   TableroReglas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    void TableroReglas::centro (int fila, int coln, float & x, float & y) {
+        // véase: 'RejillaTablero::centroHexagono'
+        x =   1.5f * coln - 0.5f;
+        y = seno60 * fila;
+        x *= ladoHexagono;
+        y *= ladoHexagono;
+    }
+
+
+    float TableroReglas::longitud (int celda_1, int celda_2) {
+        float x_1, y_1, x_2, y_2;
+        centro (fila (celda_1), coln (celda_1), x_1, y_1);
+        centro (fila (celda_2), coln (celda_2), x_2, y_2);
+        float dx = x_1 - x_2;
+        float dy = y_1 - y_2;
+        return std::sqrt (dx * dx + dy * dy);
+    }
+
+
+    float TableroReglas::desviacion (int celda_origen, int celda_destino, int celda) {
+        Recta recta_segmento = recta (
+                fila (celda_origen),  coln (celda_origen), 
+                fila (celda_destino), coln (celda_destino) );
+        return distanciaRecta (recta_segmento, fila (celda), coln (celda));
+    }
+
+
+    TableroReglas::Recta TableroReglas::recta (
+            int fila_origen, int coln_origen, int fila_destino, int coln_destino) {
+        float x_origen, y_origen, x_destino, y_destino;
+        centro (fila_origen,  coln_origen,  x_origen,  y_origen);
+        centro (fila_destino, coln_destino, x_destino, y_destino);
+        // a = vy   b = -vx   c = -a·px-b·py
+        Recta resultado;
+        resultado.a =   y_destino - y_origen;
+        resultado.b = - (x_destino - x_origen);
+        resultado.c = - resultado.a * x_origen - resultado.b * y_origen;
+        resultado.d = std::sqrt (resultado.a * resultado.a + resultado.b * resultado.b);
+        return resultado;
+    }
+
+
+    float TableroReglas::distanciaRecta (const Recta & recta, int fila, int coln) {
+        float x, y;
+        centro (fila, coln, x, y);
+        // distancia = |a·px+b·py+c|/√(a²+b²) 
+        return std::fabs (recta.a * x + recta.b * y + recta.c) / recta.d;
+    }
+
+
+    bool TableroReglas::enTablero (int fila, int coln) {
+        // véase: 'CalculoCaminos::celdaEnTablero'
+        if (fila % 2 == 0) {
+            if (fila < 2 || fila > filas - 1) {
+                return false;
+            }
+        } else {
+            if (fila < 1 || fila > filas) {
+                return false;
+            }
+        }
+        return 0 < coln && coln <= columnas;
+    }
+
+
+/****************************************************************************
+
+    Cálculo de la posición de cada celda destino en relación con la celda origen.
+
+      +-----+         +-----+         +-----+         +-----+         +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   6 C   +-----+   1 E   +-----+   1 C   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   6 C   +-----+   6 C   +-----+   1 C   +-----+   1 C   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   6 C   +-----+   1 E   +-----+   1 C   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   6 E   +-----+   6 C   +-----+   1 C   +-----+   2 E   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   6 E   +-----+   1 E   +-----+   2 E   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   5 C   +-----+   6 E   +-----+   2 E   +-----+   2 C   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   5 C   +-----+    O    +-----+   2 C   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   5 C   +-----+   5 E   +-----+   3 E   +-----+   2 C   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   5 E   +-----+   4 E   +-----+   3 E   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   5 E   +-----+   4 C   +-----+   3 C   +-----+   3 E   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   4 C   +-----+   4 E   +-----+   3 C   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+   4 C   +-----+   4 C   +-----+   3 C   +-----+   3 C   +-----+  
+     /       \       /       \       /       \       /       \       /       \ 
+    +         +-----+   4 C   +-----+   4 E   +-----+   3 C   +-----+         +
+     \       /       \       /       \       /       \       /       \       / 
+      +-----+         +-----+         +-----+         +-----+         +-----+  
+
+    O   : celda origen
+    1 E : dirección exacta 1
+        · · · · · 
+    6 E : dirección exacta 6
+    1 C : dirección cuadrante 1
+        · · · · · 
+    6 C : dirección cuadrante 6
+
+****************************************************************************/
+
+
+    void TableroReglas::direccion (int filas, int colns, int & exacta, int & cuadrante) {
+        exacta    = 0;
+        cuadrante = 0;
+        if (filas == 0) {
+            cuadrante = colns > 0 ? 2 : 5;
+        } else if (colns == 0) {
+            exacta = filas > 0 ? 4 : 1;
+        } else if (filas > 0 && colns > 0) {
+            exacta    = filas == colns ? 3 : 0;
+            cuadrante = filas <  colns ? 2 : 3;
+        } else if (filas > 0 && colns < 0) {
+            exacta    = filas == - colns ? 5 : 0;
+            cuadrante = filas <  - colns ? 5 : 4;
+        } else if (filas < 0 && colns > 0) {
+            exacta    = - filas == colns ? 2 : 0;
+            cuadrante = - filas <  colns ? 2 : 1;
+        } else {
+            exacta    = filas == colns ? 6 : 0;
+            cuadrante = - filas < - colns ? 5 : 6;
+        }
+        if (exacta != 0) {
+            cuadrante = 0;
+        }
+    }
+
+
+    bool TableroReglas::segmentoLibre (const Celdas & ocupadas, int celda_origen, int celda_destino) {
+        assert (celda_origen != celda_destino);
+        //
+        int fila_origen  = fila (celda_origen);
+        int coln_origen  = coln (celda_origen);
+        int fila_destino = fila (celda_destino);
+        int coln_destino = coln (celda_destino);
+        int exacta;
+        int cuadrante;
+        direccion (fila_destino - fila_origen, coln_destino - coln_origen, exacta, cuadrante);
+        //
+        int fila_sale = fila_origen;
+        int coln_sale = coln_origen;
+        if (exacta != 0) {
+            while (true) {
+                int fila_llega = fila_sale + pasoFila [exacta];
+                int coln_llega = coln_sale + pasoColn [exacta];
+                if (fila_llega == fila_destino && coln_llega == coln_destino) {
+                    return true;
+                }
+                if (! enTablero (fila_llega, coln_llega)) {
+                    return false;
+                }
+                if (ocupadas.test (celda (fila_llega, coln_llega))) {
+                    return false;
+                }
+                fila_sale = fila_llega;
+                coln_sale = coln_llega;
+            }
+        }
+        //
+        // las candidatas (direcciones exactas) de cada cuadrante
+/****************************************************************************
+              +-----+          
+             /       \         
+      +-----+   1 6   +-----+  
+     /       \       /       \ 
+    +   5 6   +-----+   1 2   +
+     \       /       \       / 
+      +-----+    *    +-----+  
+     /       \       /       \ 
+    +   4 5   +-----+   2 3   +
+     \       /       \       / 
+      +-----+   3 4   +-----+  
+             \       /         
+              +-----+          
+****************************************************************************/
+        Recta recta_segmento = recta (fila_origen, coln_origen, fila_destino, coln_destino);
+        int candidata_1 = candidata (cuadrante, 0);
+        int candidata_2 = candidata (cuadrante, 1);
+        while (true) {
+            int fila_1 = fila_sale + pasoFila [candidata_1];
+            int coln_1 = coln_sale + pasoColn [candidata_1];
+            int fila_2 = fila_sale + pasoFila [candidata_2];
+            int coln_2 = coln_sale + pasoColn [candidata_2];
+            bool valida_1 = enTablero (fila_1, coln_1);
+            bool valida_2 = enTablero (fila_2, coln_2);
+            int fila_llega, coln_llega;
+            if (! valida_1) {
+                fila_llega = fila_2;
+                coln_llega = coln_2;
+                if (! valida_2) {
+                    return false;
+                }
+            } else if (! valida_2) {
+                fila_llega = fila_1;
+                coln_llega = coln_1;
+            } else {
+                float distn_1 = distanciaRecta (recta_segmento, fila_1, coln_1);
+                float distn_2 = distanciaRecta (recta_segmento, fila_2, coln_2);
+                if (distn_1 < distn_2) {
+                    fila_llega = fila_1;
+                    coln_llega = coln_1;
+                } else {
+                    fila_llega = fila_2;
+                    coln_llega = coln_2;
+                }
+            }
+            if (fila_llega == fila_destino && coln_llega == coln_destino) {
+                return true;
+            }
+            if (! enTablero (fila_llega, coln_llega)) {
+                return false;
+            }
+            if (ocupadas.test (celda (fila_llega, coln_llega))) {
+                return false;
+            }
+            fila_sale = fila_llega;
+            coln_sale = coln_llega;
+        }
+    }
+
+
+}
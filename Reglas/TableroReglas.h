@@ -0,0 +1,111 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  TableroReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // La rejilla de 'tapete::RejillaTablero' sin presentación. Cada celda válida es un número 
+    // compacto, de 0 a 'cuentaCeldas' - 1, el mismo que 'tapete::IndiceCelda': la fila y la 
+    // columna (coordenadas dobladas, de igual paridad) se recuperan con 'fila' y 'coln'. 
+    // Las distancias de alcance se miden en casillas; las de desplazamiento, en píxeles de la 
+    // rejilla, con las mismas operaciones en coma flotante que 'RejillaTablero::centroHexagono'.
+    class TableroReglas {
+    public:
+
+        static constexpr int filas        = 51;
+        static constexpr int columnas     = 49;
+        static constexpr int cuentaCeldas = (filas * columnas + 1) / 2;
+        static constexpr int nula         = -1;
+
+        static constexpr int   ladoHexagono = 20;
+        static constexpr float seno60       = 0.85f;
+
+        using Celdas = std::bitset <cuentaCeldas>;
+
+
+        static constexpr int celda (int fila, int coln) {
+            if (fila < 1 || fila > filas || coln < 1 || coln > columnas) {
+                return nula;
+            }
+            if ((fila % 2 == 0) != (coln % 2 == 0)) {
+                return nula;
+            }
+            return ((fila - 1) * columnas + (coln - 1)) / 2;
+        }
+
+        static constexpr int fila (int celda) { return celda * 2 / columnas + 1; }
+        static constexpr int coln (int celda) { return celda * 2 % columnas + 1; }
+
+        // en casillas, pasos entre celdas vecinas
+        static constexpr int distancia (int celda_1, int celda_2) {
+            int dq = coln (celda_2) - coln (celda_1);
+            int dr = (fila (celda_2) - coln (celda_2)) / 2 - (fila (celda_1) - coln (celda_1)) / 2;
+            int ds = - dq - dr;
+            return (absoluto (dq) + absoluto (dr) + absoluto (ds)) / 2;
+        }
+
+        // distancia entre los centros de dos celdas, en píxeles
+        static float longitud (int celda_1, int celda_2);
+
+        // distancia del centro de 'celda' a la recta entre los centros de origen y destino, en 
+        // píxeles; el recorrido de 'segmentoLibre' no se aparta de ella más de media casilla
+        static float desviacion (int celda_origen, int celda_destino, int celda);
+
+        // Si el segmento recto entre dos celdas distintas no atraviesa ninguna celda de 'ocupadas' 
+        // (sin contar origen y destino) ni sale del tablero. Es el recorrido de 
+        // 'tapete::CalculoCaminos::segmentoValido' y de los rayos de 'tapete::RayosVision'.
+        static bool segmentoLibre (const Celdas & ocupadas, int celda_origen, int celda_destino);
+
+
+        // Los pasos del recorrido, en filas y columnas, también fuera del tablero. Hacia un destino
+        // a 'filas' y 'colns' del origen se va por vecinas en línea recta, en la dirección 'exacta' 
+        // (de 1 a 6); si no la hay, en cada paso se va a la más cercana a la recta de las dos 
+        // candidatas del 'cuadrante' (de 1 a 6).
+        static void direccion (int filas, int colns, int & exacta, int & cuadrante);
+
+        static constexpr int pasoFila [7] = { 0, -2, -1,  1,  2,  1, -1 };
+        static constexpr int pasoColn [7] = { 0,  0,  1,  1,  0, -1, -1 };
+
+        // las candidatas de cada cuadrante son la dirección exacta del mismo número y la siguiente 
+        // (en el cuadrante 6, la 1)
+        static constexpr int candidata (int cuadrante, int indice) {
+            return indice == 0 ? cuadrante : cuadrante % 6 + 1;
+        }
+
+        // la recta a·x + b·y + c = 0 entre los centros de dos celdas; 'd' es √(a² + b²)
+        struct Recta {
+            float a;
+            float b;
+            float c;
+            float d;
+        };
+        static Recta recta (int fila_origen, int coln_origen, int fila_destino, int coln_destino);
+        // distancia del centro de la celda a la recta, en píxeles
+        static float distanciaRecta (const Recta & recta, int fila, int coln);
+
+    private:
+
+        static constexpr int absoluto (int valor) { return valor < 0 ? - valor : valor; }
+
+        static void centro (int fila, int coln, float & x, float & y);
+
+        static bool enTablero (int fila, int coln);
+
+    };
+
+
+    static_assert (TableroReglas::cuentaCeldas == 1250);
+    static_assert (TableroReglas::celda ( 1,  1) == 0);
+    static_assert (TableroReglas::celda (51, 49) == TableroReglas::cuentaCeldas - 1);
+    static_assert (TableroReglas::celda ( 2,  1) == TableroReglas::nula);
+    static_assert (TableroReglas::fila (TableroReglas::celda (26, 14)) == 26);
+    static_assert (TableroReglas::coln (TableroReglas::celda (26, 14)) == 14);
+    static_assert (TableroReglas::distancia (TableroReglas::celda (26, 14), TableroReglas::celda (28, 14)) == 1);
+
+
+}
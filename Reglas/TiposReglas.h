@@ -0,0 +1,63 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  TiposReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    enum class LadoTablero {
+        Izquierda,
+        Derecha,
+        nulo
+    };
+
+
+    inline LadoTablero opuesto (LadoTablero lado) {
+        assert (lado != LadoTablero::nulo);
+        if (lado == LadoTablero::Izquierda) {
+            return LadoTablero::Derecha;
+        } else {
+            return LadoTablero::Izquierda;
+        }
+    }
+
+
+    // 0 para la izquierda y 1 para la derecha, para las tablas con un elemento por lado
+    inline int indiceLado (LadoTablero lado) {
+        assert (lado != LadoTablero::nulo);
+        return static_cast <int> (lado);
+    }
+
+
+    // los modos de 'tapete': 'ModoJuegoPares', 'ModoJuegoEquipo' y 'ModoJuegoLibreDoble'
+    enum class ModoReglas {
+        pares,
+        equipo,
+        libreDoble,
+    };
+
+
+    enum class EnfoqueHabilidad {
+        si_mismo,
+        personaje,
+        area,
+    };
+
+    enum class AccesoHabilidad {
+        ninguno,
+        directo,
+        indirecto,
+    };
+
+    enum class Antagonista {
+        oponente,
+        aliado,
+        si_mismo
+    };
+
+
+}
@@ -0,0 +1,351 @@
+﻿// proyecto: Grupal/Reglas
+// arhivo:   TorneoReglas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "reglas.h"
+
+
+namespace reglas {
+
+
+    void TorneoReglas::agregaMapa (const Mapa & mapa) {
+        if (! mapa.reglas.compilada ()) {
+            throw std::logic_error {"TorneoReglas: reglas sin compilar en el mapa " + mapa.nombre};
+        }
+        if (! mapas.empty () && 
+            (mapa.reglas.cuentaPersonajes ()    != mapas [0].reglas.cuentaPersonajes ()     || 
+             mapa.reglas.habilidades ().size () != mapas [0].reglas.habilidades ().size ()    )) {
+            throw std::logic_error {"TorneoReglas: el mapa " + mapa.nombre + " no tiene el mismo plantel"};
+        }
+        mapas.push_back (mapa);
+        // todas las partidas del mapa, en todos los hilos, comparten los mismos destinos
+        mapas.back ().reglas.preparaDestinos ();
+    }
+
+
+    void TorneoReglas::agregaPolitica (const std::string & nombre, CreaPolitica crea) {
+        politicas.push_back ({ nombre, crea });
+    }
+
+
+    void TorneoReglas::nombraPlantel (
+            const std::vector <std::string> & personajes, 
+            const std::vector <std::string> & habilidades ) {
+        nombres_personajes  = personajes;
+        nombres_habilidades = habilidades;
+    }
+
+
+    const std::vector <TorneoReglas::Enfrentamiento> & TorneoReglas::enfrentamientos () const {
+        return enfrentamientos_;
+    }
+
+
+    const std::vector <TorneoReglas::Resultado> & TorneoReglas::resultados () const {
+        return resultados_;
+    }
+
+
+    int64_t TorneoReglas::partidasJugadas () const {
+        return partidas_jugadas;
+    }
+
+
+    double TorneoReglas::segundos () const {
+        return segundos_;
+    }
+
+
+    int TorneoReglas::hilos () const {
+        return hilos_;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void TorneoReglas::ejecuta (const Configuracion & configuracion) {
+        if (mapas.empty () || politicas.empty ()) {
+            throw std::logic_error {"TorneoReglas: sin mapas o sin políticas"};
+        }
+        if (configuracion.partidas <= 0 || configuracion.maximo_rondas <= 0) {
+            throw std::logic_error {"TorneoReglas: configuración inválida"};
+        }
+        configuracion_ = configuracion;
+        preparaEnfrentamientos ();
+        //
+        size_t cuenta_habilidades = mapas [0].reglas.habilidades ().size ();
+        Resultado vacio {};
+        vacio.usos    .assign (cuenta_habilidades, 0);
+        vacio.dano    .assign (cuenta_habilidades, 0);
+        vacio.curacion.assign (cuenta_habilidades, 0);
+        resultados_.assign (enfrentamientos_.size (), vacio);
+        //
+        hilos_ = configuracion_.hilos;
+        if (hilos_ <= 0) {
+            hilos_ = std::max (1, static_cast <int> (std::thread::hardware_concurrency ()));
+        }
+        auto inicio = std::chrono::steady_clock::now ();
+        // cada hilo toma el siguiente enfrentamiento libre: solo él escribe en su resultado
+        std::atomic <int>  siguiente {0};
+        std::exception_ptr error {};
+        std::mutex         cerrojo {};
+        std::vector <std::thread> trabajadores {};
+        for (int indc = 0; indc < hilos_; ++ indc) {
+            trabajadores.emplace_back ([&] () {
+                try {
+                    trabaja (siguiente);
+                } catch (...) {
+                    std::lock_guard <std::mutex> bloqueo {cerrojo};
+                    if (error == nullptr) {
+                        error = std::current_exception ();
+                    }
+                    siguiente = static_cast <int> (enfrentamientos_.size ());
+                }
+            });
+        }
+        for (std::thread & trabajador : trabajadores) {
+            trabajador.join ();
+        }
+        if (error != nullptr) {
+            std::rethrow_exception (error);
+        }
+        auto final = std::chrono::steady_clock::now ();
+        segundos_ = std::chrono::duration <double> (final - inicio).count ();
+        partidas_jugadas = 0;
+        for (const Resultado & resultado : resultados_) {
+            partidas_jugadas += resultado.partidas;
+        }
+    }
+
+
+    void TorneoReglas::preparaEnfrentamientos () {
+        int cuenta_personajes = mapas [0].reglas.cuentaPersonajes ();
+        int puestos = std::numeric_limits <int>::max ();
+        for (const Mapa & mapa : mapas) {
+            puestos = std::min ({ puestos, 
+                                  static_cast <int> (mapa.celdas [0].size ()), 
+                                  static_cast <int> (mapa.celdas [1].size ())  });
+        }
+        int tamano = configuracion_.tamano_equipo > 0 ? configuracion_.tamano_equipo : puestos;
+        if (tamano < 1 || tamano > puestos || tamano > cuenta_personajes || 
+            tamano * 2 > ReglasPartida::maximoPersonajes                      ) {
+            throw std::logic_error {"TorneoReglas: tamaño de equipo inválido"};
+        }
+        // las combinaciones de 'tamano' personajes, en orden lexicográfico
+        std::vector <std::vector <int>> equipos {};
+        std::vector <int> equipo (tamano);
+        for (int indc = 0; indc < tamano; ++ indc) {
+            equipo [indc] = indc;
+        }
+        while (true) {
+            equipos.push_back (equipo);
+            int posicion = tamano - 1;
+            while (posicion >= 0 && equipo [posicion] == cuenta_personajes - tamano + posicion) {
+                posicion --;
+            }
+            if (posicion < 0) {
+                break;
+            }
+            equipo [posicion] ++;
+            for (int indc = posicion + 1; indc < tamano; ++ indc) {
+                equipo [indc] = equipo [indc - 1] + 1;
+            }
+        }
+        //
+        enfrentamientos_.clear ();
+        for (ModoReglas modo : configuracion_.modos) {
+            for (int mapa = 0; mapa < std::ssize (mapas); ++ mapa) {
+                for (const std::vector <int> & izquierda : equipos) {
+                    for (const std::vector <int> & derecha : equipos) {
+                        for (int politica_izqrd = 0; politica_izqrd < std::ssize (politicas); ++ politica_izqrd) {
+                            for (int politica_derch = 0; politica_derch < std::ssize (politicas); ++ politica_derch) {
+                                enfrentamientos_.push_back (Enfrentamiento {
+                                        modo, mapa, izquierda, derecha, politica_izqrd, politica_derch });
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (enfrentamientos_.size () > static_cast <size_t> (std::numeric_limits <int>::max ())) {
+            throw std::logic_error {"TorneoReglas: demasiados enfrentamientos"};
+        }
+    }
+
+
+    void TorneoReglas::trabaja (std::atomic <int> & siguiente) {
+        // las políticas pueden guardar estado: unas propias de este hilo para cada lado
+        std::array <std::vector <std::unique_ptr <PoliticaJuego>>, 2> politicas_hilo {};
+        for (std::vector <std::unique_ptr <PoliticaJuego>> & politicas_lado : politicas_hilo) {
+            for (const std::pair <std::string, CreaPolitica> & politica : politicas) {
+                politicas_lado.push_back (politica.second ());
+            }
+        }
+        while (true) {
+            int indice = siguiente.fetch_add (1);
+            if (indice >= static_cast <int> (enfrentamientos_.size ())) {
+                return;
+            }
+            juegaEnfrentamiento (indice, politicas_hilo, resultados_ [indice]);
+        }
+    }
+
+
+    void TorneoReglas::juegaEnfrentamiento (
+            int indice, 
+            std::array <std::vector <std::unique_ptr <PoliticaJuego>>, 2> & politicas_hilo, 
+            Resultado & resultado ) {
+        const Enfrentamiento & enfrentamiento = enfrentamientos_ [indice];
+        const Mapa & mapa = mapas [enfrentamiento.mapa];
+        ReglasPartida reglas = mapa.reglas.alinea (enfrentamiento.izquierda, enfrentamiento.derecha);
+        MotorReglas   motor {reglas, enfrentamiento.modo};
+        std::vector <int> celdas {};
+        for (int puesto = 0; puesto < std::ssize (enfrentamiento.izquierda); ++ puesto) {
+            celdas.push_back (mapa.celdas [0] [puesto]);
+        }
+        for (int puesto = 0; puesto < std::ssize (enfrentamiento.derecha); ++ puesto) {
+            celdas.push_back (mapa.celdas [1] [puesto]);
+        }
+        std::array <PoliticaJuego *, 2> politica_lado { 
+                politicas_hilo [0] [enfrentamiento.politica_izquierda].get (), 
+                politicas_hilo [1] [enfrentamiento.politica_derecha]  .get ()  };
+        //
+        Observador           observador {resultado};
+        GeneradorAzar        azar_partida {};
+        GeneradorAzar        azar_politica {};
+        EstadoPartida        estado {};
+        std::vector <Jugada> jugadas {};
+        for (int partida = 0; partida < configuracion_.partidas; ++ partida) {
+            // las tiradas de una partida no dependen de las decisiones de las políticas
+            uint64_t numero = static_cast <uint64_t> (indice) * configuracion_.partidas + partida;
+            azar_partida .siembra (configuracion_.semilla, numero * 2);
+            azar_politica.siembra (configuracion_.semilla, numero * 2 + 1);
+            motor.inicia (estado, celdas, azar_partida);
+            while (! motor.terminada (estado) && estado.ronda <= configuracion_.maximo_rondas) {
+                motor.generaJugadas (estado, jugadas);
+                LadoTablero lado = motor.ladoDecide (estado);
+                int elegida = politica_lado [indiceLado (lado)]->elige (motor, estado, jugadas, azar_politica);
+                motor.aplica (estado, jugadas [elegida], azar_partida, & observador);
+            }
+            resultado.partidas ++;
+            resultado.rondas += std::min <int> (estado.ronda, configuracion_.maximo_rondas);
+            switch (motor.ganador (estado)) {
+            case LadoTablero::Izquierda:
+                resultado.victorias_izquierda ++;
+                break;
+            case LadoTablero::Derecha:
+                resultado.victorias_derecha ++;
+                break;
+            default:
+                resultado.empates ++;
+                break;
+            }
+        }
+    }
+
+
+    TorneoReglas::Observador::Observador (Resultado & resultado) : 
+            resultado_ {resultado} {
+    }
+
+
+    void TorneoReglas::Observador::habilidadAplicada (int /*personaje*/, int habilidad, int /*aleatorio_100*/) {
+        habilidad_ = habilidad;
+        resultado_.usos [habilidad] ++;
+    }
+
+
+    void TorneoReglas::Observador::vitalidadCambiada (int /*personaje*/, int vitalidad_origen, int vitalidad_final) {
+        // solo las habilidades cambian la vitalidad, justo después de 'habilidadAplicada'
+        assert (habilidad_ != -1);
+        if (vitalidad_final < vitalidad_origen) {
+            resultado_.dano     [habilidad_] += vitalidad_origen - vitalidad_final;
+        } else {
+            resultado_.curacion [habilidad_] += vitalidad_final - vitalidad_origen;
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void TorneoReglas::escribeCsv (std::ostream & salida) const {
+        salida << "modo,mapa,izquierda,derecha,politica_izquierda,politica_derecha,"
+                  "partidas,victorias_izquierda,victorias_derecha,empates,rondas_media";
+        size_t cuenta_habilidades = mapas.empty () ? 0 : mapas [0].reglas.habilidades ().size ();
+        for (size_t habilidad = 0; habilidad < cuenta_habilidades; ++ habilidad) {
+            std::string nombre = habilidad < nombres_habilidades.size () ? 
+                    nombres_habilidades [habilidad] : std::to_string (habilidad);
+            salida << "," << campoCsv ("usos "     + nombre);
+            salida << "," << campoCsv ("dano "     + nombre);
+            salida << "," << campoCsv ("curacion " + nombre);
+        }
+        salida << "\n";
+        for (size_t indc = 0; indc < enfrentamientos_.size (); ++ indc) {
+            const Enfrentamiento & enfrentamiento = enfrentamientos_ [indc];
+            const Resultado &      resultado      = resultados_ [indc];
+            salida << nombreModo (enfrentamiento.modo) << ",";
+            salida << campoCsv (mapas [enfrentamiento.mapa].nombre) << ",";
+            salida << campoCsv (nombreEquipo (enfrentamiento.izquierda)) << ",";
+            salida << campoCsv (nombreEquipo (enfrentamiento.derecha)) << ",";
+            salida << campoCsv (politicas [enfrentamiento.politica_izquierda].first) << ",";
+            salida << campoCsv (politicas [enfrentamiento.politica_derecha]  .first) << ",";
+            salida << resultado.partidas << ",";
+            salida << resultado.victorias_izquierda << ",";
+            salida << resultado.victorias_derecha << ",";
+            salida << resultado.empates << ",";
+            salida << (resultado.partidas > 0 ? static_cast <double> (resultado.rondas) / resultado.partidas : 0.0);
+            for (size_t habilidad = 0; habilidad < resultado.usos.size (); ++ habilidad) {
+                salida << "," << resultado.usos     [habilidad];
+                salida << "," << resultado.dano     [habilidad];
+                salida << "," << resultado.curacion [habilidad];
+            }
+            salida << "\n";
+        }
+    }
+
+
+    const char * TorneoReglas::nombreModo (ModoReglas modo) {
+        switch (modo) {
+        case ModoReglas::pares:
+            return "pares";
+        case ModoReglas::equipo:
+            return "equipo";
+        case ModoReglas::libreDoble:
+            return "libreDoble";
+        }
+        return "";
+    }
+
+
+    const std::string TorneoReglas::nombreEquipo (const std::vector <int> & equipo) const {
+        std::string nombre {};
+        for (int personaje : equipo) {
+            if (! nombre.empty ()) {
+                nombre += "+";
+            }
+            nombre += personaje < std::ssize (nombres_personajes) ? 
+                    nombres_personajes [personaje] : std::to_string (personaje);
+        }
+        return nombre;
+    }
+
+
+    const std::string TorneoReglas::campoCsv (const std::string & texto) {
+        if (texto.find_first_of (",\"\n") == std::string::npos) {
+            return texto;
+        }
+        std::string campo {"\""};
+        for (char caracter : texto) {
+            if (caracter == '"') {
+                campo += '"';
+            }
+            campo += caracter;
+        }
+        return campo + "\"";
+    }
+
+
+}
@@ -0,0 +1,128 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  TorneoReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace reglas {
+
+
+    // Un torneo de todos contra todos para equilibrar a los personajes: juega sin presentación 
+    // miles de partidas completas entre equipos formados con los personajes de las reglas (el 
+    // plantel), en cada modo, en cada mapa y con cada pareja de políticas, y acumula victorias, 
+    // rondas y, por habilidad, usos, daño y curación.
+    // Un enfrentamiento es un modo, un mapa, un equipo y una política por lado. Los equipos son 
+    // todas las combinaciones de 'tamano_equipo' personajes distintos del plantel, y cada pareja 
+    // de equipos (también un equipo contra sí mismo) juega en los dos lados.
+    // Los enfrentamientos se reparten entre varios hilos; cada hilo tiene sus políticas, sus 
+    // generadores y sus acumuladores, que se suman al final. Cada partida siembra sus generadores 
+    // con la semilla del torneo y su número, así que el resultado no depende del número de hilos.
+    class TorneoReglas {
+    public:
+
+        struct Mapa {
+            std::string   nombre {};
+            // compiladas; sus personajes son el plantel
+            ReglasPartida reglas {};
+            // celda inicial de cada puesto de cada equipo ('indiceLado')
+            std::array <std::vector <int>, 2> celdas {};
+        };
+
+        struct Configuracion {
+            std::vector <ModoReglas> modos { ModoReglas::pares, ModoReglas::equipo, ModoReglas::libreDoble };
+            // partidas de cada enfrentamiento
+            int      partidas {20};
+            // una partida que llega a esta ronda sin ganador es un empate
+            int      maximo_rondas {30};
+            // cero: tantos hilos como núcleos
+            int      hilos {};
+            uint64_t semilla {};
+            // cero: tantos personajes como puestos tienen los mapas
+            int      tamano_equipo {};
+        };
+
+        struct Enfrentamiento {
+            ModoReglas       modo {};
+            int              mapa {};
+            std::vector <int> izquierda {};
+            std::vector <int> derecha {};
+            int              politica_izquierda {};
+            int              politica_derecha {};
+        };
+
+        struct Resultado {
+            int     partidas {};
+            int     victorias_izquierda {};
+            int     victorias_derecha {};
+            int     empates {};
+            int64_t rondas {};
+            // por habilidad ('ReglasPartida::habilidades')
+            std::vector <int64_t> usos {};
+            std::vector <int64_t> dano {};
+            std::vector <int64_t> curacion {};
+        };
+
+        using CreaPolitica = std::function <std::unique_ptr <PoliticaJuego> ()>;
+
+
+        void agregaMapa (const Mapa & mapa);
+        void agregaPolitica (const std::string & nombre, CreaPolitica crea);
+        // para el archivo CSV; por omisión, los índices
+        void nombraPlantel (const std::vector <std::string> & personajes, const std::vector <std::string> & habilidades);
+
+        // prepara los enfrentamientos y juega todas las partidas
+        void ejecuta (const Configuracion & configuracion);
+
+        const std::vector <Enfrentamiento> & enfrentamientos () const;
+        const std::vector <Resultado> & resultados () const;
+        int64_t partidasJugadas () const;
+        double  segundos () const;
+        int     hilos () const;
+
+        // una línea por enfrentamiento
+        void escribeCsv (std::ostream & salida) const;
+
+        static const char * nombreModo (ModoReglas modo);
+
+    private:
+
+        // anota en el resultado del enfrentamiento los usos y los efectos de las habilidades
+        class Observador : public ObservadorReglas {
+        public:
+            explicit Observador (Resultado & resultado);
+            void habilidadAplicada (int personaje, int habilidad, int aleatorio_100) override;
+            void vitalidadCambiada (int personaje, int vitalidad_origen, int vitalidad_final) override;
+        private:
+            Resultado & resultado_;
+            int         habilidad_ {-1};
+        };
+
+        std::vector <Mapa> mapas {};
+        std::vector <std::pair <std::string, CreaPolitica>> politicas {};
+        std::vector <std::string> nombres_personajes {};
+        std::vector <std::string> nombres_habilidades {};
+
+        Configuracion               configuracion_ {};
+        std::vector <Enfrentamiento> enfrentamientos_ {};
+        std::vector <Resultado>      resultados_ {};
+        int64_t                      partidas_jugadas {};
+        double                       segundos_ {};
+        int                          hilos_ {};
+
+
+        void preparaEnfrentamientos ();
+        void trabaja (std::atomic <int> & siguiente);
+        void juegaEnfrentamiento (
+                int indice, 
+                std::array <std::vector <std::unique_ptr <PoliticaJuego>>, 2> & politicas_hilo, 
+                Resultado & resultado );
+
+        const std::string nombreEquipo (const std::vector <int> & equipo) const;
+        static const std::string campoCsv (const std::string & texto);
+
+    };
+
+
+}
@@ -0,0 +1,6 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  pch.cpp
+// versión:  1.1  (9-Ene-2023)
+        
+
+#include "reglas.h"
@@ -0,0 +1,51 @@
+﻿// proyecto: Grupal/Reglas
+// archivo:  reglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+// Reglas del juego sin presentación: no dependen de UNIR-2D ni de SFML, de modo que una partida
+// se puede jugar entera sin ventana (simulaciones, torneos, búsqueda de jugadas, medidas de 
+// rendimiento).
+// 'Tapete' las usa a través de 'ConversionReglas'.
+
+
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <bitset>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <string>
+#include <memory>
+#include <functional>
+#include <ostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+#include "TiposReglas.h"
+#include "Huella.h"
+#include "GeneradorAzar.h"
+#include "TableroReglas.h"
+#include "ReglasPartida.h"
+#include "EstadoPartida.h"
+#include "ClaveZobrist.h"
+#include "Jugada.h"
+#include "MotorReglas.h"
+#include "PoliticaJuego.h"
+#include "PoliticaUtilidad.h"
+#include "BusquedaArea.h"
+#include "TorneoReglas.h"
+#include "BusquedaMonteCarlo.h"
+#include "BusquedaExpectimax.h"
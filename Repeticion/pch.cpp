@@ -0,0 +1,6 @@
+﻿// proyecto: Grupal/Repeticion
+// arhivo:   pch.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "juego.h"
\ No newline at end of file
@@ -0,0 +1,116 @@
+﻿// proyecto: Grupal/Repeticion
+// arhivo:   principal.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "juego.h"
+
+
+// Repite sin ventana las partidas grabadas con 'JuegoMesaBase::grabaPartida', con la 
+// configuración de 'JuegoMesa' (se ejecuta en la carpeta de 'Juego', donde están los activos). 
+// Informa de la velocidad y del primer punto en que la repetición difiere de la grabación; 
+// termina con 0 si todas coinciden y con 1 si alguna difiere.
+// Con '--version-1', cada grabación se repite además como si fuera de la versión 1 (sin los 
+// sucesos 'jugada'), para probar que esas grabaciones se siguen pudiendo repetir.
+// Con '--rejilla', en lugar de repetir, comprueba la tabla que localiza la celda de cada píxel 
+// del tablero ('RejillaTablero::compruebaLocalizacion').
+//
+//     uso: Repeticion [--version-1] <grabación> [<grabación> ...]
+//          Repeticion --rejilla
+
+
+namespace {
+
+
+    bool repite (
+            const string &                                  nombre, 
+            const GrabacionPartida::Cabecera &              cabecera, 
+            const std::vector <GrabacionPartida::Registro> & registros ) {
+        std::unique_ptr <juego::JuegoMesa> juego {new juego::JuegoMesa {}};
+        RepeticionPartida repeticion {juego.get ()};
+        repeticion.carga (cabecera, registros);
+        RepeticionPartida::Resultado resultado = repeticion.ejecuta ();
+        //
+        std::cout << nombre << std::endl;
+        std::cout << "    semilla " << repeticion.cabecera ().semilla << ", ";
+        std::cout << resultado.registros << " registros, ";
+        std::cout << resultado.decisiones << " decisiones, ";
+        std::cout << resultado.jugadas << " jugadas comprobadas" << std::endl;
+        if (resultado.segundos > 0.0) {
+            std::cout << "    " << resultado.segundos * 1e3 << " ms, ";
+            std::cout << static_cast <int64_t> (resultado.registros / resultado.segundos) << " sucesos/s" << std::endl;
+        }
+        if (resultado.coincide) {
+            std::cout << "    coincide" << std::endl;
+        } else {
+            std::cout << "    DIFIERE en el registro " << resultado.registro_divergente;
+            std::cout << " (ronda " << resultado.ronda << ", turno " << resultado.turno;
+            std::cout << ", jugada " << resultado.jugada << "): " << std::endl;
+            std::cout << "    " << resultado.explicacion << std::endl;
+        }
+        //
+        repeticion.termina ();
+        return resultado.coincide;
+    }
+
+
+    bool repite (const string & ruta_archivo, bool como_version_1) {
+        GrabacionPartida::Cabecera              cabecera {};
+        std::vector <GrabacionPartida::Registro> registros {};
+        GrabacionPartida::lee (ruta_archivo, cabecera, registros);
+        bool coincide = repite (ruta_archivo, cabecera, registros);
+        if (como_version_1) {
+            std::erase_if (registros, [] (const GrabacionPartida::Registro & registro) {
+                return registro.suceso == GrabacionPartida::Suceso::jugada;
+            });
+            cabecera.version = 1;
+            if (! repite (ruta_archivo + " (como versión 1)", cabecera, registros)) {
+                coincide = false;
+            }
+        }
+        return coincide;
+    }
+
+
+}
+
+
+int main (int cuenta_argumentos, char * argumentos []) {
+    if (cuenta_argumentos == 2 && string {argumentos [1]} == "--rejilla") {
+        Vector pixel_erroneo {};
+        if (! RejillaTablero::compruebaLocalizacion (pixel_erroneo)) {
+            std::cout << "localización de celdas errónea en el píxel (";
+            std::cout << pixel_erroneo.x () << ", " << pixel_erroneo.y () << ")" << std::endl;
+            return 1;
+        }
+        std::cout << "localización de celdas correcta" << std::endl;
+        return 0;
+    }
+    int  primero = 1;
+    bool como_version_1 = false;
+    if (cuenta_argumentos > 1 && string {argumentos [1]} == "--version-1") {
+        como_version_1 = true;
+        primero ++;
+    }
+    if (cuenta_argumentos <= primero) {
+        std::cerr << "uso: Repeticion [--version-1] <grabación> [<grabación> ...]" << std::endl;
+        std::cerr << "     Repeticion --rejilla" << std::endl;
+        return 2;
+    }
+    std::setlocale (LC_ALL, "es_ES.utf8");
+    // las trazas del avance de la partida costarían más que la propia repetición
+    ModoJuegoBase::trazaAvance (false);
+    EstadoJuegoComun::trazaTransitos (false);
+    bool coinciden = true;
+    for (int indc = primero; indc < cuenta_argumentos; ++ indc) {
+        try {
+            if (! repite (argumentos [indc], como_version_1)) {
+                coinciden = false;
+            }
+        } catch (const std::exception & excepcion) {
+            std::cerr << argumentos [indc] << ": " << excepcion.what () << std::endl;
+            coinciden = false;
+        }
+    }
+    return coinciden ? 0 : 1;
+}
@@ -68,69 +68,104 @@ namespace tapete {
 
 
     void ActorPersonaje::agregaAtaque (TipoAtaque * tipo_ataque, int valor) {
-        valores_tipo_ataque [tipo_ataque] = Multivalor {valor, 0};
+        int indice = indiceTipo (tipo_ataque);
+        valores_tipo_ataque.inicial [indice] = valor;
+        valores_tipo_ataque.cambio  [indice] = 0;
+        valores_tipo_ataque.aparece.set (indice);
     }
 
 
     bool ActorPersonaje::apareceAtaque (TipoAtaque * tipo_ataque) const {
-        return valores_tipo_ataque.contains (tipo_ataque);
+        return valores_tipo_ataque.aparece.test (indiceTipo (tipo_ataque));
     }
 
 
     int ActorPersonaje::valorAtaque (TipoAtaque * tipo_ataque) const {
-        Multivalor multi = valores_tipo_ataque.at (tipo_ataque);
-        return multi.inicial + multi.cambio;
+        int indice = indiceAsignado (valores_tipo_ataque, tipo_ataque);
+        return valores_tipo_ataque.inicial [indice] + valores_tipo_ataque.cambio [indice];
     }
 
 
     void ActorPersonaje::cambiaAtaque (TipoAtaque * tipo_ataque, int valor_cambio) {
-        valores_tipo_ataque.at (tipo_ataque).cambio = valor_cambio;
+        valores_tipo_ataque.cambio [indiceAsignado (valores_tipo_ataque, tipo_ataque)] = valor_cambio;
     }
 
 
     void ActorPersonaje::restauraAtaque (TipoAtaque * tipo_ataque) {
-        valores_tipo_ataque.at (tipo_ataque).cambio = 0;
+        valores_tipo_ataque.cambio [indiceAsignado (valores_tipo_ataque, tipo_ataque)] = 0;
     }
 
         
     void ActorPersonaje::agregaDefensa (TipoDefensa * tipo_defensa, int valor) {
-        valores_tipo_defensa [tipo_defensa] = Multivalor {valor, 0};
+        int indice = indiceTipo (tipo_defensa);
+        valores_tipo_defensa.inicial [indice] = valor;
+        valores_tipo_defensa.cambio  [indice] = 0;
+        valores_tipo_defensa.aparece.set (indice);
     }
 
 
     bool ActorPersonaje::apareceDefensa (TipoDefensa * tipo_defensa) const {
-        return valores_tipo_defensa.contains (tipo_defensa);
+        return valores_tipo_defensa.aparece.test (indiceTipo (tipo_defensa));
     }
 
 
     int ActorPersonaje::valorDefensa (TipoDefensa * tipo_defensa) const {
-        Multivalor multi = valores_tipo_defensa.at (tipo_defensa);
-        return multi.inicial + multi.cambio;
+        int indice = indiceAsignado (valores_tipo_defensa, tipo_defensa);
+        return valores_tipo_defensa.inicial [indice] + valores_tipo_defensa.cambio [indice];
     }
 
 
     void ActorPersonaje::cambiaDefensa (TipoDefensa * tipo_defensa, int valor_cambio) {
-        valores_tipo_defensa.at (tipo_defensa).cambio = valor_cambio;
+        valores_tipo_defensa.cambio [indiceAsignado (valores_tipo_defensa, tipo_defensa)] = valor_cambio;
     }
 
 
     void ActorPersonaje::restauraDefensa (TipoDefensa * tipo_defensa) {
-        valores_tipo_defensa.at (tipo_defensa).cambio = 0;
+        valores_tipo_defensa.cambio [indiceAsignado (valores_tipo_defensa, tipo_defensa)] = 0;
     }
 
 
     void ActorPersonaje::agregaReduceDano (TipoDano * tipo_dano, int valor) {
-        valores_tipo_reduce_dano [tipo_dano] = valor;
+        int indice = indiceTipo (tipo_dano);
+        valores_tipo_reduce_dano.inicial [indice] = valor;
+        valores_tipo_reduce_dano.aparece.set (indice);
     }
 
 
     bool ActorPersonaje::apareceReduceDano (TipoDano * tipo_dano) const {
-        return valores_tipo_reduce_dano.contains (tipo_dano);
+        return valores_tipo_reduce_dano.aparece.test (indiceTipo (tipo_dano));
     }
 
 
     int ActorPersonaje::valorReduceDano (TipoDano * tipo_dano) const {
-        return valores_tipo_reduce_dano.at (tipo_dano);
+        int indice = indiceAsignado (valores_tipo_reduce_dano, tipo_dano);
+        return valores_tipo_reduce_dano.inicial [indice];
+    }
+
+
+    void ActorPersonaje::restauraEstadisticas () {
+        // la columna de cambios de cada tabla, de una vez
+        std::memset (valores_tipo_ataque .cambio.data (), 0, sizeof (valores_tipo_ataque .cambio));
+        std::memset (valores_tipo_defensa.cambio.data (), 0, sizeof (valores_tipo_defensa.cambio));
+    }
+
+
+    int ActorPersonaje::indiceTipo (const TipoEstadistica * tipo) {
+        // véase: 'ValidacionJuego::TiposEstadisticas'
+        if (tipo->indice () < 0 || maximoTiposEstadistica <= tipo->indice ()) {
+            throw std::out_of_range {"ActorPersonaje: índice de tipo de estadística inválido"};
+        }
+        return tipo->indice ();
+    }
+
+
+    int ActorPersonaje::indiceAsignado (const TablaValores & tabla, const TipoEstadistica * tipo) {
+        // como el 'at' de los mapas a los que sustituyen las tablas
+        int indice = indiceTipo (tipo);
+        if (! tabla.aparece.test (indice)) {
+            throw std::out_of_range {"ActorPersonaje: tipo de estadística no asignado al personaje"};
+        }
+        return indice;
     }
 
 
@@ -165,6 +200,10 @@ namespace tapete {
 
 
     void ActorPersonaje::ponSitioFicha (Coord valor) {
+        // el tablero puede no existir aún si se configura antes de prepararlo
+        if (juego_->tablero () != nullptr) {
+            juego_->tablero ()->ocupacion ().mueve (CapaOcupacion::fichas, sitio_ficha, valor);
+        }
         sitio_ficha = valor;
     }
 
@@ -301,6 +340,7 @@ namespace tapete {
         bool sclic = unir2d::Raton::pulsando (unir2d::BotonRaton::izquierda);
         if (sclic) {
             if (presencia_personaje.panel_lateral.contiene (unir2d::Raton::posicion ())) {
+                juego_->grabacion ().anota (GrabacionPartida::Suceso::personajeSeleccionado, indice_);
                 juego_->sucesos ()->personajeSeleccionado (this);
             }
         }
@@ -342,9 +382,11 @@ namespace tapete {
             poscn += PresenciaTablero::regionRejilla.posicion ();
             if (norma (unir2d::Raton::posicion () - poscn) <= PresenciaPersonaje::radioFicha) {
                 if (dclic) {
+                    juego_->grabacion ().anota (GrabacionPartida::Suceso::fichaSeleccionada, indice_);
                     juego_->sucesos ()->fichaSeleccionada (this);
                 } 
                 if (sclic) {
+                    juego_->grabacion ().anota (GrabacionPartida::Suceso::fichaPulsada, indice_);
                     juego_->sucesos ()->fichaPulsada (this);
                 }
             }
@@ -49,8 +49,12 @@ namespace tapete {
         // cero. El valor de cambio es asignado al usar determinadas habilidades.
         // Cuando se inicia un nuevo ronda, los valores de cambio deben pasar automáticamente a ser 
         // cero. 
+        // Los valores se guardan en tablas fijas, indexadas por el índice de cada tipo en el juego,
+        // de modo que no puede haber más de 'maximoTiposEstadistica' tipos de cada clase.
         // 
 
+        static constexpr int maximoTiposEstadistica = reglas::ReglasPartida::maximoTiposEstadistica;
+
         bool apareceAtaque  (TipoAtaque * tipo_ataque) const; 
         int  valorAtaque    (TipoAtaque * tipo_ataque) const; 
         void agregaAtaque   (TipoAtaque * tipo_ataque, int valor_base);
@@ -67,7 +71,10 @@ namespace tapete {
         int  valorReduceDano   (TipoDano * tipo_dano) const; 
         void agregaReduceDano  (TipoDano * tipo_dano, int valor);
 
-        static constexpr int maximoHabilidades  = 10;
+        // deja a cero todos los valores de cambio de ataques y defensas
+        void restauraEstadisticas ();
+
+        static constexpr int maximoHabilidades  = reglas::ReglasPartida::maximoHabilidades;
         const std::vector <Habilidad *> & habilidades () const;
         void agregaHabilidad (Habilidad * elemento);
 
@@ -83,11 +90,11 @@ namespace tapete {
         // Estadísticas de los personajes
         //------------------------------------------------------------------------------------------
 
-        static constexpr int maximaVitalidad = 150;
+        static constexpr int maximaVitalidad = reglas::ReglasPartida::maximaVitalidad;
         int vitalidad () const;
         void ponVitalidad (int valor);
 
-        static constexpr int maximoPuntosAccion = 20;
+        static constexpr int maximoPuntosAccion = reglas::ReglasPartida::maximoPuntosAccion;
         int puntosAccion () const;
         void ponPuntosAccion (int valor);
 
@@ -119,13 +126,19 @@ namespace tapete {
         string archivo_retrato {};
         string archivo_ficha {};
 
-        struct Multivalor {
-            int inicial;
-            int cambio;
+        struct TablaValores {
+            std::array <int, maximoTiposEstadistica> inicial {};
+            std::array <int, maximoTiposEstadistica> cambio {};
+            std::bitset <maximoTiposEstadistica>     aparece {};
         };
-        std::map <TipoAtaque *,  Multivalor> valores_tipo_ataque {};
-        std::map <TipoDefensa *, Multivalor> valores_tipo_defensa {};
-        std::map <TipoDano *,    int>        valores_tipo_reduce_dano {};
+        TablaValores valores_tipo_ataque {};
+        TablaValores valores_tipo_defensa {};
+        // solo se usa el valor inicial
+        TablaValores valores_tipo_reduce_dano {};
+
+        static int indiceTipo (const TipoEstadistica * tipo);
+        // el de un tipo que el personaje tiene asignado; 'std::out_of_range' si no
+        static int indiceAsignado (const TablaValores & tabla, const TipoEstadistica * tipo);
 
         std::vector <Habilidad *> lista_habilidades {};
 
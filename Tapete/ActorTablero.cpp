@@ -108,6 +108,7 @@ namespace tapete {
 
 
     void ActorTablero::calculaSitiosMuros () {
+        ocupacion_tablero.vacia (CapaOcupacion::muros);
         for (int fl = 0; fl < RejillaTablero::filas; ++ fl) {            
             for (int cl = 0; cl < columnasGraficoMuros; ++ cl) {
                 int fila = fl + 1;
@@ -120,6 +121,7 @@ namespace tapete {
                         char ch = (* this->grafico_muros) [fl] [cl];
                         if (ch == 'O') {
                             sitios_muros.push_back (Coord {fila, coln});
+                            ocupacion_tablero.marca (CapaOcupacion::muros, Coord {fila, coln});
                         }
                     }
                 }
@@ -128,6 +130,16 @@ namespace tapete {
     }
 
 
+    OcupacionTablero & ActorTablero::ocupacion () {
+        return ocupacion_tablero;
+    }
+
+
+    const RayosVision & ActorTablero::rayosVision () const {
+        return rayos_vision;
+    }
+
+
     RejillaTablero & ActorTablero::rejilla () {
         return rejilla_tablero;
     }
@@ -253,6 +265,7 @@ namespace tapete {
         ponPosicion (Vector {0, 0});
         //
         calculaSitiosMuros ();
+        rayos_vision.prepara ();
         //
         presencia_tablero       .prepara ();
         rejilla_tablero         .prepara ();
@@ -387,9 +400,13 @@ namespace tapete {
         bool sclic = unir2d::Raton::pulsando (unir2d::BotonRaton::izquierda);
         if (sclic) {
             if (presencia_actuante_izqrd.panel_retrato.contiene (unir2d::Raton::posicion ())) {       
+                juego->grabacion ().anota (GrabacionPartida::Suceso::actuanteSeleccionado, 
+                                           reglas::indiceLado (LadoTablero::Izquierda));
                 juego->sucesos ()->actuanteSeleccionado (LadoTablero::Izquierda);
             }
             if (presencia_actuante_derch.panel_retrato.contiene (unir2d::Raton::posicion ())) {    
+                juego->grabacion ().anota (GrabacionPartida::Suceso::actuanteSeleccionado, 
+                                           reglas::indiceLado (LadoTablero::Derecha));
                 juego->sucesos ()->actuanteSeleccionado (LadoTablero::Derecha);
             }
         }
@@ -402,11 +419,15 @@ namespace tapete {
         if (sclic) {
             for (int indc = 0; indc < presencia_actuante_izqrd.paneles_habilidad.size (); ++ indc) {
                 if (presencia_actuante_izqrd.paneles_habilidad [indc].contiene (unir2d::Raton::posicion ())) {
+                    juego->grabacion ().anota (GrabacionPartida::Suceso::habilidadSeleccionada, 
+                                               reglas::indiceLado (LadoTablero::Izquierda), indc);
                     juego->sucesos ()->habilidadSeleccionada (LadoTablero::Izquierda, indc);
                 }
             }
             for (int indc = 0; indc < presencia_actuante_derch.paneles_habilidad.size (); ++ indc) {
                 if (presencia_actuante_derch.paneles_habilidad [indc].contiene (unir2d::Raton::posicion ())) {
+                    juego->grabacion ().anota (GrabacionPartida::Suceso::habilidadSeleccionada, 
+                                               reglas::indiceLado (LadoTablero::Derecha), indc);
                     juego->sucesos ()->habilidadSeleccionada (LadoTablero::Derecha, indc);
                 }
             }
@@ -422,7 +443,7 @@ namespace tapete {
         Coord coord {};
         Vector poscn = unir2d::Raton::posicion ();
         poscn -= PresenciaTablero::regionRejilla.posicion ();
-        rejilla_tablero.localizaCelda (poscn, coord); 
+        rejilla_tablero.localizaCeldaTabla (poscn, coord); 
         if (coord != Coord {0, 0}) { 
             sobre_ahora.esta  = true;
             sobre_ahora.celda = coord;
@@ -459,11 +480,13 @@ namespace tapete {
             Coord coord {};
             Vector poscn = unir2d::Raton::posicion ();
             poscn -= PresenciaTablero::regionRejilla.posicion ();
-            rejilla_tablero.localizaCelda (poscn, coord); 
+            rejilla_tablero.localizaCeldaTabla (poscn, coord); 
             if (coord != Coord {0, 0}) { 
                 if (dclic) {
+                    juego->grabacion ().anota (GrabacionPartida::Suceso::celdaSeleccionada, IndiceCelda {coord}.valor ());
                     juego->sucesos ()->celdaSeleccionada (coord);
                 } else if (sclic) {
+                    juego->grabacion ().anota (GrabacionPartida::Suceso::celdaPulsada, IndiceCelda {coord}.valor ());
                     juego->sucesos ()->celdaPulsada (coord);
                 }
             }
@@ -477,6 +500,7 @@ namespace tapete {
         if (sclic) {
             Vector separa {unir2d::Raton::posicion () - PresenciaTablero::centro_ayuda};  
             if (unir2d::norma (separa) < PresenciaTablero::radio_ayuda) {
+                juego->grabacion ().anota (GrabacionPartida::Suceso::ayudaSeleccionada);
                 juego->sucesos ()->ayudaSeleccionada ();
             }
         }
@@ -33,6 +33,8 @@ namespace tapete {
         void situaMuros (const GraficoMuros & grafico_muros);
         void validaGraficoMuros ();
 
+        OcupacionTablero  & ocupacion ();
+        const RayosVision & rayosVision () const;
         RejillaTablero    & rejilla ();
         PresenciaActuante & presencia (LadoTablero lado);
         CuadroIndica      & indicador ();
@@ -84,6 +86,8 @@ namespace tapete {
 
         const GraficoMuros * grafico_muros;
         std::vector <Coord>  sitios_muros {};
+        OcupacionTablero     ocupacion_tablero {};
+        RayosVision          rayos_vision {};
 
         PresenciaTablero     presencia_tablero        {this};
         RejillaTablero       rejilla_tablero          {this};
@@ -0,0 +1,111 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   AlcanceDesplaza.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    void AlcanceDesplaza::calcula (
+            JuegoMesaBase *             juego, 
+            const std::vector <Coord> & etapas_camino, 
+            int                         puntos_disponibles ) {
+        assert (etapas_camino.size () > 0);
+        this->origen             = etapas_camino.back ();
+        this->cuenta_etapas      = etapas_camino.size ();
+        this->puntos_disponibles = puntos_disponibles;
+        puntos_celdas.rellena (inalcanzable);
+        //
+        float previa = CalculoCaminos::longitudCamino (etapas_camino);
+        float limite = CalculoCaminos::limiteLongitud (juego, puntos_disponibles) - previa;
+        //
+        // relleno por anchura desde el origen, limitado al círculo de las celdas que se pueden pagar
+        //
+        ConjuntoCeldas visitada {};
+        std::vector <Coord> pendientes {};
+        pendientes.reserve (IndiceCelda::cuenta);
+        pendientes.push_back (origen);
+        visitada.set (IndiceCelda {origen}.valor ());
+        for (int indc_pendt = 0; indc_pendt < pendientes.size (); ++ indc_pendt) {
+            Coord celda_sale = pendientes [indc_pendt];
+            for (int direccion = 0; direccion < GeometriaHexagonal::direcciones; ++ direccion) {
+                Coord celda = GeometriaHexagonal::vecina (celda_sale, direccion);
+                if (! CalculoCaminos::celdaEnTablero (celda)) {
+                    continue;
+                }
+                IndiceCelda indice {celda};
+                if (! indice.valido () || visitada.test (indice.valor ())) {
+                    continue;
+                }
+                visitada.set (indice.valor ());
+                float longitud = CalculoCaminos::longitudSegmento (origen, celda);
+                if (longitud >= limite) {
+                    continue;
+                }
+                pendientes.push_back (celda);
+                //
+                if (CalculoCaminos::celdaOcupada (juego, celda)) {
+                    continue;
+                }
+                if (! CalculoCaminos::segmentoValido (juego, origen, celda)) {
+                    continue;
+                }
+                int punts = CalculoCaminos::puntosLongitud (juego, previa + longitud);
+                if (punts > puntos_disponibles) {
+                    continue;
+                }
+                puntos_celdas [indice] = punts;
+            }
+        }
+        vigente_ = true;
+    }
+
+
+    void AlcanceDesplaza::invalida () {
+        vigente_ = false;
+    }
+
+
+    bool AlcanceDesplaza::vigente (
+            const std::vector <Coord> & etapas_camino, int puntos_disponibles) const {
+        if (! vigente_ || etapas_camino.size () == 0) {
+            return false;
+        }
+        return etapas_camino.back () == origen             &&
+               etapas_camino.size () == cuenta_etapas      &&
+               puntos_disponibles    == this->puntos_disponibles;
+    }
+
+
+    int AlcanceDesplaza::puntos (Coord celda) const {
+        IndiceCelda indice {celda};
+        if (! vigente_ || ! indice.valido ()) {
+            return inalcanzable;
+        }
+        return puntos_celdas [indice];
+    }
+
+
+    const AlcanceDesplaza::PuntosCeldas & AlcanceDesplaza::puntosCeldas () const {
+        return puntos_celdas;
+    }
+
+
+    void AlcanceDesplaza::celdasAlcanzables (std::vector <Coord> & celdas) const {
+        celdas.clear ();
+        if (! vigente_) {
+            return;
+        }
+        for (int valor = 0; valor < IndiceCelda::cuenta; ++ valor) {
+            IndiceCelda indice {valor};
+            if (puntos_celdas [indice] != inalcanzable) {
+                celdas.push_back (indice.celda ());
+            }
+        }
+    }
+
+
+}
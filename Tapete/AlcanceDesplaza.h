@@ -0,0 +1,53 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  AlcanceDesplaza.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    class JuegoMesaBase;
+
+
+    // Puntos de acción que cuesta cada celda como próxima etapa del camino en curso, calculados de 
+    // una vez para todo el tablero: la celda debe estar libre, el segmento desde la última etapa 
+    // debe ser válido ('CalculoCaminos::segmentoValido') y el coste del camino completo 
+    // ('CalculoCaminos::puntosLongitud') no debe superar los puntos disponibles.
+    class AlcanceDesplaza {
+    public:
+
+        static constexpr int inalcanzable = -1;
+
+        using PuntosCeldas = TablaCeldas <int>;
+
+
+        void calcula (
+                JuegoMesaBase *             juego, 
+                const std::vector <Coord> & etapas_camino, 
+                int                         puntos_disponibles );
+        void invalida ();
+
+        bool vigente (const std::vector <Coord> & etapas_camino, int puntos_disponibles) const;
+
+        // 'inalcanzable' si la celda no puede ser la próxima etapa
+        int puntos (Coord celda) const;
+        const PuntosCeldas & puntosCeldas () const;
+
+        void celdasAlcanzables (std::vector <Coord> & celdas) const;
+
+    private:
+
+        bool   vigente_ {};
+        Coord  origen {};
+        size_t cuenta_etapas {};
+        int    puntos_disponibles {};
+
+        PuntosCeldas puntos_celdas {};
+
+    };
+
+
+}
@@ -47,49 +47,6 @@ namespace tapete {
 ****************************************************************************/
 
 
-/****************************************************************************
-
-    Cálculo de la posición de cada celda destino en relación con la celda origen.
-
-      +-----+         +-----+         +-----+         +-----+         +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   6 C   +-----+   1 E   +-----+   1 C   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   6 C   +-----+   6 C   +-----+   1 C   +-----+   1 C   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   6 C   +-----+   1 E   +-----+   1 C   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   6 E   +-----+   6 C   +-----+   1 C   +-----+   2 E   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   6 E   +-----+   1 E   +-----+   2 E   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   5 C   +-----+   6 E   +-----+   2 E   +-----+   2 C   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   5 C   +-----+    O    +-----+   2 C   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   5 C   +-----+   5 E   +-----+   3 E   +-----+   2 C   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   5 E   +-----+   4 E   +-----+   3 E   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   5 E   +-----+   4 C   +-----+   3 C   +-----+   3 E   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   4 C   +-----+   4 E   +-----+   3 C   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+   4 C   +-----+   4 C   +-----+   3 C   +-----+   3 C   +-----+  
-     /       \       /       \       /       \       /       \       /       \ 
-    +         +-----+   4 C   +-----+   4 E   +-----+   3 C   +-----+         +
-     \       /       \       /       \       /       \       /       \       / 
-      +-----+         +-----+         +-----+         +-----+         +-----+  
-
-    O   : celda origen
-    1 E : dirección exacta 1
-        · · · · · 
-    6 E : dirección exacta 6
-    1 C : dirección cuadrante 1
-        · · · · · 
-    6 C : dirección cuadrante 6
-
-****************************************************************************/
 
 
     bool CalculoCaminos::celdaEnTablero (Coord celda) {
@@ -126,55 +83,13 @@ namespace tapete {
 
 
     bool CalculoCaminos::celdaEnMuro (JuegoMesaBase * juego, Coord celda) {
-        for (const Coord & coord : juego->tablero ()->sitiosMuros ()) {
-            if (coord == celda) {
-                return true;
-            }
-        }
-        return false;
+        return juego->tablero ()->ocupacion ().enCapa (CapaOcupacion::muros, celda);
     }
 
 
     bool CalculoCaminos::celdaOcupada (JuegoMesaBase * juego, Coord celda) {
-        for (const ActorPersonaje * persj : juego->personajes ()) {
-            if (persj->sitioFicha () == celda) {
-                return true;
-            }
-        }
-        for (const Coord & coord : juego->tablero ()->sitiosMuros ()) {
-            if (coord == celda) {
-                return true;
-            }
-        }
-        for (const Coord & coord : juego->modo ()->etapasCamino ()) {
-            if (coord == celda) {
-                return true;
-            }
-        }
-        return false;
-    }
-
-
-    bool CalculoCaminos::etapaValidaCamino (JuegoMesaBase * juego, Coord celda_destino_etapa) {
-        aserta (juego->modo ()->etapasCamino ().size () >= 1, "camino no iniciado");
-        Coord celda_origen_etapa = juego->modo ()->etapasCamino ().back ();
-        aserta (celda_origen_etapa != celda_destino_etapa, "etapa del camino nula");
-        //
-        int direccion_exacta;
-        int direccion_cuadrante;
-        calculoDireccion (
-                celda_origen_etapa, celda_destino_etapa, 
-                direccion_exacta, direccion_cuadrante   );
-        if (direccion_exacta != 0) {
-            return etapaValidaCaminoExacto (
-                    juego, 
-                    celda_origen_etapa, celda_destino_etapa, 
-                    direccion_exacta                        );
-        }
-        return etapaValidaCaminoCuadrante (
-                juego, 
-                celda_origen_etapa, celda_destino_etapa, 
-                direccion_cuadrante                     );
+        // muros, fichas de los personajes y etapas del camino en curso
+        return juego->tablero ()->ocupacion ().ocupada (celda);
     }
 
 
@@ -182,249 +97,27 @@ namespace tapete {
             JuegoMesaBase * juego, Coord celda_origen, Coord celda_destino) {
         aserta (celda_origen != celda_destino, "segmento de camino nulo");
         //
-        int direccion_exacta;
-        int direccion_cuadrante;
-        calculoDireccion (
-                celda_origen, celda_destino, 
-                direccion_exacta, direccion_cuadrante);
-        if (direccion_exacta != 0) {
-            return etapaValidaCaminoExacto (
-                    juego, 
-                    celda_origen, celda_destino, 
-                    direccion_exacta            );
-        }
-        return etapaValidaCaminoCuadrante (
-                juego, 
-                celda_origen, celda_destino, 
-                direccion_cuadrante         );
-    }
-
-
-    void CalculoCaminos::calculoDireccion (
-            Coord celda_origen_etapa, Coord celda_destino_etapa,
-            int & direccion_exacta,   int & direccion_cuadrante ) { 
-        direccion_exacta    = 0;
-        direccion_cuadrante = 0;
-        int filas = celda_destino_etapa.fila () - celda_origen_etapa.fila ();
-        int colns = celda_destino_etapa.coln () - celda_origen_etapa.coln ();
-        if (filas == 0) {
-            if (colns > 0) {
-                direccion_cuadrante = 2;
-            } else {
-                direccion_cuadrante = 5;
-            }
-        } else if (colns == 0) {
-            if (filas > 0) {
-                direccion_exacta = 4;
-            } else {
-                direccion_exacta = 1;
-            }
-        } else if (filas > 0 && colns > 0) {
-            if (filas == colns) {
-                direccion_exacta = 3;
-            } else if (filas < colns) {
-                direccion_cuadrante = 2;
-            } else {
-                direccion_cuadrante = 3;
-            }
-        } else if (filas > 0 && colns < 0) {
-            if (filas == -colns) {
-                direccion_exacta = 5;
-            } else if (filas < -colns) {
-                direccion_cuadrante = 5;
-            } else {
-                direccion_cuadrante = 4;
-            }
-        } else if (filas < 0 && colns > 0) {
-            if (-filas == colns) {
-                direccion_exacta = 2;
-            } else if (-filas < colns) {
-                direccion_cuadrante = 2;
-            } else {
-                direccion_cuadrante = 1;
-            }
-        } else if (filas < 0 && colns < 0) {
-            if (-filas == -colns) {
-                direccion_exacta = 6;
-            } else if (-filas < -colns) {
-                direccion_cuadrante = 5;
-            } else {
-                direccion_cuadrante = 6;
-            }
-        }
-    }
-
-
-    bool CalculoCaminos::etapaValidaCaminoExacto (
-            JuegoMesaBase * juego, 
-            Coord celda_origen_etapa, Coord celda_destino_etapa, 
-            int direccion_exacta                                ) {
-        Coord celda_sale = celda_origen_etapa;
-        while (true) {
-            Coord celda_llega;
-            celdaProximaCaminoExacto (celda_sale, direccion_exacta, celda_llega);
-            if (celda_llega == celda_destino_etapa) {
-                return true;
-            }
-            if (! celdaEnTablero (celda_llega)) {
-                return false;
-            }
-            if (celdaOcupada (juego, celda_llega)) {
-                return false;
-            }
-            celda_sale = celda_llega;
-        }
-    }
-
-
-    void CalculoCaminos::celdaProximaCaminoExacto (
-                Coord celda_sale, int direccion_exacta,
-                Coord & celda_llega                    ) {
-        switch (direccion_exacta) {
-        case 1:
-            celda_llega = Coord {celda_sale.fila () - 2, celda_sale.coln ()    };
-            break;
-        case 2:
-            celda_llega = Coord {celda_sale.fila () - 1, celda_sale.coln () + 1};
-            break;
-        case 3:
-            celda_llega = Coord {celda_sale.fila () + 1, celda_sale.coln () + 1};
-            break;
-        case 4:
-            celda_llega = Coord {celda_sale.fila () + 2, celda_sale.coln ()    };
-            break;
-        case 5:
-            celda_llega = Coord {celda_sale.fila () + 1, celda_sale.coln () - 1};
-            break;
-        case 6:
-            celda_llega = Coord {celda_sale.fila () - 1, celda_sale.coln () - 1};
-            break;
+        bool libre;
+        if (segmentoLibreRayos (juego, celda_origen, celda_destino, libre)) {
+            return libre;
         }
-    }
-
-
-    bool CalculoCaminos::etapaValidaCaminoCuadrante (
-            JuegoMesaBase * juego, 
-            Coord celda_origen_etapa, Coord celda_destino_etapa, 
-            int direccion_cuadrante                             ) {
-        Vector vector_origen  = RejillaTablero::centroHexagono (celda_origen_etapa);
-        Vector vector_destino = RejillaTablero::centroHexagono (celda_destino_etapa);
-        EcuacionRecta recta_etapa;
-        calculaRecta (vector_destino - vector_origen, vector_origen, recta_etapa);
-        //
-        Coord celda_sale = celda_origen_etapa;
-        while (true) {
-            Coord celda_llega;
-            celdaProximaCaminoCuadrante (celda_sale, direccion_cuadrante, recta_etapa, celda_llega);
-            if (celda_llega == celda_destino_etapa) {
-                return true;
-            }
-            if (! celdaEnTablero (celda_llega)) {
-                return false;
-            }
-            if (celdaOcupada (juego, celda_llega)) {
-                return false;
-            }
-            celda_sale = celda_llega;
-        }
-        return true;
-    }
-
-
-    void CalculoCaminos::celdaProximaCaminoCuadrante (
-            Coord celda_sale, int direccion_cuadrante,
-            const EcuacionRecta & recta_etapa, Coord & celda_llega) {
-        std::array <Coord, 2> celda_proxm {};
-/****************************************************************************
-              +-----+          
-             /       \         
-      +-----+   1 6   +-----+  
-     /       \       /       \ 
-    +   5 6   +-----+   1 2   +
-     \       /       \       / 
-      +-----+    *    +-----+  
-     /       \       /       \ 
-    +   4 5   +-----+   2 3   +
-     \       /       \       / 
-      +-----+   3 4   +-----+  
-             \       /         
-              +-----+          
-****************************************************************************/
-        switch (direccion_cuadrante) {
-        case 1:
-            celda_proxm [0] = Coord {celda_sale.fila () - 2, celda_sale.coln ()    };
-            celda_proxm [1] = Coord {celda_sale.fila () - 1, celda_sale.coln () + 1};
-            break;
-        case 2:
-            celda_proxm [0] = Coord {celda_sale.fila () - 1, celda_sale.coln () + 1};
-            celda_proxm [1] = Coord {celda_sale.fila () + 1, celda_sale.coln () + 1};
-            break;
-        case 3:
-            celda_proxm [0] = Coord {celda_sale.fila () + 1, celda_sale.coln () + 1};
-            celda_proxm [1] = Coord {celda_sale.fila () + 2, celda_sale.coln ()    };
-            break;
-        case 4:
-            celda_proxm [0] = Coord {celda_sale.fila () + 2, celda_sale.coln ()    };
-            celda_proxm [1] = Coord {celda_sale.fila () + 1, celda_sale.coln () - 1};
-            break;
-
-        case 5:
-            celda_proxm [0] = Coord {celda_sale.fila () + 1, celda_sale.coln () - 1};
-            celda_proxm [1] = Coord {celda_sale.fila () - 1, celda_sale.coln () - 1};
-            break;
-        case 6:
-            celda_proxm [0] = Coord {celda_sale.fila () - 1, celda_sale.coln () - 1};
-            celda_proxm [1] = Coord {celda_sale.fila () - 2, celda_sale.coln ()    };
-            break;
-        }
-        //
-        // anula las celdas próximas que no están en el tablero
-        for (int indc = 0; indc < celda_proxm.size (); ++ indc) {
-            if (! celdaEnTablero (celda_proxm [indc])) {
-                celda_proxm [indc] = Coord {0, 0};
-            }
-        }
-        //
-        // ¿puede ser que se anulen las dos?
-        //
-        if (celda_proxm [0] == Coord {0, 0}) {
-            celda_llega = celda_proxm [1];
-            return;
-        }
-        if (celda_proxm [1] == Coord {0, 0}) {
-            celda_llega = celda_proxm [0];
-            return;
-        }
-        //
-        std::array <float, 2> distn_proxm {};
-        for (int indc = 0; indc < celda_proxm.size (); ++ indc) {
-            Vector punto = RejillaTablero::centroHexagono (celda_proxm [indc]);
-            distn_proxm [indc] = distancia (recta_etapa, punto);
-        }
-        //
-        if (distn_proxm [0] < distn_proxm [1]) {
-            celda_llega = celda_proxm [0];
-        } else {
-            celda_llega = celda_proxm [1];
+        // el recorrido de las reglas, que solo numera las celdas del tablero
+        if (! celdaEnTablero (celda_origen) || ! celdaEnTablero (celda_destino)) {
+            return false;
         }
-    }
-
-        
-    void CalculoCaminos::calculaRecta (
-            Vector vector_director, Vector punto_recta,
-            CalculoCaminos::EcuacionRecta & recta      ) {
-        // a = vy   b = -vx   c = -a·px-b·py
-        recta.a =   vector_director.y ();
-        recta.b = - vector_director.x ();
-        recta.c = - recta.a * punto_recta.x () - recta.b * punto_recta.y ();
-        // d = √(a² + b²)    raiz cuadrada                  
-        recta.d = std::sqrtf (recta.a * recta.a + recta.b * recta.b);
+        return reglas::TableroReglas::segmentoLibre (
+                juego->tablero ()->ocupacion ().ocupadas (), 
+                ConversionReglas::celdaReglas (celda_origen), 
+                ConversionReglas::celdaReglas (celda_destino) );
     }
 
 
-    float CalculoCaminos::distancia (const EcuacionRecta & recta, Vector punto) {
-        // distancia = |a·px+b·py+c|/√(a²+b²) 
-        return std::fabsf (recta.a * punto.x () + recta.b * punto.y () + recta.c) / recta.d;
+    bool CalculoCaminos::segmentoLibreRayos (
+            JuegoMesaBase * juego, Coord celda_origen, Coord celda_destino, bool & libre) {
+        // los rayos precalculados, si los hay; si no, hay que recorrer el segmento
+        return juego->tablero ()->rayosVision ().segmentoLibre (
+                juego->tablero ()->ocupacion ().ocupadas (), 
+                celda_origen, celda_destino, libre              );
     }
 
 
@@ -471,34 +164,150 @@ namespace tapete {
         // 
         area_celdas.resize (radio_area + 1u);
         area_celdas [0].push_back (celda_central);
+        std::vector <Coord> anillo {};
         for (int indc_radio = 1; indc_radio <= radio_area; ++ indc_radio) {
-            agregaLadoArea (juego, celda_central, indc_radio, Coord { -2,  0}, Coord { 1,  1}, area_celdas);
-            agregaLadoArea (juego, celda_central, indc_radio, Coord { -1,  1}, Coord { 2,  0}, area_celdas);
-            agregaLadoArea (juego, celda_central, indc_radio, Coord {  1,  1}, Coord { 1, -1}, area_celdas);
-            agregaLadoArea (juego, celda_central, indc_radio, Coord {  2,  0}, Coord {-1, -1}, area_celdas);
-            agregaLadoArea (juego, celda_central, indc_radio, Coord {  1, -1}, Coord {-2,  0}, area_celdas);
-            agregaLadoArea (juego, celda_central, indc_radio, Coord { -1, -1}, Coord {-1,  1}, area_celdas);
+            GeometriaHexagonal::anillo (celda_central, indc_radio, anillo);
+            for (const Coord & celda : anillo) {
+                if (celdaEnTablero (celda) && ! celdaEnMuro (juego, celda)) {
+                    area_celdas [indc_radio].push_back (celda);
+                }
+            }
         }
     }
 
 
-    void CalculoCaminos::agregaLadoArea (
-            JuegoMesaBase *      juego, 
-            Coord                celda_central, 
-            int                  indice_radio, 
-            Coord                origen_lado, 
-            Coord                director_lado, 
-            AreaCentradaCeldas & area_celdas   ) {
-        Coord celda = celda_central + indice_radio * origen_lado;
-        if (celdaEnTablero (celda) && ! celdaEnMuro (juego, celda)) {
-            area_celdas [indice_radio].push_back (celda);
+    bool CalculoCaminos::caminoOptimo (
+            JuegoMesaBase *             juego, 
+            const std::vector <Coord> & etapas_camino, 
+            Coord                       destino, 
+            int                         presupuesto,
+            std::vector <Coord> &       etapas,
+            int &                       puntos_camino ) {
+        aserta (etapas_camino.size () > 0, "camino sin origen");
+        Coord origen = etapas_camino.back ();
+        aserta (origen != destino, "camino nulo");
+        etapas.clear ();
+        puntos_camino = 0;
+        //
+        // descartes inmediatos
+        //
+        if (! celdaEnTablero (destino) || ! IndiceCelda {destino}.valido () || celdaOcupada (juego, destino)) {
+            return false;
+        }
+        float previa = longitudCamino (etapas_camino);
+        float limite = limiteLongitud (juego, presupuesto) - previa;
+        if (longitudSegmento (origen, destino) >= limite) {
+            return false;
         }
-        for (int indc = 2; indc <= indice_radio; ++ indc) {
-            celda += director_lado;
-            if (celdaEnTablero (celda) && ! celdaEnMuro (juego, celda)) {
-                area_celdas [indice_radio].push_back (celda);
+        //
+        // A* sobre las celdas, con atajos rectos hacia el padre del padre (Theta*); así las etapas 
+        // son segmentos rectos y el coste es la longitud euclídea, como en 'longitudCamino'
+        //
+        TablaCeldas <float>       coste;
+        TablaCeldas <IndiceCelda> padre;
+        ConjuntoCeldas            cerrada {};
+        coste.rellena (std::numeric_limits <float>::infinity ());
+        padre.rellena (IndiceCelda {});
+        //
+        using Abierta = std::pair <float, int>;
+        std::priority_queue <Abierta, std::vector <Abierta>, std::greater <Abierta>> abiertas {};
+        //
+        IndiceCelda indc_origen  {origen};
+        IndiceCelda indc_destino {destino};
+        aserta (indc_origen.valido (), "origen del camino inválido");
+        coste [indc_origen] = 0.0f;
+        padre [indc_origen] = indc_origen;
+        abiertas.push (Abierta {longitudSegmento (origen, destino), indc_origen.valor ()});
+        while (! abiertas.empty ()) {
+            IndiceCelda indc_sale {abiertas.top ().second};
+            abiertas.pop ();
+            if (cerrada.test (indc_sale.valor ())) {
+                continue;
+            }
+            cerrada.set (indc_sale.valor ());
+            if (indc_sale == indc_destino) {
+                break;
             }
+            Coord       celda_sale  = indc_sale.celda ();
+            IndiceCelda indc_padre  = padre [indc_sale];
+            Coord       celda_padre = indc_padre.celda ();
+            for (int direccion = 0; direccion < GeometriaHexagonal::direcciones; ++ direccion) {
+                Coord celda_llega = GeometriaHexagonal::vecina (celda_sale, direccion);
+                if (! celdaEnTablero (celda_llega) || celdaOcupada (juego, celda_llega)) {
+                    continue;
+                }
+                IndiceCelda indc_llega {celda_llega};
+                if (cerrada.test (indc_llega.valor ())) {
+                    continue;
+                }
+                float       coste_llega;
+                IndiceCelda padre_llega;
+                if (indc_padre != indc_sale && segmentoValido (juego, celda_padre, celda_llega)) {
+                    coste_llega = coste [indc_padre] + longitudSegmento (celda_padre, celda_llega);
+                    padre_llega = indc_padre;
+                } else {
+                    coste_llega = coste [indc_sale] + longitudSegmento (celda_sale, celda_llega);
+                    padre_llega = indc_sale;
+                }
+                if (coste_llega >= coste [indc_llega]) {
+                    continue;
+                }
+                float estimado = coste_llega + longitudSegmento (celda_llega, destino);
+                if (estimado >= limite) {
+                    continue;
+                }
+                coste [indc_llega] = coste_llega;
+                padre [indc_llega] = padre_llega;
+                abiertas.push (Abierta {estimado, indc_llega.valor ()});
+            }
+        }
+        if (! cerrada.test (indc_destino.valor ())) {
+            return false;
+        }
+        //
+        // las etapas se recogen del destino al origen
+        //
+        for (IndiceCelda indc = indc_destino; indc != indc_origen; indc = padre [indc]) {
+            etapas.push_back (indc.celda ());
         }
+        std::reverse (etapas.begin (), etapas.end ());
+        //
+        std::vector <Coord> camino = etapas_camino;
+        camino.insert (camino.end (), etapas.begin (), etapas.end ());
+        puntos_camino = puntosLongitud (juego, longitudCamino (camino));
+        if (puntos_camino > presupuesto) {
+            etapas.clear ();
+            puntos_camino = 0;
+            return false;
+        }
+        return true;
+    }
+
+
+    float CalculoCaminos::longitudSegmento (Coord celda_origen, Coord celda_destino) {
+        return unir2d::norma (
+                RejillaTablero::centroHexagono (celda_destino) -
+                RejillaTablero::centroHexagono (celda_origen)   );
+    }
+
+
+    float CalculoCaminos::longitudCamino (const std::vector <Coord> & etapas_camino) {
+        float longitud = 0.0f;
+        for (size_t indc = 1; indc < etapas_camino.size (); ++ indc) {
+            longitud += longitudSegmento (etapas_camino [indc - 1], etapas_camino [indc]);
+        }
+        return longitud;
+    }
+
+
+    int CalculoCaminos::puntosLongitud (JuegoMesaBase * juego, float longitud) {
+        return static_cast <int> (std::round (longitud / juego->modo ()->puntosAccionDeDesplaza ()));
+    }
+
+
+    float CalculoCaminos::limiteLongitud (JuegoMesaBase * juego, int puntos) {
+        // round (longitud / desplaza) <= puntos  <=>  longitud < (puntos + 0.5) · desplaza
+        return (puntos + 0.5f) * juego->modo ()->puntosAccionDeDesplaza ();
     }
 
 
@@ -29,8 +29,16 @@ namespace tapete {
         static bool celdaEnMuro    (JuegoMesaBase * juego, Coord celda);
         static bool celdaOcupada   (JuegoMesaBase * juego, Coord celda);
 
-        static bool etapaValidaCamino (JuegoMesaBase * juego, Coord celda_destino_etapa);
-        static bool segmentoValido    (JuegoMesaBase * juego, Coord celda_origen, Coord celda_destino);
+        static bool segmentoValido (JuegoMesaBase * juego, Coord celda_origen, Coord celda_destino);
+
+        // El coste de un camino en puntos de acción: la suma de las longitudes de sus etapas, en 
+        // orden, dividida entre los puntos de acción de desplazamiento y redondeada. Un camino que 
+        // se prolonga suma las etapas nuevas a la longitud de las fijadas, con el mismo redondeo.
+        static float longitudSegmento (Coord celda_origen, Coord celda_destino);
+        static float longitudCamino   (const std::vector <Coord> & etapas_camino);
+        static int   puntosLongitud   (JuegoMesaBase * juego, float longitud);
+        // las longitudes menores que esta cuestan como mucho 'puntos'
+        static float limiteLongitud   (JuegoMesaBase * juego, int puntos);
 
         static void areaCeldas (
                 JuegoMesaBase *      juego, 
@@ -38,46 +46,23 @@ namespace tapete {
                 int                  radio_area, 
                 AreaCentradaCeldas & area_celdas    );
 
+        // Busca (A*) el camino más barato que prolonga 'etapas_camino' desde su última etapa hasta 
+        // 'destino' con etapas rectas que 'segmentoValido' admite. El coste es el de 
+        // 'puntosLongitud' para el camino completo, etapas ya fijadas incluidas.
+        // Las etapas nuevas terminan en el destino. Devuelve falso si el destino no se alcanza sin 
+        // superar el presupuesto de puntos de acción.
+        static bool caminoOptimo (
+                JuegoMesaBase *             juego, 
+                const std::vector <Coord> & etapas_camino, 
+                Coord                       destino, 
+                int                         presupuesto,
+                std::vector <Coord> &       etapas,
+                int &                       puntos_camino );
+
     private:
 
-        struct EcuacionRecta {
-            // a·x+b·y+c = 0
-            float a;
-            float b;
-            float c;
-            // d = √(a²+b²)    raiz cuadrada
-            float d;
-        };
-
-        static void calculoDireccion (
-                Coord celda_origen_etapa, Coord celda_destino_etapa,
-                int & direccion_exacta, int & direccion_cuadrante   );
-
-        static bool etapaValidaCaminoExacto (
-                JuegoMesaBase * juego, 
-                Coord celda_origen_etapa, Coord celda_destino_etapa, 
-                int direccion_exacta                                );
-        static void celdaProximaCaminoExacto (
-                Coord celda_sale, int direccion_exacta,
-                Coord & celda_llega                    );
-        static bool etapaValidaCaminoCuadrante (
-                JuegoMesaBase * juego, 
-                Coord celda_origen_etapa, Coord celda_destino_etapa, 
-                int direccion_cuadrante                             );
-        static void celdaProximaCaminoCuadrante (
-                Coord celda_sale, int direccion_cuadrante,
-                const EcuacionRecta & recta_etapa, Coord & celda_llega);
-
-        static void calculaRecta (
-                Vector vector_director, Vector punto_recta,
-                CalculoCaminos::EcuacionRecta & recta      );
-        static float distancia (const EcuacionRecta & recta, Vector punto);
-
-        static void agregaLadoArea (
-                JuegoMesaBase * juego, 
-                Coord celda_central, int radio_lado, 
-                Coord origen_lado, Coord director_lado, 
-                AreaCentradaCeldas & area_celdas       );
+        static bool segmentoLibreRayos (
+                JuegoMesaBase * juego, Coord celda_origen, Coord celda_destino, bool & libre);
 
         static void aserta (bool expresion, const string & mensaje);
 
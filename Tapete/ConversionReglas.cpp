@@ -0,0 +1,199 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   ConversionReglas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    void ConversionReglas::extraeReglas (JuegoMesaBase * juego, reglas::ReglasPartida & reglas_partida) {
+        reglas_partida = reglas::ReglasPartida {};
+        //
+        for (Habilidad * habld : juego->habilidades ()) {
+            reglas::ReglasPartida::Habilidad habilidad {};
+            habilidad.enfoque        = habld->tipoEnfoque ();
+            habilidad.acceso         = habld->tipoAcceso ();
+            habilidad.antagonista    = habld->antagonista ();
+            habilidad.coste          = habld->coste ();
+            habilidad.alcance        = habld->alcance ();
+            habilidad.radio_alcance  = habld->radioAlcance ();
+            habilidad.valor_dano     = habld->valorDano ();
+            habilidad.valor_curacion = habld->valorCuracion ();
+            if (habld->tipoAtaque () != nullptr) {
+                habilidad.tipo_ataque = habld->tipoAtaque ()->indice ();
+            }
+            if (habld->tipoDefensa () != nullptr) {
+                habilidad.tipo_defensa = habld->tipoDefensa ()->indice ();
+            }
+            if (habld->tipoDano () != nullptr) {
+                habilidad.tipo_dano = habld->tipoDano ()->indice ();
+            }
+            for (const std::pair <TipoAtaque *, int> & efecto : habld->efectosAtaque ()) {
+                habilidad.efectos_ataque.push_back ({ efecto.first->indice (), efecto.second });
+            }
+            for (const std::pair <TipoDefensa *, int> & efecto : habld->efectosDefensa ()) {
+                habilidad.efectos_defensa.push_back ({ efecto.first->indice (), efecto.second });
+            }
+            reglas_partida.agregaHabilidad (habilidad);
+        }
+        //
+        for (ActorPersonaje * persj : juego->personajes ()) {
+            reglas::ReglasPartida::Personaje personaje {};
+            personaje.lado       = persj->ladoTablero ();
+            personaje.iniciativa = persj->iniciativa ();
+            // los valores de cambio son nulos antes de empezar la partida
+            for (TipoAtaque * tipo : juego->ataques ()) {
+                if (persj->apareceAtaque (tipo)) {
+                    personaje.ataque [tipo->indice ()] = persj->valorAtaque (tipo);
+                    personaje.aparece_ataque.set (tipo->indice ());
+                }
+            }
+            for (TipoDefensa * tipo : juego->defensas ()) {
+                if (persj->apareceDefensa (tipo)) {
+                    personaje.defensa [tipo->indice ()] = persj->valorDefensa (tipo);
+                    personaje.aparece_defensa.set (tipo->indice ());
+                }
+            }
+            for (TipoDano * tipo : juego->danos ()) {
+                if (persj->apareceReduceDano (tipo)) {
+                    personaje.reduce_dano [tipo->indice ()] = persj->valorReduceDano (tipo);
+                    personaje.aparece_reduce_dano.set (tipo->indice ());
+                }
+            }
+            for (Habilidad * habld : persj->habilidades ()) {
+                personaje.habilidades.push_back (habld->indice ());
+            }
+            reglas_partida.agregaPersonaje (personaje);
+        }
+        //
+        for (GradoEfectividad * efectividad : juego->sistemaAtaque ().efectividades ()) {
+            reglas_partida.agregaEfectividad (efectividad->valorSuperioAtaque (), efectividad->porcentajeDano ());
+        }
+        const OcupacionTablero::CapaCeldas & muros = 
+                juego->tablero ()->ocupacion ().celdas (CapaOcupacion::muros);
+        for (int celda = 0; celda < IndiceCelda::cuenta; ++ celda) {
+            if (muros.test (celda)) {
+                reglas_partida.agregaMuro (celda);
+            }
+        }
+        reglas_partida.ponPuntosAccionDeDesplaza (juego->modo ()->puntosAccionDeDesplaza ());
+        reglas_partida.compila ();
+    }
+
+
+    void ConversionReglas::extraeEstado (JuegoMesaBase * juego, reglas::EstadoPartida & estado) {
+        const reglas::ReglasPartida & reglas_partida = juego->reglasPartida ();
+        estado = reglas::EstadoPartida {};
+        estado.cuenta_personajes = static_cast <int8_t> (juego->personajes ().size ());
+        for (int indc = 0; indc < juego->personajes ().size (); ++ indc) {
+            ActorPersonaje * persj = juego->personajes () [indc];
+            const reglas::ReglasPartida::Personaje & personaje = reglas_partida.personaje (indc);
+            reglas::EstadoPersonaje & persnj_estado = estado.personajes [indc];
+            persnj_estado.celda         = static_cast <int16_t> (celdaReglas (persj->sitioFicha ()));
+            persnj_estado.vitalidad     = static_cast <int16_t> (persj->vitalidad ());
+            persnj_estado.puntos_accion = static_cast <int16_t> (persj->puntosAccion ());
+            for (TipoAtaque * tipo : juego->ataques ()) {
+                if (personaje.aparece_ataque.test (tipo->indice ())) {
+                    persnj_estado.cambio_ataque [tipo->indice ()] = static_cast <int16_t> (
+                            persj->valorAtaque (tipo) - personaje.ataque [tipo->indice ()]);
+                }
+            }
+            for (TipoDefensa * tipo : juego->defensas ()) {
+                if (personaje.aparece_defensa.test (tipo->indice ())) {
+                    persnj_estado.cambio_defensa [tipo->indice ()] = static_cast <int16_t> (
+                            persj->valorDefensa (tipo) - personaje.defensa [tipo->indice ()]);
+                }
+            }
+        }
+        //
+        ModoJuegoBase * modo = juego->modo ();
+        estado.ronda  = static_cast <int16_t> (modo->ronda ());
+        estado.turno  = static_cast <int16_t> (modo->turno ());
+        estado.jugada = static_cast <int16_t> (modo->jugada ());
+        for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+            ActorPersonaje * elegido = modo->personajeElegido (lado);
+            if (elegido != nullptr) {
+                estado.elegido [reglas::indiceLado (lado)] = static_cast <int8_t> (elegido->indice ());
+            }
+        }
+        if (modo->atacante () != nullptr) {
+            estado.atacante   = static_cast <int8_t> (modo->atacante ()->indice ());
+        }
+        if (dynamic_cast <ModoJuegoEquipo *> (modo) != nullptr) {
+            // nadie elige: el orden de 'factoresEquipos' es el de 'reglas::MotorReglas::buscaFactor'
+            estado.lado_actual = modo->ladoEquipoInicial ();
+            estado.factor      = static_cast <int8_t> (modo->indiceFactorEquipos ());
+            estado.lado_elige  = LadoTablero::nulo;
+        } else if (modo->atacante () != nullptr) {
+            estado.lado_elige = LadoTablero::nulo;
+        } else if (estado.elegido [0] != reglas::EstadoPartida::ninguno) {
+            estado.lado_elige = LadoTablero::Derecha;
+        } else {
+            // en el modo por parejas elige primero cualquiera de los dos lados
+            estado.lado_elige = LadoTablero::Izquierda;
+        }
+        estado.clave = reglas::ClaveZobrist::calcula (estado);
+    }
+
+
+    void ConversionReglas::vuelcaEstado (JuegoMesaBase * juego, const reglas::EstadoPartida & estado) {
+        const reglas::ReglasPartida & reglas_partida = juego->reglasPartida ();
+        for (int indc = 0; indc < juego->personajes ().size (); ++ indc) {
+            ActorPersonaje * persj = juego->personajes () [indc];
+            const reglas::ReglasPartida::Personaje & personaje = reglas_partida.personaje (indc);
+            const reglas::EstadoPersonaje & persnj_estado = estado.personajes [indc];
+            persj->ponSitioFicha (celdaTablero (persnj_estado.celda));
+            persj->ponVitalidad (persnj_estado.vitalidad);
+            persj->ponPuntosAccion (persnj_estado.puntos_accion);
+            persj->ponPuntosAccionEnJuego (0);
+            for (TipoAtaque * tipo : juego->ataques ()) {
+                if (personaje.aparece_ataque.test (tipo->indice ())) {
+                    persj->cambiaAtaque (tipo, persnj_estado.cambio_ataque [tipo->indice ()]);
+                }
+            }
+            for (TipoDefensa * tipo : juego->defensas ()) {
+                if (personaje.aparece_defensa.test (tipo->indice ())) {
+                    persj->cambiaDefensa (tipo, persnj_estado.cambio_defensa [tipo->indice ()]);
+                }
+            }
+        }
+        // los sitios se cambian de uno en uno, y un personaje puede llegar a una celda que otro aún 
+        // no ha dejado: la capa de las fichas se rehace después de moverlos a todos
+        OcupacionTablero & ocupacion = juego->tablero ()->ocupacion ();
+        ocupacion.vacia (CapaOcupacion::fichas);
+        for (ActorPersonaje * persj : juego->personajes ()) {
+            ocupacion.marca (CapaOcupacion::fichas, persj->sitioFicha ());
+        }
+    }
+
+
+    reglas::ModoReglas ConversionReglas::modoReglas (JuegoMesaBase * juego) {
+        if (dynamic_cast <ModoJuegoEquipo *> (juego->modo ()) != nullptr) {
+            return reglas::ModoReglas::equipo;
+        }
+        if (dynamic_cast <ModoJuegoLibreDoble *> (juego->modo ()) != nullptr) {
+            return reglas::ModoReglas::libreDoble;
+        }
+        return reglas::ModoReglas::pares;
+    }
+
+
+    int ConversionReglas::celdaReglas (Coord celda) {
+        // 'IndiceCelda' y 'reglas::TableroReglas' numeran las celdas igual
+        return IndiceCelda {celda}.valor ();
+    }
+
+
+    Coord ConversionReglas::celdaTablero (int celda) {
+        return IndiceCelda {celda}.celda ();
+    }
+
+
+    static_assert (IndiceCelda::cuenta == reglas::TableroReglas::cuentaCeldas);
+    static_assert (IndiceCelda {26, 14}.valor () == reglas::TableroReglas::celda (26, 14));
+
+
+}
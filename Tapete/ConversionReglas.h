@@ -0,0 +1,38 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  ConversionReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    class JuegoMesaBase;
+
+
+    // Paso de los objetos del juego a las reglas sin presentación ('reglas::ReglasPartida' y 
+    // 'reglas::EstadoPartida') y de las celdas de las reglas a las de la rejilla. Los personajes y 
+    // las habilidades conservan su índice en 'JuegoMesaBase'. 
+    // El estado es el del modo por parejas o el del modo por equipos: en el modo libre, solo valen
+    // los personajes.
+    class ConversionReglas {
+    public:
+
+        // con el juego ya validado y el tablero preparado
+        static void extraeReglas (JuegoMesaBase * juego, reglas::ReglasPartida & reglas_partida);
+        static void extraeEstado (JuegoMesaBase * juego, reglas::EstadoPartida & estado);
+        // lo inverso de 'extraeEstado', pero solo para los personajes
+        static void vuelcaEstado (JuegoMesaBase * juego, const reglas::EstadoPartida & estado);
+
+        // el de las reglas que corresponde al modo del juego
+        static reglas::ModoReglas modoReglas (JuegoMesaBase * juego);
+
+        static int   celdaReglas  (Coord celda);
+        static Coord celdaTablero (int celda);
+
+    };
+
+
+}
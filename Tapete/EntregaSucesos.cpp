@@ -0,0 +1,204 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   EntregaSucesos.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    using Suceso = GrabacionPartida::Suceso;
+
+
+    EntregaSucesos::EntregaSucesos (JuegoMesaBase * juego, bool resuelve_calculo) {
+        this->juego_            = juego;
+        this->resuelve_calculo_ = resuelve_calculo;
+    }
+
+
+    bool EntregaSucesos::esDecision (Suceso suceso) {
+        switch (suceso) {
+        case Suceso::final:
+        case Suceso::tirada:
+        case Suceso::ronda:
+        case Suceso::jugada:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+
+    bool EntregaSucesos::entrega (const GrabacionPartida::Registro & decision) {
+        SucesosJuegoComun * sucesos = juego_->sucesos ();
+        ActorPersonaje * personaje = nullptr;
+        LadoTablero lado = LadoTablero::nulo;
+        Coord celda {};
+        switch (decision.suceso) {
+        case Suceso::personajeSeleccionado:
+        case Suceso::fichaSeleccionada:
+        case Suceso::fichaPulsada:
+            if (decision.valor < 0 || decision.valor >= std::ssize (juego_->personajes ())) {
+                return false;
+            }
+            personaje = juego_->personajes () [decision.valor];
+            break;
+        case Suceso::actuanteSeleccionado:
+        case Suceso::habilidadSeleccionada:
+            if (decision.valor < 0 || decision.valor > 1) {
+                return false;
+            }
+            if (decision.suceso == Suceso::habilidadSeleccionada && 
+                    (decision.dato < 0 || decision.dato >= ActorPersonaje::maximoHabilidades)) {
+                return false;
+            }
+            lado = decision.valor == 0 ? LadoTablero::Izquierda : LadoTablero::Derecha;
+            break;
+        case Suceso::celdaSeleccionada:
+        case Suceso::celdaPulsada:
+            if (! IndiceCelda {decision.valor}.valido ()) {
+                return false;
+            }
+            celda = IndiceCelda {decision.valor}.celda ();
+            break;
+        case Suceso::ayudaSeleccionada:
+        case Suceso::pulsadoEspacio:
+        case Suceso::pulsadoEscape:
+        case Suceso::pulsadoArriba:
+        case Suceso::pulsadoAbajo:
+            break;
+        case Suceso::final:
+        case Suceso::tirada:
+        case Suceso::ronda:
+        case Suceso::jugada:
+            return false;
+        default:
+            // código de suceso desconocido, grabación dañada
+            return false;
+        }
+        //
+        GrabacionPartida & grabacion = juego_->grabacion ();
+        switch (decision.suceso) {
+        case Suceso::personajeSeleccionado:
+            situaRaton (Coord {0, 0});
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->personajeSeleccionado (personaje);
+            break;
+        case Suceso::fichaSeleccionada:
+            situaRaton (personaje->sitioFicha ());
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->fichaSeleccionada (personaje);
+            break;
+        case Suceso::fichaPulsada:
+            situaRaton (personaje->sitioFicha ());
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->fichaPulsada (personaje);
+            break;
+        case Suceso::actuanteSeleccionado:
+            situaRaton (Coord {0, 0});
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->actuanteSeleccionado (lado);
+            break;
+        case Suceso::habilidadSeleccionada:
+            situaRaton (Coord {0, 0});
+            grabacion.anota (decision.suceso, decision.valor, decision.dato);
+            sucesos->habilidadSeleccionada (lado, decision.dato);
+            break;
+        case Suceso::celdaSeleccionada:
+            situaRaton (celda);
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->celdaSeleccionada (celda);
+            break;
+        case Suceso::celdaPulsada:
+            situaRaton (celda);
+            grabacion.anota (decision.suceso, decision.valor);
+            sucesos->celdaPulsada (celda);
+            break;
+        case Suceso::ayudaSeleccionada:
+            situaRaton (Coord {0, 0});
+            grabacion.anota (decision.suceso);
+            sucesos->ayudaSeleccionada ();
+            break;
+        case Suceso::pulsadoEspacio:
+            grabacion.anota (decision.suceso);
+            sucesos->pulsadoEspacio ();
+            break;
+        case Suceso::pulsadoEscape:
+            grabacion.anota (decision.suceso);
+            sucesos->pulsadoEscape ();
+            break;
+        case Suceso::pulsadoArriba:
+            grabacion.anota (decision.suceso);
+            sucesos->pulsadoArriba ();
+            break;
+        case Suceso::pulsadoAbajo:
+            grabacion.anota (decision.suceso);
+            sucesos->pulsadoAbajo ();
+            break;
+        case Suceso::final:
+        case Suceso::tirada:
+        case Suceso::ronda:
+        case Suceso::jugada:
+        default:
+            // descartados en la comprobación de arriba
+            assert (false);
+            return false;
+        }
+        if (resuelve_calculo_) {
+            resuelveCalculo ();
+        }
+        // en el fotograma siguiente la ficha que ha llegado bajo el ratón también cuenta
+        situaRaton (raton_celda);
+        return true;
+    }
+
+
+    // como 'ActorTablero::controlSobreCelda' y, después, 'ActorPersonaje::controlSobreFicha'; 
+    // 'Coord {0, 0}' es fuera del tablero
+    void EntregaSucesos::situaRaton (Coord celda) {
+        SucesosJuegoComun * sucesos = juego_->sucesos ();
+        if (celda != raton_celda) {
+            if (raton_celda != Coord {0, 0}) {
+                sucesos->saliendoCelda (raton_celda);
+            }
+            raton_celda = celda;
+            if (raton_celda != Coord {0, 0}) {
+                sucesos->entrandoCelda (raton_celda);
+            }
+        }
+        ActorPersonaje * ficha = nullptr;
+        if (celda != Coord {0, 0}) {
+            for (ActorPersonaje * persj : juego_->personajes ()) {
+                if (persj->sitioFicha () == celda) {
+                    ficha = persj;
+                    break;
+                }
+            }
+        }
+        if (ficha != raton_ficha) {
+            if (raton_ficha != nullptr) {
+                sucesos->saliendoFicha (raton_ficha);
+            }
+            raton_ficha = ficha;
+            if (raton_ficha != nullptr) {
+                sucesos->entrandoFicha (raton_ficha);
+            }
+        }
+    }
+
+
+    // lo que haría 'JuegoMesaBase::controlTiempo' en los fotogramas siguientes
+    void EntregaSucesos::resuelveCalculo () {
+        unir2d::Tiempo & tiempo = juego_->tiempoCalculo ();
+        for (int alarma = 0; alarma < maximoAlarmas && tiempo.iniciado (); ++ alarma) {
+            juego_->sucesos ()->alarmaCalculo (tiempo);
+        }
+        if (tiempo.iniciado ()) {
+            throw std::logic_error {"EntregaSucesos: el cálculo no termina"};
+        }
+    }
+
+
+}
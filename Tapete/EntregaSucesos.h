@@ -0,0 +1,48 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  EntregaSucesos.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Entrega a 'SucesosJuegoComun' las decisiones de un jugador que no usa el ratón (una partida 
+    // grabada, un jugador automático), en el mismo orden que lo harían los actores: antes de 
+    // pulsar una celda o una ficha, el ratón sale de la anterior y entra en ella, y las pulsaciones 
+    // en los paneles lo sacan del tablero. Cada decisión se anota en la grabación del juego, como 
+    // lo hacen los actores, y los cálculos de los ataques se resuelven en el acto (sin animación 
+    // si se ha llamado a 'ModoJuegoComun::omiteAnimacionCalculo'), salvo que el juego corra con 
+    // 'unir2d::Motor' y se deje a las alarmas de los fotogramas siguientes.
+    class EntregaSucesos {
+    public:
+
+        explicit EntregaSucesos (JuegoMesaBase * juego, bool resuelve_calculo = true);
+
+        // falso si la decisión no es posible en este juego (índices fuera de rango, sucesos que no son 
+        // decisiones o desconocidos); entonces no se anota ni se entrega nada
+        bool entrega (const GrabacionPartida::Registro & decision);
+
+        static bool esDecision (GrabacionPartida::Suceso suceso);
+
+    private:
+
+        // el cálculo de un ataque dura, como mucho, estas alarmas
+        static constexpr int maximoAlarmas = 4;
+
+        JuegoMesaBase * juego_;
+        bool            resuelve_calculo_;
+
+        Coord            raton_celda {};
+        ActorPersonaje * raton_ficha {};
+
+
+        void situaRaton (Coord celda);
+        void resuelveCalculo ();
+
+    };
+
+
+}
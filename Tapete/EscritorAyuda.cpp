@@ -274,6 +274,10 @@ namespace tapete {
                             registro.valor_final_ataque));
         listado.escribe (std::format (L"    · Efectividad: {}, {}% del daño", 
                             registro.efectividad->nombre (), registro.porciento_dano));
+        const SistemaAtaque::TramoEfectividad & tramo = sistema.tramoEfectividad (registro.valor_final_ataque);
+        listado.escribe (std::format (L"      (con valores aleatorios de {} a {})", 
+                            std::max (0,  tramo.desde - registro.ventaja), 
+                            std::min (99, tramo.hasta - registro.ventaja)));
         listado.saltaLinea ();
         listado.escribe (std::format (L"    · {} (de la habilidad) con valor de {} puntos", 
                             registro.tipo_dano->nombre (), registro.valor_dano));
@@ -290,6 +294,11 @@ namespace tapete {
         listado.escribe (std::format (L"    · Vitalidad resultante:  {}  (vitalidad - daño)", 
                             registro.vitalidad_final));
         listado.saltaLinea ();
+        listado.escribe (std::format (L"    · Daño esperado:  {:.1f}  (media de los 100 valores aleatorios)", 
+                            registro.dano_esperado));
+        listado.escribe (std::format (L"    · Probabilidad de dejar a '{}' sin vitalidad:  {:.0f}%", 
+                            registro.oponente->nombre (), registro.probabilidad_muerte * 100.0f));
+        listado.saltaLinea ();
     }
 
 
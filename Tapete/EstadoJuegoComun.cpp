@@ -9,13 +9,19 @@
 namespace tapete {
 
 
-    EstadoJuegoComun::EstadoJuegoComun () {
-        this->codigo = EstadoJuegoComun::terminal;
+    EstadoJuegoComun::EstadoJuegoComun () :
+        EstadoJuegoComun {EstadoJuegoComun::terminal} {
     }
 
 
-    EstadoJuegoComun::EstadoJuegoComun (int codigo) {
-        this->codigo = codigo;
+    EstadoJuegoComun::EstadoJuegoComun (int codigo) :
+        EstadoJuegoComun {codigo, transitosComun} {
+    }
+
+
+    EstadoJuegoComun::EstadoJuegoComun (int codigo, const TablaTransitos & transitos) {
+        ponCodigo (codigo);
+        this->transitos = & transitos;
     }
 
 
@@ -25,7 +31,7 @@ namespace tapete {
 
 
     void EstadoJuegoComun::transita (const EstadoJuegoComun & destino) {
-        valida (destino);
+        aserta (destino, (* transitos) [codigo].contiene (destino));
         if (traza_transitos) {
             std::cout << std::endl << this->nombre () << " ===> " << destino.nombre () << std::endl;
         }
@@ -38,140 +44,13 @@ namespace tapete {
     }
 
 
-    void EstadoJuegoComun::valida (const EstadoJuegoComun & destino) {
-        switch (* this) {
-        case EstadoJuegoComun::terminal:
-            aserta (destino,
-                    false);
-            break;
-        case EstadoJuegoComun::inicioJugada:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionDesplazamiento      ||  
-                    destino == EstadoJuegoComun::habilidadSimpleInvalida        ||
-                    destino == EstadoJuegoComun::habilidadSimpleConfirmacion    ||
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::preparacionDesplazamiento:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionDesplazamiento      || 
-                    destino == EstadoJuegoComun::marcacionCaminoFicha           ||
-                    destino == EstadoJuegoComun::habilidadSimpleInvalida        ||
-                    destino == EstadoJuegoComun::habilidadSimpleConfirmacion    ||
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::habilidadSimpleInvalida:
-            aserta (destino,
-                    destino == EstadoJuegoComun::inicioJugada                   ||
-                    destino == EstadoJuegoComun::habilidadSimpleInvalida        ||
-                    destino == EstadoJuegoComun::habilidadSimpleConfirmacion    ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::habilidadSimpleConfirmacion:
-            aserta (destino,
-                    destino == EstadoJuegoComun::inicioJugada                   ||
-                    destino == EstadoJuegoComun::habilidadSimpleResultado       ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::preparacionHabilidadOponente:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionDesplazamiento      ||
-                    destino == EstadoJuegoComun::habilidadSimpleInvalida        ||
-                    destino == EstadoJuegoComun::habilidadSimpleConfirmacion    ||
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::oponenteHabilidadInvalido      ||
-                    destino == EstadoJuegoComun::oponenteHabilidadConfirmacion  ||
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::oponenteHabilidadInvalido:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::oponenteHabilidadInvalido      ||
-                    destino == EstadoJuegoComun::oponenteHabilidadConfirmacion  ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                        );
-            break;
-        case EstadoJuegoComun::oponenteHabilidadConfirmacion:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::oponenteHabilidadCalculando    ||
-                    destino == EstadoJuegoComun::oponenteHabilidadResultado     ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::oponenteHabilidadCalculando:
-            aserta (destino,
-                    destino == EstadoJuegoComun::oponenteHabilidadCalculando    ||
-                    destino == EstadoJuegoComun::oponenteHabilidadResultado     ||                    
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::preparacionHabilidadArea:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionDesplazamiento      ||
-                    destino == EstadoJuegoComun::habilidadSimpleInvalida        ||
-                    destino == EstadoJuegoComun::habilidadSimpleConfirmacion    ||
-                    destino == EstadoJuegoComun::preparacionHabilidadOponente   ||
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::areaHabilidadInvalida          ||
-                    destino == EstadoJuegoComun::areaHabilidadConfirmacion      ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::areaHabilidadInvalida:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::areaHabilidadInvalida          ||
-                    destino == EstadoJuegoComun::areaHabilidadConfirmacion      ||
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::areaHabilidadConfirmacion:
-            aserta (destino,
-                    destino == EstadoJuegoComun::preparacionHabilidadArea       ||
-                    destino == EstadoJuegoComun::areaHabilidadCalculando        ||                    
-                    destino == EstadoJuegoComun::areaHabilidadResultado         ||                    
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::areaHabilidadCalculando:
-            aserta (destino,
-                    destino == EstadoJuegoComun::areaHabilidadCalculando        ||
-                    destino == EstadoJuegoComun::areaHabilidadResultado         ||                    
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::mostrandoAyuda:
-            aserta (destino,
-                    destino != EstadoJuegoComun::inicial                          );
-                    //destino == EstadoJuegoComun::habilidadSimpleResultado       ||
-                    //destino == EstadoJuegoComun::oponenteHabilidadResultado     ||
-                    //destino == EstadoJuegoComun::areaHabilidadResultado         ||
-                    //destino == EstadoJuegoComun::terminal                         );
-            break;
-        case EstadoJuegoComun::finalPartida:
-            aserta (destino,
-                    destino == EstadoJuegoComun::mostrandoAyuda                 ||
-                    destino == EstadoJuegoComun::terminal                         );    
-            break;
-        default:
-            aserta (destino,
-                    false);
-            break;
-        }
+    void EstadoJuegoComun::trazaTransitos (bool trazar) {
+        traza_transitos = trazar;
     }
 
 
     void EstadoJuegoComun::ponCodigo (int valor) {
+        assert (0 <= valor && valor < ConjuntoEstados::maximoCodigos);
         this->codigo = valor;
     }
 
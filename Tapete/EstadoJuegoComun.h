@@ -9,6 +9,39 @@
 namespace tapete {
 
 
+    // Conjunto de códigos de estado como máscara de bits. Se forma al compilar a partir de una 
+    // lista de códigos, así que saber si un estado pertenece a él es un desplazamiento y un 'y'.
+    class ConjuntoEstados {
+    public:
+
+        static constexpr int maximoCodigos = 32;
+
+        constexpr ConjuntoEstados () = default;
+
+        consteval ConjuntoEstados (std::initializer_list <int> codigos) {
+            for (int codigo : codigos) {
+                // fuera de rango no compila
+                mascara |= uint32_t {1} << codigo;
+            }
+        }
+
+        constexpr bool contiene (int codigo) const {
+            return ((mascara >> codigo) & 1) != 0;
+        }
+
+        constexpr ConjuntoEstados complemento () const {
+            ConjuntoEstados resultado {};
+            resultado.mascara = ~ mascara;
+            return resultado;
+        }
+
+    private:
+
+        uint32_t mascara {};
+
+    };
+
+
     class EstadoJuegoComun {
     public:
 
@@ -40,6 +73,105 @@ namespace tapete {
 
         static constexpr int finalPartida                   = 19;
 
+        static constexpr int cuentaCodigos                  = 20;
+
+
+        // para cada estado de origen, los estados de destino admitidos por 'transita'
+        using TablaTransitos = std::array <ConjuntoEstados, ConjuntoEstados::maximoCodigos>;
+
+        static constexpr TablaTransitos transitosComun = [] {
+            TablaTransitos tabla {};
+            tabla [terminal] = {};
+            tabla [inicioJugada] = {
+                    preparacionDesplazamiento,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    preparacionHabilidadOponente,
+                    preparacionHabilidadArea,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [preparacionDesplazamiento] = {
+                    preparacionDesplazamiento,
+                    marcacionCaminoFicha,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    preparacionHabilidadOponente,
+                    preparacionHabilidadArea,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [habilidadSimpleInvalida] = {
+                    inicioJugada,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [habilidadSimpleConfirmacion] = {
+                    inicioJugada,
+                    habilidadSimpleResultado,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [preparacionHabilidadOponente] = {
+                    preparacionDesplazamiento,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    preparacionHabilidadOponente,
+                    oponenteHabilidadInvalido,
+                    oponenteHabilidadConfirmacion,
+                    preparacionHabilidadArea,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadInvalido] = {
+                    preparacionHabilidadOponente,
+                    oponenteHabilidadInvalido,
+                    oponenteHabilidadConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadConfirmacion] = {
+                    preparacionHabilidadOponente,
+                    oponenteHabilidadCalculando,
+                    oponenteHabilidadResultado,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadCalculando] = {
+                    oponenteHabilidadCalculando,
+                    oponenteHabilidadResultado,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [preparacionHabilidadArea] = {
+                    preparacionDesplazamiento,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    preparacionHabilidadOponente,
+                    preparacionHabilidadArea,
+                    areaHabilidadInvalida,
+                    areaHabilidadConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadInvalida] = {
+                    preparacionHabilidadArea,
+                    areaHabilidadInvalida,
+                    areaHabilidadConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadConfirmacion] = {
+                    preparacionHabilidadArea,
+                    areaHabilidadCalculando,
+                    areaHabilidadResultado,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadCalculando] = {
+                    areaHabilidadCalculando,
+                    areaHabilidadResultado,
+                    mostrandoAyuda,
+                    terminal };
+            // vuelve al estado previo, sea cual sea
+            tabla [mostrandoAyuda] = ConjuntoEstados {inicial}.complemento ();
+            tabla [finalPartida] = {
+                    mostrandoAyuda,
+                    terminal };
+            return tabla;
+        } ();
+
 
         explicit EstadoJuegoComun ();
         EstadoJuegoComun (int codigo);
@@ -52,20 +184,25 @@ namespace tapete {
 
         virtual const string nombre () const;
 
+        // la traza de los tránsitos por la consola; las herramientas sin ventana la desactivan
+        static void trazaTransitos (bool trazar);
+
     protected:
 
         // exclusivamente para depurar
         inline static bool traza_transitos = true;
 
 
+        EstadoJuegoComun (int codigo, const TablaTransitos & transitos);
+
         void ponCodigo (int valor);
 
-        virtual void valida (const EstadoJuegoComun & destino);
         void aserta (const EstadoJuegoComun & destino, bool condicion) const;
 
     private:
 
         int codigo;
+        const TablaTransitos * transitos;
 
         EstadoJuegoComun (const EstadoJuegoComun & ) = delete;
         EstadoJuegoComun (EstadoJuegoComun && )      = delete;
@@ -12,10 +12,60 @@ namespace tapete {
     class EstadoJuegoEquipo : public EstadoJuegoComun {
     public:
 
-        static constexpr int inicioRonda = finalPartida + 1;
+        static constexpr int inicioRonda   = finalPartida + 1;
+
+        static constexpr int inicioTurno   = finalPartida + 2;
+
+        static constexpr int cuentaCodigos = finalPartida + 3;
+        static_assert (cuentaCodigos <= ConjuntoEstados::maximoCodigos);
+
+
+        // los de 'EstadoJuegoComun', salvo los estados propios y los que terminan una acción
+        static constexpr TablaTransitos transitosEquipo = [] {
+            TablaTransitos tabla = transitosComun;
+            tabla [inicial] = {
+                    inicioRonda };
+            tabla [inicioRonda] = {
+                    inicioJugada,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurno] = {
+                    inicioJugada,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [marcacionCaminoFicha] = {
+                    inicioJugada,
+                    preparacionDesplazamiento,
+                    marcacionCaminoFicha,
+                    inicioTurno,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [habilidadSimpleResultado] = {
+                    inicioJugada,
+                    inicioTurno,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadResultado] = {
+                    inicioJugada,
+                    inicioTurno,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadResultado] = {
+                    inicioJugada,
+                    inicioTurno,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            return tabla;
+        } ();
 
-        static constexpr int inicioTurno = finalPartida + 2;
-        
 
         EstadoJuegoEquipo (int codigo);
 
@@ -23,8 +73,6 @@ namespace tapete {
 
     private:
 
-        void valida (const EstadoJuegoComun & destino) override;
-
         const string nombre () const override;
 
     };
@@ -10,98 +10,13 @@ namespace tapete {
 
 
     EstadoJuegoLibreDoble::EstadoJuegoLibreDoble (int codigo) :
-        EstadoJuegoComun {codigo} {
+        EstadoJuegoComun {codigo, transitosLibreDoble} {
     }
 
 
     void EstadoJuegoLibreDoble::transita (const EstadoJuegoLibreDoble & destino) {
-        valida (destino);
-        if (traza_transitos) {
-            std::cout << std::endl << this->nombre () << " ===> " << destino.nombre () << std::endl;
-        }
-        ponCodigo (destino);
-    }
-
-
-    void EstadoJuegoLibreDoble::valida (const EstadoJuegoComun & destino) {
-        switch (* this) {
-        case EstadoJuegoLibreDoble::inicial:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioRonda);
-            break;
-        case EstadoJuegoLibreDoble::inicioRonda:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoLibreDoble::inicioTurnoNoElegido:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioTurnoConfirmacion   ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoLibreDoble::inicioTurnoConfirmacion:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioJugada              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoComun::marcacionCaminoFicha:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioJugada              ||
-                    destino == EstadoJuegoLibreDoble::preparacionDesplazamiento ||
-                    destino == EstadoJuegoLibreDoble::marcacionCaminoFicha      ||
-                    destino == EstadoJuegoLibreDoble::agotadosPuntosAccion      ||
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioRonda               ||
-                    destino == EstadoJuegoLibreDoble::finalPartida              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoComun::habilidadSimpleResultado:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioJugada              ||
-                    destino == EstadoJuegoLibreDoble::agotadosPuntosAccion      ||
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioRonda               ||
-                    destino == EstadoJuegoLibreDoble::finalPartida              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoComun::oponenteHabilidadResultado:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioJugada              ||
-                    destino == EstadoJuegoLibreDoble::agotadosPuntosAccion      ||
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioRonda               ||
-                    destino == EstadoJuegoLibreDoble::finalPartida              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoComun::areaHabilidadResultado:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioJugada              ||
-                    destino == EstadoJuegoLibreDoble::agotadosPuntosAccion      ||
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioRonda               ||
-                    destino == EstadoJuegoLibreDoble::finalPartida              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );
-            break;
-        case EstadoJuegoLibreDoble::agotadosPuntosAccion:
-            aserta (destino,
-                    destino == EstadoJuegoLibreDoble::inicioTurnoNoElegido      ||
-                    destino == EstadoJuegoLibreDoble::inicioRonda               ||
-                    destino == EstadoJuegoLibreDoble::finalPartida              ||
-                    destino == EstadoJuegoLibreDoble::mostrandoAyuda            ||
-                    destino == EstadoJuegoLibreDoble::terminal                    );    
-            break;
-        default:
-            EstadoJuegoComun::valida (destino);
-            break;
-        }
+        // el destino con su tipo, para que la traza y los errores den su nombre
+        EstadoJuegoComun::transita (destino);
     }
 
 
@@ -18,7 +18,72 @@ namespace tapete {
         static constexpr int inicioTurnoConfirmacion = finalPartida + 3;
 
         static constexpr int agotadosPuntosAccion    = finalPartida + 4;
-        
+
+        static constexpr int cuentaCodigos           = finalPartida + 5;
+        static_assert (cuentaCodigos <= ConjuntoEstados::maximoCodigos);
+
+
+        // los de 'EstadoJuegoComun', salvo los estados propios y los que terminan una acción
+        static constexpr TablaTransitos transitosLibreDoble = [] {
+            TablaTransitos tabla = transitosComun;
+            tabla [inicial] = {
+                    inicioRonda };
+            tabla [inicioRonda] = {
+                    inicioTurnoNoElegido,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurnoNoElegido] = {
+                    inicioTurnoConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurnoConfirmacion] = {
+                    inicioTurnoNoElegido,
+                    inicioJugada,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [marcacionCaminoFicha] = {
+                    inicioJugada,
+                    preparacionDesplazamiento,
+                    marcacionCaminoFicha,
+                    agotadosPuntosAccion,
+                    inicioTurnoNoElegido,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [habilidadSimpleResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    inicioTurnoNoElegido,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    inicioTurnoNoElegido,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    inicioTurnoNoElegido,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [agotadosPuntosAccion] = {
+                    inicioTurnoNoElegido,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            return tabla;
+        } ();
+
 
         EstadoJuegoLibreDoble (int codigo);
 
@@ -26,8 +91,6 @@ namespace tapete {
 
     private:
 
-        void valida (const EstadoJuegoComun & destino) override;
-
         const string nombre () const override;
 
     };
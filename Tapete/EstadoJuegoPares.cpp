@@ -10,104 +10,13 @@ namespace tapete {
 
 
     EstadoJuegoPares::EstadoJuegoPares (int codigo) :
-        EstadoJuegoComun {codigo} {
+        EstadoJuegoComun {codigo, transitosPares} {
     }
 
 
     void EstadoJuegoPares::transita (const EstadoJuegoPares & destino) {
-        valida (destino);
-        if (traza_transitos) {
-            std::cout << std::endl << this->nombre () << " ===> " << destino.nombre () << std::endl;
-        }
-        ponCodigo (destino);
-    }
-
-
-    void EstadoJuegoPares::valida (const EstadoJuegoComun & destino) {
-        switch (* this) {
-        case EstadoJuegoPares::inicial:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioRonda);
-            break;
-        case EstadoJuegoPares::inicioRonda:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioTurnoNoElegidos          ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::inicioTurnoNoElegidos:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioTurnoElegidoUno          ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::inicioTurnoElegidoUno:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioTurnoConfirmacion        ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::inicioTurnoConfirmacion:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioTurnoNoElegidos          ||
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::marcacionCaminoFicha:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::preparacionDesplazamiento      ||
-                    destino == EstadoJuegoPares::marcacionCaminoFicha           ||
-                    destino == EstadoJuegoPares::agotadosPuntosAccion           ||
-                    destino == EstadoJuegoPares::finalTurno                     ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::habilidadSimpleResultado:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::agotadosPuntosAccion           ||
-                    destino == EstadoJuegoPares::finalTurno                     ||                    
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::oponenteHabilidadResultado:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::agotadosPuntosAccion           ||
-                    destino == EstadoJuegoPares::finalTurno                     ||                    
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::areaHabilidadResultado:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::agotadosPuntosAccion           ||
-                    destino == EstadoJuegoPares::finalTurno                     ||                    
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );
-            break;
-        case EstadoJuegoPares::agotadosPuntosAccion:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioJugada                   ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );    
-            break;
-        case EstadoJuegoPares::finalTurno:
-            aserta (destino,
-                    destino == EstadoJuegoPares::inicioTurnoNoElegidos          ||
-                    destino == EstadoJuegoPares::inicioRonda                    ||
-                    destino == EstadoJuegoPares::finalPartida                   ||
-                    destino == EstadoJuegoPares::mostrandoAyuda                 ||
-                    destino == EstadoJuegoPares::terminal                         );    
-            break;
-        default:
-            EstadoJuegoComun::valida (destino);
-            break;
-        }
-        //
-        // por fin:
+        // el destino con su tipo, para que la traza y los errores den su nombre
+        EstadoJuegoComun::transita (destino);
     }
 
 
@@ -20,7 +20,84 @@ namespace tapete {
 
         static constexpr int agotadosPuntosAccion    = finalPartida + 5;
         static constexpr int finalTurno              = finalPartida + 6;
-        
+
+        static constexpr int cuentaCodigos           = finalPartida + 7;
+        static_assert (cuentaCodigos <= ConjuntoEstados::maximoCodigos);
+
+
+        // los de 'EstadoJuegoComun', salvo los estados propios y los que terminan una acción
+        static constexpr TablaTransitos transitosPares = [] {
+            TablaTransitos tabla = transitosComun;
+            tabla [inicial] = {
+                    inicioRonda };
+            tabla [inicioRonda] = {
+                    inicioTurnoNoElegidos,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurnoNoElegidos] = {
+                    inicioTurnoElegidoUno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurnoElegidoUno] = {
+                    inicioTurnoConfirmacion,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [inicioTurnoConfirmacion] = {
+                    inicioTurnoNoElegidos,
+                    inicioJugada,
+                    mostrandoAyuda,
+                    terminal };
+            // 'cedeJugada': el atacante bloqueado cede sus puntos y termina la jugada
+            tabla [inicioJugada] = {
+                    inicioJugada,
+                    preparacionDesplazamiento,
+                    habilidadSimpleInvalida,
+                    habilidadSimpleConfirmacion,
+                    preparacionHabilidadOponente,
+                    preparacionHabilidadArea,
+                    agotadosPuntosAccion,
+                    finalTurno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [marcacionCaminoFicha] = {
+                    inicioJugada,
+                    preparacionDesplazamiento,
+                    marcacionCaminoFicha,
+                    agotadosPuntosAccion,
+                    finalTurno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [habilidadSimpleResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    finalTurno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [oponenteHabilidadResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    finalTurno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [areaHabilidadResultado] = {
+                    inicioJugada,
+                    agotadosPuntosAccion,
+                    finalTurno,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [agotadosPuntosAccion] = {
+                    inicioJugada,
+                    mostrandoAyuda,
+                    terminal };
+            tabla [finalTurno] = {
+                    inicioTurnoNoElegidos,
+                    inicioRonda,
+                    finalPartida,
+                    mostrandoAyuda,
+                    terminal };
+            return tabla;
+        } ();
+
 
         EstadoJuegoPares (int codigo);
 
@@ -28,8 +105,6 @@ namespace tapete {
 
     private:
 
-        void valida (const EstadoJuegoComun & destino) override;
-
         const string nombre () const override;
 
     };
@@ -0,0 +1,34 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   GeometriaHexagonal.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    void GeometriaHexagonal::anillo (Coord celda_central, int radio, std::vector <Coord> & celdas) {
+        celdas.clear ();
+        if (radio == 0) {
+            celdas.push_back (celda_central);
+            return;
+        }
+        celdas.reserve (direcciones * radio);
+        Coord celda = Coord {
+                celda_central.fila () + radio * desplazaFila [0], 
+                celda_central.coln () + radio * desplazaColn [0]  };
+        // cada lado avanza en la dirección que sigue, en el sentido de las agujas del reloj, a la 
+        // que lleva desde el centro hasta su primera celda
+        for (int lado = 0; lado < direcciones; ++ lado) {
+            int direccion = (lado + 2) % direcciones;
+            for (int paso = 0; paso < radio; ++ paso) {
+                celdas.push_back (celda);
+                celda = vecina (celda, direccion);
+            }
+        }
+    }
+
+
+}
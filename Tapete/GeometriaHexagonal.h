@@ -0,0 +1,84 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  GeometriaHexagonal.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Geometría entera de la rejilla de 'RejillaTablero'. Las celdas usan coordenadas dobladas: 
+    // la fila avanza de dos en dos entre celdas de la misma columna, y fila y columna tienen la 
+    // misma paridad. Equivalen a las coordenadas cúbicas (q, r, s) con:
+    //      q = columna
+    //      r = (fila - columna) / 2
+    //      s = - q - r
+    // Las distancias se miden en casillas (pasos entre celdas vecinas), sin coma flotante.
+    class GeometriaHexagonal {
+    public:
+
+        static constexpr int direcciones = 6;
+
+        // en el sentido de las agujas del reloj, empezando por la vecina de arriba
+        static constexpr int desplazaFila [direcciones] = { -2, -1,  1,  2,  1, -1 };
+        static constexpr int desplazaColn [direcciones] = {  0,  1,  1,  0, -1, -1 };
+
+
+        // 'fila' no interviene en q; está para que las tres coordenadas se pidan igual
+        static constexpr int cuboQ ([[maybe_unused]] int fila, int coln) {
+            return coln;
+        }
+
+        static constexpr int cuboR (int fila, int coln) {
+            return (fila - coln) / 2;
+        }
+
+        static constexpr int cuboS (int fila, int coln) {
+            return - cuboQ (fila, coln) - cuboR (fila, coln);
+        }
+
+        static constexpr int distancia (int fila_1, int coln_1, int fila_2, int coln_2) {
+            int dq = cuboQ (fila_2, coln_2) - cuboQ (fila_1, coln_1);
+            int dr = cuboR (fila_2, coln_2) - cuboR (fila_1, coln_1);
+            int ds = cuboS (fila_2, coln_2) - cuboS (fila_1, coln_1);
+            return (absoluto (dq) + absoluto (dr) + absoluto (ds)) / 2;
+        }
+
+        static int distancia (Coord celda_1, Coord celda_2) {
+            return distancia (celda_1.fila (), celda_1.coln (), celda_2.fila (), celda_2.coln ());
+        }
+
+        static bool enAlcance (Coord celda_1, Coord celda_2, int alcance) {
+            return distancia (celda_1, celda_2) <= alcance;
+        }
+
+        static Coord vecina (Coord celda, int direccion) {
+            return Coord {
+                    celda.fila () + desplazaFila [direccion], 
+                    celda.coln () + desplazaColn [direccion]  };
+        }
+
+        // Las celdas a distancia 'radio' de la central, empezando por la de arriba y en el sentido
+        // de las agujas del reloj. No comprueba que estén en el tablero.
+        static void anillo (Coord celda_central, int radio, std::vector <Coord> & celdas);
+
+    private:
+
+        static constexpr int absoluto (int valor) {
+            return valor < 0 ? - valor : valor;
+        }
+
+    };
+
+
+    static_assert (GeometriaHexagonal::distancia (25, 25, 25, 25) == 0);
+    static_assert (GeometriaHexagonal::distancia (25, 25, 23, 25) == 1);
+    static_assert (GeometriaHexagonal::distancia (25, 25, 26, 26) == 1);
+    static_assert (GeometriaHexagonal::distancia (25, 25, 25, 27) == 2);
+    static_assert (GeometriaHexagonal::distancia (25, 25, 31, 27) == 4);
+    static_assert (GeometriaHexagonal::distancia ( 1,  1, 51, 49) == 49);
+
+
+}
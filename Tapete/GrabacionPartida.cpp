@@ -0,0 +1,320 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   GrabacionPartida.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    GrabacionPartida::~GrabacionPartida () {
+        if (activa_) {
+            cierra ();
+        }
+    }
+
+
+    bool GrabacionPartida::activa () const {
+        return activa_;
+    }
+
+
+    bool GrabacionPartida::correcta () const {
+        return ! fallo.load (std::memory_order_acquire);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    // Formato del archivo:
+    //     "TGRB"
+    //     varint  versión
+    //     uint64  huella de la configuración (8 octetos, el menos significativo primero)
+    //     uint64  semilla del azar de la partida (igual)
+    //     y los sucesos: varint código del suceso, seguido de sus operandos, cada uno un varint 
+    //     (la clave del suceso 'jugada' es un varint de 64 bits)
+    // Un varint lleva 7 bits por octeto, los menos significativos primero; el bit alto indica 
+    // que sigue otro octeto. Una grabación interrumpida no tiene el suceso 'final'.
+    void GrabacionPartida::abre (const string & ruta_archivo, uint64_t huella, uint64_t semilla) {
+        if (activa_) {
+            throw std::logic_error {"GrabacionPartida: ya hay una grabación abierta"};
+        }
+        archivo.open (ruta_archivo, std::ios::binary | std::ios::trunc);
+        if (! archivo) {
+            throw std::runtime_error {"GrabacionPartida: no se puede crear el archivo " + ruta_archivo};
+        }
+        fallo.store (false, std::memory_order_relaxed);
+        terminando = false;
+        pendiente.clear ();
+        pendiente.insert (pendiente.end (), std::begin (firma), std::end (firma));
+        codifica (version);
+        codificaFijo (huella);
+        codificaFijo (semilla);
+        escritor = std::thread {& GrabacionPartida::escribe, this};
+        memoria = false;
+        activa_ = true;
+    }
+
+
+    void GrabacionPartida::abreMemoria () {
+        if (activa_) {
+            throw std::logic_error {"GrabacionPartida: ya hay una grabación abierta"};
+        }
+        registros_.clear ();
+        memoria = true;
+        activa_ = true;
+    }
+
+
+    void GrabacionPartida::cierra () {
+        if (! activa_) {
+            return;
+        }
+        anota (Suceso::final);
+        if (memoria) {
+            activa_ = false;
+            return;
+        }
+        entrega ();
+        {
+            std::lock_guard <std::mutex> bloqueo {cerrojo};
+            terminando = true;
+        }
+        aviso.notify_one ();
+        escritor.join ();
+        archivo.close ();
+        activa_ = false;
+    }
+
+
+    const std::vector <GrabacionPartida::Registro> & GrabacionPartida::registros () const {
+        return registros_;
+    }
+
+
+    void GrabacionPartida::descartaRegistros () {
+        registros_.clear ();
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void GrabacionPartida::anota (Suceso suceso) {
+        if (! activa_) {
+            return;
+        }
+        assert (operandos (suceso) == 0);
+        if (memoria) {
+            registros_.push_back ({ suceso });
+            return;
+        }
+        codifica (static_cast <uint64_t> (suceso));
+    }
+
+
+    void GrabacionPartida::anota (Suceso suceso, int valor) {
+        if (! activa_) {
+            return;
+        }
+        assert (operandos (suceso) == 1 && suceso != Suceso::jugada);
+        assert (valor >= 0);
+        if (memoria) {
+            registros_.push_back ({ suceso, valor });
+            return;
+        }
+        codifica (static_cast <uint64_t> (suceso));
+        codifica (static_cast <uint64_t> (valor));
+    }
+
+
+    void GrabacionPartida::anota (Suceso suceso, int valor, int dato) {
+        if (! activa_) {
+            return;
+        }
+        assert (operandos (suceso) == 2);
+        assert (valor >= 0 && dato >= 0);
+        if (memoria) {
+            registros_.push_back ({ suceso, valor, dato });
+            return;
+        }
+        codifica (static_cast <uint64_t> (suceso));
+        codifica (static_cast <uint64_t> (valor));
+        codifica (static_cast <uint64_t> (dato));
+    }
+
+
+    void GrabacionPartida::anotaRonda (int ronda) {
+        if (! activa_) {
+            return;
+        }
+        anota (Suceso::ronda, ronda);
+        if (! memoria) {
+            entrega ();
+        }
+    }
+
+
+    void GrabacionPartida::anotaJugada (uint64_t clave_estado) {
+        if (! activa_) {
+            return;
+        }
+        if (memoria) {
+            registros_.push_back ({ Suceso::jugada, 0, 0, clave_estado });
+            return;
+        }
+        codifica (static_cast <uint64_t> (Suceso::jugada));
+        codifica (clave_estado);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void GrabacionPartida::codifica (uint64_t numero) {
+        while (numero >= 0x80) {
+            pendiente.push_back (static_cast <uint8_t> (numero | 0x80));
+            numero >>= 7;
+        }
+        pendiente.push_back (static_cast <uint8_t> (numero));
+    }
+
+
+    void GrabacionPartida::codificaFijo (uint64_t numero) {
+        for (int indc = 0; indc < 8; ++ indc) {
+            pendiente.push_back (static_cast <uint8_t> (numero >> (indc * 8)));
+        }
+    }
+
+
+    // el hilo del juego solo retiene el cerrojo para intercambiar los búferes (o, si el escritor 
+    // no ha terminado con el anterior, para añadir lo pendiente)
+    void GrabacionPartida::entrega () {
+        if (pendiente.empty ()) {
+            return;
+        }
+        {
+            std::lock_guard <std::mutex> bloqueo {cerrojo};
+            if (salida.empty ()) {
+                salida.swap (pendiente);
+            } else {
+                salida.insert (salida.end (), pendiente.begin (), pendiente.end ());
+            }
+        }
+        pendiente.clear ();
+        aviso.notify_one ();
+    }
+
+
+    void GrabacionPartida::escribe () {
+        std::vector <uint8_t> lote {};
+        std::unique_lock <std::mutex> bloqueo {cerrojo};
+        while (true) {
+            aviso.wait (bloqueo, [this] { return ! salida.empty () || terminando; });
+            if (salida.empty ()) {
+                // 'terminando' y nada más que escribir
+                return;
+            }
+            lote.swap (salida);
+            bloqueo.unlock ();
+            archivo.write (reinterpret_cast <const char *> (lote.data ()), lote.size ());
+            archivo.flush ();
+            if (! archivo) {
+                fallo.store (true, std::memory_order_release);
+            }
+            lote.clear ();
+            bloqueo.lock ();
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    void GrabacionPartida::lee (const string & ruta_archivo, Cabecera & cabecera, std::vector <Registro> & registros) {
+        std::ifstream archivo {ruta_archivo, std::ios::binary};
+        if (! archivo) {
+            throw std::runtime_error {"GrabacionPartida: no se puede abrir el archivo " + ruta_archivo};
+        }
+        std::vector <uint8_t> octetos {std::istreambuf_iterator <char> {archivo}, std::istreambuf_iterator <char> {}};
+        size_t posicion = 0;
+        //
+        auto decodifica = [&] () -> uint64_t {
+            uint64_t numero = 0;
+            for (int desplaza = 0; desplaza < 64; desplaza += 7) {
+                if (posicion == octetos.size ()) {
+                    throw std::runtime_error {"GrabacionPartida: grabación truncada " + ruta_archivo};
+                }
+                uint8_t octeto = octetos [posicion ++];
+                numero |= static_cast <uint64_t> (octeto & 0x7F) << desplaza;
+                if ((octeto & 0x80) == 0) {
+                    return numero;
+                }
+            }
+            throw std::runtime_error {"GrabacionPartida: entero mal codificado " + ruta_archivo};
+        };
+        auto decodificaFijo = [&] () -> uint64_t {
+            if (octetos.size () - posicion < 8) {
+                throw std::runtime_error {"GrabacionPartida: grabación truncada " + ruta_archivo};
+            }
+            uint64_t numero = 0;
+            for (int indc = 0; indc < 8; ++ indc) {
+                numero |= static_cast <uint64_t> (octetos [posicion ++]) << (indc * 8);
+            }
+            return numero;
+        };
+        //
+        if (octetos.size () < sizeof (firma) || ! std::equal (std::begin (firma), std::end (firma), octetos.begin ())) {
+            throw std::runtime_error {"GrabacionPartida: no es una grabación " + ruta_archivo};
+        }
+        posicion = sizeof (firma);
+        cabecera.version = static_cast <int> (decodifica ());
+        if (cabecera.version < 1 || cabecera.version > version) {
+            throw std::runtime_error {"GrabacionPartida: versión desconocida " + ruta_archivo};
+        }
+        cabecera.huella  = decodificaFijo ();
+        cabecera.semilla = decodificaFijo ();
+        //
+        registros.clear ();
+        while (posicion < octetos.size ()) {
+            uint64_t codigo = decodifica ();
+            if (codigo >= cuentaSucesos) {
+                throw std::runtime_error {"GrabacionPartida: suceso desconocido " + ruta_archivo};
+            }
+            Registro registro {};
+            registro.suceso = static_cast <Suceso> (codigo);
+            int cuenta = operandos (registro.suceso);
+            if (registro.suceso == Suceso::jugada) {
+                registro.clave = decodifica ();
+            } else if (cuenta >= 1) {
+                registro.valor = static_cast <int> (decodifica ());
+            }
+            if (cuenta >= 2) {
+                registro.dato = static_cast <int> (decodifica ());
+            }
+            registros.push_back (registro);
+            if (registro.suceso == Suceso::final) {
+                break;
+            }
+        }
+    }
+
+
+    uint64_t GrabacionPartida::huellaConfiguracion (const reglas::ReglasPartida & reglas_partida, 
+                                                    const reglas::EstadoPartida & estado_inicial, 
+                                                    const string & nombre_modo) {
+        reglas::Huella resumen {};
+        resumen.agrega (reglas_partida.huella ());
+        resumen.agrega (estado_inicial.cuenta_personajes);
+        for (int indc = 0; indc < estado_inicial.cuenta_personajes; ++ indc) {
+            resumen.agrega (estado_inicial.personajes [indc]);
+        }
+        resumen.agrega (nombre_modo.data (), nombre_modo.size ());
+        return resumen.valor ();
+    }
+
+
+}
@@ -0,0 +1,150 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  GrabacionPartida.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Grabación de una partida como la serie de sucesos que la deciden: las decisiones del jugador 
+    // que llegan a 'SucesosJuegoComun' y las tiradas del azar de la partida. Con la cabecera 
+    // (huella de la configuración y semilla) basta para volver a jugarla; la clave del estado al 
+    // final de cada jugada permite comprobar que la repetición coincide ('RepeticionPartida').
+    // Los sucesos se codifican en enteros variables (7 bits por octeto) y las celdas con su 
+    // 'IndiceCelda'; se acumulan en memoria y un hilo escritor los pasa al archivo al final de 
+    // cada ronda, de modo que el bucle de los fotogramas nunca espera al disco.
+    // Anota un único hilo, el del juego.
+    class GrabacionPartida {
+    public:
+
+        static constexpr int version = 3;
+
+        enum class Suceso : uint8_t {
+            final                 =  0,  // sin operandos; el último de una partida terminada
+            personajeSeleccionado =  1,  // índice del personaje
+            fichaSeleccionada     =  2,  // índice del personaje
+            fichaPulsada          =  3,  // índice del personaje
+            actuanteSeleccionado  =  4,  // índice del lado
+            habilidadSeleccionada =  5,  // índice del lado, índice de la habilidad
+            celdaSeleccionada     =  6,  // índice de la celda
+            celdaPulsada          =  7,  // índice de la celda
+            ayudaSeleccionada     =  8,
+            pulsadoEspacio        =  9,
+            pulsadoEscape         = 10,
+            pulsadoArriba         = 11,
+            pulsadoAbajo          = 12,
+            tirada                = 13,  // valor obtenido, contador del sorteo
+            ronda                 = 14,  // número de la ronda que empieza
+            jugada                = 15,  // clave del estado al terminar la jugada (desde la versión 2)
+        };
+
+        static constexpr int cuentaSucesos = 16;
+
+        static constexpr int operandos (Suceso suceso) {
+            switch (suceso) {
+            case Suceso::personajeSeleccionado:
+            case Suceso::fichaSeleccionada:
+            case Suceso::fichaPulsada:
+            case Suceso::actuanteSeleccionado:
+            case Suceso::celdaSeleccionada:
+            case Suceso::celdaPulsada:
+            case Suceso::ronda:
+            case Suceso::jugada:
+                return 1;
+            case Suceso::habilidadSeleccionada:
+            case Suceso::tirada:
+                return 2;
+            default:
+                return 0;
+            }
+        }
+
+        struct Cabecera {
+            int      version {};
+            uint64_t huella {};
+            uint64_t semilla {};
+        };
+
+        struct Registro {
+            Suceso   suceso {};
+            int      valor {};
+            int      dato {};
+            // solo en el suceso 'jugada': 'reglas::EstadoPartida::clave' desde la versión 3 (en la 
+            // 2, otra huella del estado)
+            uint64_t clave {};
+
+            bool operator == (const Registro &) const = default;
+        };
+
+        GrabacionPartida () = default;
+        ~GrabacionPartida ();
+
+        GrabacionPartida (const GrabacionPartida &) = delete;
+        GrabacionPartida & operator = (const GrabacionPartida &) = delete;
+
+        bool activa () const;
+        // falso si el hilo escritor no pudo escribir en el archivo
+        bool correcta () const;
+
+        void abre (const string & ruta_archivo, uint64_t huella, uint64_t semilla);
+        // sin archivo: los sucesos quedan en 'registros', sin codificar, para compararlos
+        void abreMemoria ();
+        // anota el suceso 'final', escribe lo pendiente y espera al hilo escritor
+        void cierra ();
+
+        // los anotados desde 'abreMemoria' o desde el último 'descartaRegistros'
+        const std::vector <Registro> & registros () const;
+        void descartaRegistros ();
+
+        void anota (Suceso suceso);
+        void anota (Suceso suceso, int valor);
+        void anota (Suceso suceso, int valor, int dato);
+
+        // anota el suceso 'ronda' y pasa lo acumulado al hilo escritor
+        void anotaRonda (int ronda);
+        void anotaJugada (uint64_t clave_estado);
+
+        // lee una grabación completa; excepción si el archivo no es una grabación válida
+        static void lee (const string & ruta_archivo, Cabecera & cabecera, std::vector <Registro> & registros);
+
+        // huella de la configuración de la partida: las reglas, la situación inicial de los 
+        // personajes y el modo de juego
+        static uint64_t huellaConfiguracion (const reglas::ReglasPartida & reglas_partida, 
+                                             const reglas::EstadoPartida & estado_inicial, 
+                                             const string & nombre_modo);
+
+    private:
+
+        static constexpr char firma [4] = {'T', 'G', 'R', 'B'};
+
+        bool activa_ {};
+        bool memoria {};
+
+        std::vector <Registro> registros_ {};
+
+        // solo la usa el hilo del juego
+        std::vector <uint8_t> pendiente {};
+
+        // compartidos con el hilo escritor, bajo 'cerrojo'
+        std::vector <uint8_t>   salida {};
+        bool                    terminando {};
+        std::mutex              cerrojo {};
+        std::condition_variable aviso {};
+
+        std::ofstream      archivo {};
+        std::thread        escritor {};
+        std::atomic <bool> fallo {};
+
+
+        void codifica (uint64_t numero);
+        void codificaFijo (uint64_t numero);
+        void entrega ();
+        void escribe ();
+
+    };
+
+
+}
@@ -9,23 +9,10 @@
 namespace tapete {
 
 
-    enum class EnfoqueHabilidad {
-        si_mismo,
-        personaje,
-        area,
-    };
-
-    enum class AccesoHabilidad {
-        ninguno,
-        directo,
-        indirecto,
-    };
-
-    enum class Antagonista {
-        oponente,
-        aliado,
-        si_mismo
-    };
+    // véase: 'reglas::TiposReglas'
+    using EnfoqueHabilidad = reglas::EnfoqueHabilidad;
+    using AccesoHabilidad  = reglas::AccesoHabilidad;
+    using Antagonista      = reglas::Antagonista;
 
 
     class Habilidad {
@@ -0,0 +1,109 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  IndiceCelda.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Número compacto de una celda válida de la rejilla, de 0 a 'cuenta' - 1. Las celdas válidas 
+    // tienen fila y columna de igual paridad; en el recorrido por filas de la rejilla completa 
+    // ocupan las posiciones pares, por eso basta con dividir entre dos. Las celdas no válidas 
+    // (también 'Coord {0, 0}') tienen el índice 'nulo'.
+    class IndiceCelda {
+    public:
+
+        static constexpr int cuenta = (RejillaTablero::filas * RejillaTablero::columnas + 1) / 2;
+        static constexpr int nulo   = -1;
+
+
+        constexpr IndiceCelda () = default;
+
+        constexpr explicit IndiceCelda (int valor) : 
+                valor_ {0 <= valor && valor < cuenta ? valor : nulo} {
+        }
+
+        constexpr IndiceCelda (int fila, int coln) : 
+                valor_ {calcula (fila, coln)} {
+        }
+
+        explicit IndiceCelda (Coord celda) : 
+                IndiceCelda {celda.fila (), celda.coln ()} {
+        }
+
+        constexpr int  valor  () const { return valor_; }
+        constexpr bool valido () const { return valor_ != nulo; }
+
+        constexpr int fila () const { return valido () ? valor_ * 2 / RejillaTablero::columnas + 1 : 0; }
+        constexpr int coln () const { return valido () ? valor_ * 2 % RejillaTablero::columnas + 1 : 0; }
+
+        Coord celda () const { return Coord {fila (), coln ()}; }
+
+        constexpr bool operator == (const IndiceCelda &) const = default;
+
+    private:
+
+        int valor_ {nulo};
+
+        static constexpr int calcula (int fila, int coln) {
+            if (fila < 1 || fila > RejillaTablero::filas) {
+                return nulo;
+            }
+            if (coln < 1 || coln > RejillaTablero::columnas) {
+                return nulo;
+            }
+            if ((fila % 2 == 0) != (coln % 2 == 0)) {
+                return nulo;
+            }
+            return ((fila - 1) * RejillaTablero::columnas + (coln - 1)) / 2;
+        }
+
+    };
+
+
+    static_assert (IndiceCelda::cuenta == 1250);
+    static_assert (IndiceCelda { 1,  1}.valor () == 0);
+    static_assert (IndiceCelda {51, 49}.valor () == IndiceCelda::cuenta - 1);
+    static_assert (IndiceCelda { 2,  1}.valor () == IndiceCelda::nulo);
+    static_assert (IndiceCelda {IndiceCelda {26, 14}.valor ()}.fila () == 26);
+    static_assert (IndiceCelda {IndiceCelda {26, 14}.valor ()}.coln () == 14);
+
+
+    // Un valor por cada celda válida, en un 'std::array' contiguo, en lugar de un vector de 'Coord' 
+    // que hay que recorrer para encontrar la celda. El índice debe ser válido.
+    template <typename T>
+    class TablaCeldas {
+    public:
+
+        T & operator [] (IndiceCelda indice) {
+            return valores [indice.valor ()];
+        }
+
+        const T & operator [] (IndiceCelda indice) const {
+            return valores [indice.valor ()];
+        }
+
+        void rellena (const T & valor) {
+            valores.fill (valor);
+        }
+
+        auto begin ()       { return valores.begin (); }
+        auto end   ()       { return valores.end   (); }
+        auto begin () const { return valores.begin (); }
+        auto end   () const { return valores.end   (); }
+
+    private:
+
+        std::array <T, IndiceCelda::cuenta> valores {};
+
+    };
+
+
+    // Un bit por cada celda válida.
+    using ConjuntoCeldas = std::bitset <IndiceCelda::cuenta>;
+
+
+}
@@ -0,0 +1,73 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  InstantaneaPartida.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // El estado de una partida entre dos jugadas, como valor: los personajes se identifican por su 
+    // índice en 'JuegoMesaBase::personajes', así que no contiene punteros y se copia con una 
+    // asignación (o 'memcpy'). Sirve para deshacer jugadas y para que una búsqueda pruebe jugadas 
+    // sobre una copia. Véase: 'JuegoMesaBase::captura' y 'JuegoMesaBase::restaura'.
+    // No guarda lo que se deduce del resto (el lado que elige, el equipo del turno en las reglas, 
+    // los valores iniciales de las estadísticas), así que ocupa unos 330 octetos.
+    // No vale a mitad de una jugada: ni el camino, ni la habilidad, ni el oponente, ni el área que 
+    // se están marcando forman parte de ella.
+    struct InstantaneaPartida {
+
+        struct Personaje {
+            int16_t celda {};
+            int16_t vitalidad {};
+            int8_t  puntos_accion {};
+        };
+
+        // solo los cambios de ataque y defensa distintos de cero: casi todos lo son, y se 
+        // deshacen al empezar cada ronda
+        struct CambioEstadistica {
+            int8_t  personaje {};
+            // los tipos de defensa van detrás de los de ataque
+            int8_t  tipo {};
+            int16_t valor {};
+        };
+
+        static constexpr int maximoCambios = 48;
+
+        std::array <Personaje, reglas::ReglasPartida::maximoPersonajes> personajes {};
+        int8_t cuenta_personajes {};
+
+        std::array <CambioEstadistica, maximoCambios> cambios {};
+        int8_t cuenta_cambios {};
+
+        int16_t ronda {};
+        int16_t turno {};
+        int16_t jugada {};
+
+        // personaje elegido en cada lado ('reglas::indiceLado') y atacante, o 'ninguno'
+        std::array <int8_t, 2> elegido { reglas::EstadoPartida::ninguno, reglas::EstadoPartida::ninguno };
+        int8_t atacante {reglas::EstadoPartida::ninguno};
+
+        LadoTablero lado_equipo_inicial {LadoTablero::nulo};
+        LadoTablero lado_equipo_actual {LadoTablero::nulo};
+
+        // índices de los personajes de 'ModoJuegoBase::factoresEquipos'
+        std::array <int8_t, reglas::ReglasPartida::maximoPersonajes> factores_equipos {};
+        int8_t cuenta_factores {};
+        int8_t indice_factor_equipos {};
+
+        // código del estado del modo de juego ('EstadoJuegoComun' o derivado)
+        int16_t estado_modo {EstadoJuegoComun::inicial};
+
+        // al deshacer una jugada se deshacen también sus tiradas
+        reglas::GeneradorAzar azar_partida {};
+
+    };
+
+
+    static_assert (std::is_trivially_copyable_v <InstantaneaPartida>);
+
+
+}
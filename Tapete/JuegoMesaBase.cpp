@@ -47,6 +47,78 @@ namespace tapete {
     }
 
 
+    const reglas::ReglasPartida & JuegoMesaBase::reglasPartida () const {
+        return reglas_partida;
+    }
+
+
+    const reglas::MotorReglas & JuegoMesaBase::motorReglas () const {
+        assert (motor_reglas != nullptr);
+        return * motor_reglas;
+    }
+
+
+    void JuegoMesaBase::captura (InstantaneaPartida & instantanea) {
+        modo_->captura (instantanea);
+    }
+
+
+    void JuegoMesaBase::restaura (const InstantaneaPartida & instantanea) {
+        modo_->restaura (instantanea);
+    }
+
+
+    void JuegoMesaBase::sustituyeMuros (const ActorTablero::GraficoMuros & grafico_muros) {
+        muros_sustitutos = & grafico_muros;
+    }
+
+
+    void JuegoMesaBase::juegaAutomatico (LadoTablero lado, NivelAutomatico nivel, int milisegundos, int hilos) {
+        int indice = reglas::indiceLado (lado);
+        automatico              [indice] = true;
+        nivel_automatico        [indice] = nivel;
+        milisegundos_automatico [indice] = milisegundos;
+        hilos_automatico        [indice] = hilos;
+    }
+
+
+    JugadorAutomatico * JuegoMesaBase::jugadorAutomatico (LadoTablero lado) {
+        return jugadores_automaticos [reglas::indiceLado (lado)];
+    }
+
+
+    void JuegoMesaBase::grabaPartida (const string & ruta_archivo) {
+        ruta_grabacion = ruta_archivo;
+    }
+
+
+    GrabacionPartida & JuegoMesaBase::grabacion () {
+        return grabacion_;
+    }
+
+
+    uint64_t JuegoMesaBase::huellaConfiguracion () const {
+        return huella_configuracion;
+    }
+
+
+    uint64_t JuegoMesaBase::clavePosicion () {
+        reglas::EstadoPartida estado {};
+        ConversionReglas::extraeEstado (this, estado);
+        return estado.clave;
+    }
+
+
+    void JuegoMesaBase::iniciaSinVentana () {
+        inicia ();
+    }
+
+
+    void JuegoMesaBase::terminaSinVentana () {
+        termina ();
+    }
+
+
     void JuegoMesaBase::configura (SucesosJuegoComun * sucesos, ModoJuegoBase * modo) {
         this->sucesos_ = sucesos;
         this->modo_    = modo;
@@ -210,6 +282,9 @@ namespace tapete {
     void JuegoMesaBase::inicia () {
         valida_.Construccion ();
         preparaTablero ();
+        if (muros_sustitutos != nullptr) {
+            tablero_->situaMuros (* muros_sustitutos);
+        }
         valida_.Tablero ();
         preparaPersonajes ();
         valida_.Personajes ();
@@ -225,6 +300,7 @@ namespace tapete {
         valida_.EstadisticasPersonajes ();
         preparaSistemaAtaque ();
         valida_.SistemaAtaque ();
+        ataque_.compilaEfectividades ();
         configuraJuego ();
         valida_.ConfiguraJuego ();
         //
@@ -235,14 +311,58 @@ namespace tapete {
         }
         agregaActor (musica_);
         //
+        // los muros se sitúan al agregar el tablero
+        ConversionReglas::extraeReglas (this, reglas_partida);
+        motor_reglas = std::make_unique <reglas::MotorReglas> (
+                reglas_partida, ConversionReglas::modoReglas (this));
+        //
+        reglas::EstadoPartida estado_inicial {};
+        ConversionReglas::extraeEstado (this, estado_inicial);
+        // el nombre del módulo, no el de 'typeid', que cambia de un compilador a otro
+        huella_configuracion = GrabacionPartida::huellaConfiguracion (
+                reglas_partida, estado_inicial, sucesos_->modo ()->nombreModulo ());
+        if (! ruta_grabacion.empty ()) {
+            grabacion_.abre (ruta_grabacion, huella_configuracion, modo_->semillaAzar ());
+        }
+        //
+        if (automatico [0] || automatico [1]) {
+            reglas::ModoReglas modo_reglas = ConversionReglas::modoReglas (this);
+            if (modo_reglas == reglas::ModoReglas::libreDoble) {
+                throw std::logic_error {"JuegoMesaBase: el jugador automático no juega en el modo libre"};
+            }
+            for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+                int indice = reglas::indiceLado (lado);
+                if (automatico [indice] && modo_reglas == reglas::ModoReglas::equipo && 
+                        nivel_automatico [indice] != NivelAutomatico::facil) {
+                    throw std::logic_error {"JuegoMesaBase: en el modo por equipos, el jugador automático solo juega en el nivel fácil"};
+                }
+            }
+            for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+                int indice = reglas::indiceLado (lado);
+                if (automatico [indice]) {
+                    jugadores_automaticos [indice] = new JugadorAutomatico {
+                            this, lado, nivel_automatico [indice], 
+                            milisegundos_automatico [indice], hilos_automatico [indice], 
+                            modo_->semillaAzar () + indice + 1 };
+                    jugadores_automaticos [indice]->continuaPartida (automatico [0] && automatico [1]);
+                }
+            }
+        }
         sucesos_->iniciado ();
     }
 
 
     void JuegoMesaBase::termina () {
+        //
+        // antes que nada, los hilos de los jugadores automáticos
+        for (JugadorAutomatico * & jugador : jugadores_automaticos) {
+            delete jugador;
+            jugador = nullptr;
+        }
         //
         sucesos_->terminado ();
         sucesos_ = nullptr;
+        grabacion_.cierra ();
         //
         for (const TipoAtaque * tipo : ataques_) {
             delete tipo;
@@ -293,17 +413,26 @@ namespace tapete {
     void JuegoMesaBase::posactualiza (double tiempo_seg) {
         controlTeclado ();
         controlTiempo  ();
+        for (JugadorAutomatico * jugador : jugadores_automaticos) {
+            if (jugador != nullptr) {
+                jugador->actualiza ();
+            }
+        }
     }
 
 
     void JuegoMesaBase::controlTeclado () {
         if (unir2d::Teclado::pulsando (unir2d::Tecla::espacio)) {
+            grabacion_.anota (GrabacionPartida::Suceso::pulsadoEspacio);
             sucesos_->pulsadoEspacio ();
         } else if (unir2d::Teclado::pulsando (unir2d::Tecla::escape)) {
+            grabacion_.anota (GrabacionPartida::Suceso::pulsadoEscape);
             sucesos_->pulsadoEscape ();
         } else if (unir2d::Teclado::pulsando (unir2d::Tecla::arriba)) {
+            grabacion_.anota (GrabacionPartida::Suceso::pulsadoArriba);
             sucesos_->pulsadoArriba ();
         } else if (unir2d::Teclado::pulsando (unir2d::Tecla::abajo)) {
+            grabacion_.anota (GrabacionPartida::Suceso::pulsadoAbajo);
             sucesos_->pulsadoAbajo ();
         }
     }
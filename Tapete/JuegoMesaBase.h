@@ -9,6 +9,20 @@
 namespace tapete {
 
 
+    class JugadorAutomatico;
+
+
+    // cómo busca sus jugadas un 'JugadorAutomatico'
+    enum class NivelAutomatico {
+        // 'reglas::PoliticaUtilidad', sin búsqueda
+        facil,
+        // 'reglas::BusquedaMonteCarlo'
+        normal,
+        // 'reglas::BusquedaExpectimax'
+        dificil,
+    };
+
+
     class JuegoMesaBase : public unir2d::JuegoBase {
     public:
 
@@ -32,8 +46,45 @@ namespace tapete {
         ModoJuegoBase *     modo ();  
         SistemaAtaque     & sistemaAtaque ();
 
+        // las reglas sin presentación, extraídas al iniciar el juego
+        const reglas::ReglasPartida & reglasPartida () const;
+        // el motor de esas reglas, en el modo de este juego (véase 'ConversionReglas::modoReglas')
+        const reglas::MotorReglas &   motorReglas () const;
+
+        // instantánea de la partida entre dos jugadas, para deshacerlas o para ensayarlas
+        void captura  (InstantaneaPartida & instantanea);
+        void restaura (const InstantaneaPartida & instantanea);
+
         unir2d::Tiempo & tiempoCalculo ();
 
+        // graba la partida en 'ruta_archivo'; se llama antes de iniciar el juego (por ejemplo, en 
+        // 'configuraJuego'). Véase: 'GrabacionPartida'
+        void grabaPartida (const string & ruta_archivo);
+        GrabacionPartida & grabacion ();
+
+        // véase: 'GrabacionPartida::huellaConfiguracion', calculada al iniciar el juego
+        uint64_t huellaConfiguracion () const;
+        // la clave de Zobrist del estado de la partida en las reglas 
+        // ('reglas::EstadoPartida::clave'), la misma que usan las búsquedas; la grabación la 
+        // anota al final de cada jugada
+        uint64_t clavePosicion ();
+
+        // sustituye los muros que sitúa 'preparaTablero' por otros (por ejemplo, para jugar un 
+        // torneo en todos los mapas); se llama antes de iniciar el juego
+        void sustituyeMuros (const ActorTablero::GraficoMuros & grafico_muros);
+
+        // el lado lo juega un 'JugadorAutomatico' que piensa 'milisegundos' cada jugada; en el modo 
+        // por parejas o, solo con el nivel fácil, en el modo por equipos. Se llama antes de iniciar 
+        // el juego (por ejemplo, en 'configuraJuego')
+        void juegaAutomatico (LadoTablero lado, NivelAutomatico nivel, int milisegundos, int hilos = 1);
+        // nulo si el lado no es automático (o el juego no se ha iniciado)
+        JugadorAutomatico * jugadorAutomatico (LadoTablero lado);
+
+        // el juego sin 'unir2d::Motor', para repetir o simular partidas desde la consola; nadie 
+        // llama a 'actualiza', así que los sucesos se entregan directamente a 'sucesos ()'
+        void iniciaSinVentana ();
+        void terminaSinVentana ();
+
     protected:
 
         static string carpeta_activos_comun;
@@ -92,8 +143,23 @@ namespace tapete {
         ModoJuegoBase *     modo_ {};
         SistemaAtaque       ataque_  {this};
 
+        reglas::ReglasPartida                 reglas_partida {};
+        std::unique_ptr <reglas::MotorReglas> motor_reglas {};
+
         unir2d::Tiempo tiempo_calculo {};
 
+        const ActorTablero::GraficoMuros * muros_sustitutos {};
+
+        string           ruta_grabacion {};
+        GrabacionPartida grabacion_ {};
+        uint64_t         huella_configuracion {};
+
+        std::array <bool, 2>                automatico {};
+        std::array <NivelAutomatico, 2>     nivel_automatico {};
+        std::array <int, 2>                 milisegundos_automatico {};
+        std::array <int, 2>                 hilos_automatico {};
+        std::array <JugadorAutomatico *, 2> jugadores_automaticos {};
+
 
         void regionVentana (Vector & posicion, Vector & tamano) const override;
 
@@ -0,0 +1,302 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   JugadorAutomatico.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    using Suceso = GrabacionPartida::Suceso;
+
+
+    JugadorAutomatico::JugadorAutomatico (
+            JuegoMesaBase *  juego, 
+            LadoTablero      lado, 
+            NivelAutomatico  nivel, 
+            int              milisegundos, 
+            int              hilos, 
+            uint64_t         semilla      ) :
+        juego_ {juego}, 
+        lado_ {lado}, 
+        nivel_ {nivel}, 
+        motor {juego->reglasPartida (), ConversionReglas::modoReglas (juego)}, 
+        // las alarmas del cálculo de los ataques llegan en los fotogramas siguientes
+        entrega {juego, false} {
+        assert (lado != LadoTablero::nulo);
+        assert (motor.modo () == reglas::ModoReglas::pares || nivel == NivelAutomatico::facil);
+        switch (nivel) {
+        case NivelAutomatico::facil:
+            utilidad = std::make_unique <reglas::PoliticaUtilidad> ();
+            azar.siembra (semilla);
+            break;
+        case NivelAutomatico::normal: {
+            reglas::BusquedaMonteCarlo::Configuracion configuracion {};
+            configuracion.milisegundos = milisegundos;
+            configuracion.hilos        = hilos;
+            configuracion.semilla      = semilla;
+            montecarlo = std::make_unique <reglas::BusquedaMonteCarlo> (motor, configuracion);
+            break;
+        }
+        case NivelAutomatico::dificil: {
+            reglas::BusquedaExpectimax::Configuracion configuracion {};
+            configuracion.milisegundos = milisegundos;
+            expectimax = std::make_unique <reglas::BusquedaExpectimax> (motor, configuracion);
+            break;
+        }
+        }
+    }
+
+
+    JugadorAutomatico::~JugadorAutomatico () {
+        if (hilo.joinable ()) {
+            detener = true;
+            hilo.join ();
+        }
+    }
+
+
+    LadoTablero JugadorAutomatico::lado () const {
+        return lado_;
+    }
+
+
+    NivelAutomatico JugadorAutomatico::nivel () const {
+        return nivel_;
+    }
+
+
+    void JugadorAutomatico::continuaPartida (bool continua) {
+        continua_partida = continua;
+    }
+
+
+    bool JugadorAutomatico::pensando () const {
+        return hilo.joinable ();
+    }
+
+
+    int JugadorAutomatico::rechazos () const {
+        return rechazos_;
+    }
+
+
+    const reglas::BusquedaMonteCarlo::Resultado & JugadorAutomatico::resultadoMonteCarlo () const {
+        return resultado_montecarlo;
+    }
+
+
+    const reglas::BusquedaExpectimax::Resultado & JugadorAutomatico::resultadoExpectimax () const {
+        return resultado_expectimax;
+    }
+
+
+    void JugadorAutomatico::actualiza () {
+        if (rechazos_ > 0) {
+            return;
+        }
+        if (hilo.joinable ()) {
+            if (terminada) {
+                recogeBusqueda ();
+            }
+            return;
+        }
+        if (juego_->tiempoCalculo ().iniciado ()) {
+            return;
+        }
+        if (siguiente < pendientes.size ()) {
+            entregaSiguiente ();
+            return;
+        }
+        decide ();
+    }
+
+
+    void JugadorAutomatico::decide () {
+        ModoJuegoComun * modo = juego_->sucesos ()->modo ();
+        if (motor.modo () == reglas::ModoReglas::equipo) {
+            decideEquipo ();
+            return;
+        }
+        switch (modo->estado ()) {
+        case EstadoJuegoPares::inicioRonda:
+        case EstadoJuegoPares::inicioTurnoConfirmacion:
+        case EstadoJuegoPares::agotadosPuntosAccion:
+        case EstadoJuegoPares::finalTurno:
+            // en el acto: si los dos lados son automáticos, el otro ya ve el estado siguiente
+            if (confirma ()) {
+                entrega.entrega ({Suceso::pulsadoEspacio});
+            }
+            break;
+        case EstadoJuegoPares::inicioTurnoNoElegidos:
+        case EstadoJuegoPares::inicioTurnoElegidoUno:
+        case EstadoJuegoComun::inicioJugada:
+            buscaJugada ();
+            break;
+        }
+    }
+
+
+    // los códigos de los estados propios de cada modo coinciden: 'EstadoJuegoEquipo::inicioTurno'
+    // es 'EstadoJuegoPares::inicioTurnoNoElegidos'
+    void JugadorAutomatico::decideEquipo () {
+        switch (juego_->sucesos ()->modo ()->estado ()) {
+        case EstadoJuegoEquipo::inicioRonda:
+        case EstadoJuegoEquipo::inicioTurno:
+            if (continua_partida) {
+                entrega.entrega ({Suceso::pulsadoEspacio});
+            }
+            break;
+        case EstadoJuegoComun::inicioJugada:
+            buscaJugada ();
+            break;
+        }
+    }
+
+
+    void JugadorAutomatico::buscaJugada () {
+        reglas::EstadoPartida estado {};
+        ConversionReglas::extraeEstado (juego_, estado);
+        if (motor.terminada (estado) || motor.ladoDecide (estado) != lado_) {
+            return;
+        }
+        if (utilidad != nullptr) {
+            // unos microsegundos: no hace falta el hilo
+            motor.generaJugadas (estado, jugadas);
+            traduce (jugadas [utilidad->elige (motor, estado, jugadas, azar)]);
+        } else {
+            lanzaBusqueda (estado);
+        }
+    }
+
+
+    bool JugadorAutomatico::confirma () const {
+        ModoJuegoBase * modo = juego_->modo ();
+        switch (juego_->sucesos ()->modo ()->estado ()) {
+        case EstadoJuegoPares::agotadosPuntosAccion:
+        case EstadoJuegoPares::finalTurno:
+            // quien ha hecho la última jugada; el atacante es ahora el otro
+            return continua_partida || opuesto (modo->atacante ()->ladoTablero ()) == lado_;
+        default:
+            return continua_partida;
+        }
+    }
+
+
+    void JugadorAutomatico::lanzaBusqueda (const reglas::EstadoPartida & estado) {
+        assert (! hilo.joinable ());
+        clave_buscada = estado.clave;
+        terminada = false;
+        detener   = false;
+        hilo = std::thread {[this, estado] {
+            if (montecarlo != nullptr) {
+                resultado_montecarlo = montecarlo->busca (estado, & detener);
+                jugada_buscada       = resultado_montecarlo.jugada;
+            } else {
+                resultado_expectimax = expectimax->busca (estado, & detener);
+                jugada_buscada       = resultado_expectimax.jugada;
+            }
+            terminada = true;
+        }};
+    }
+
+
+    void JugadorAutomatico::recogeBusqueda () {
+        hilo.join ();
+        // si la partida ha cambiado mientras tanto (el otro jugador ha pulsado algo), la jugada 
+        // ya no vale; se buscará otra en el fotograma siguiente
+        reglas::EstadoPartida estado {};
+        ConversionReglas::extraeEstado (juego_, estado);
+        if (estado.clave != clave_buscada) {
+            return;
+        }
+        traduce (jugada_buscada);
+    }
+
+
+    // las decisiones que llevan a la jugada desde 'inicioTurnoNoElegidos', 
+    // 'inicioTurnoElegidoUno' o 'inicioJugada'
+    void JugadorAutomatico::traduce (const reglas::Jugada & jugada) {
+        using reglas::TipoJugada;
+        pendientes.clear ();
+        siguiente = 0;
+        int indice_lado = reglas::indiceLado (lado_);
+        switch (jugada.tipo) {
+        case TipoJugada::elige:
+            pendientes.push_back ({Suceso::personajeSeleccionado, jugada.personaje});
+            return;
+        case TipoJugada::desplaza:
+            pendientes.push_back ({Suceso::actuanteSeleccionado, indice_lado});
+            pendientes.push_back ({Suceso::fichaPulsada, jugada.personaje});
+            pendientes.push_back ({Suceso::celdaPulsada, jugada.celda});
+            pendientes.push_back ({Suceso::pulsadoEspacio});
+            return;
+        case TipoJugada::cede:
+            // 'espacio' en 'inicioJugada' cede los puntos del atacante bloqueado; el modo por 
+            // equipos no lo admite y el juego rechaza la decisión
+            pendientes.push_back ({Suceso::pulsadoEspacio});
+            return;
+        default:
+            break;
+        }
+        // habilidades: el índice es el del panel del atacante
+        const std::vector <Habilidad *> & habilidades = juego_->personajes () [jugada.personaje]->habilidades ();
+        int indice_habilidad = 0;
+        while (indice_habilidad < habilidades.size () && habilidades [indice_habilidad]->indice () != jugada.habilidad) {
+            indice_habilidad ++;
+        }
+        assert (indice_habilidad < habilidades.size ());
+        pendientes.push_back ({Suceso::habilidadSeleccionada, indice_lado, indice_habilidad});
+        if (jugada.tipo == TipoJugada::habilidadOponente) {
+            pendientes.push_back ({Suceso::personajeSeleccionado, jugada.objetivo});
+        } else if (jugada.tipo == TipoJugada::habilidadArea) {
+            pendientes.push_back ({Suceso::celdaSeleccionada, jugada.celda});
+        }
+        // confirmación y resultado
+        pendientes.push_back ({Suceso::pulsadoEspacio});
+        pendientes.push_back ({Suceso::pulsadoEspacio});
+    }
+
+
+    void JugadorAutomatico::entregaSiguiente () {
+        ModoJuegoComun * modo = juego_->sucesos ()->modo ();
+        int              estado_previo   = modo->estado ();
+        size_t           etapas_previo   = modo->etapasCamino ().size ();
+        ActorPersonaje * atacante_previo = modo->atacante ();
+        bool             entregada       = entrega.entrega (pendientes [siguiente]);
+        siguiente ++;
+        // toda decisión de una jugada cambia el estado, salvo fijar una etapa del camino y 
+        // ceder los puntos, que puede volver a 'inicioJugada' con el otro atacante
+        bool aceptada = entregada && 
+                        (modo->estado () != estado_previo || modo->etapasCamino ().size () != etapas_previo ||
+                         modo->atacante () != atacante_previo);
+        switch (modo->estado ()) {
+        case EstadoJuegoComun::habilidadSimpleInvalida:
+        case EstadoJuegoComun::oponenteHabilidadInvalido:
+        case EstadoJuegoComun::areaHabilidadInvalida:
+            aceptada = false;
+            break;
+        }
+        if (aceptada) {
+            return;
+        }
+        switch (modo->estado ()) {
+        case EstadoJuegoComun::marcacionCaminoFicha:
+        case EstadoJuegoComun::habilidadSimpleInvalida:
+        case EstadoJuegoComun::habilidadSimpleConfirmacion:
+        case EstadoJuegoComun::oponenteHabilidadInvalido:
+        case EstadoJuegoComun::oponenteHabilidadConfirmacion:
+        case EstadoJuegoComun::areaHabilidadInvalida:
+        case EstadoJuegoComun::areaHabilidadConfirmacion:
+            entrega.entrega ({Suceso::pulsadoEscape});
+            break;
+        }
+        pendientes.clear ();
+        siguiente = 0;
+        rechazos_ ++;
+    }
+
+
+}
@@ -0,0 +1,96 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  JugadorAutomatico.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Juega un lado del tablero en el modo por parejas o, con el nivel fácil, en el modo por 
+    // equipos. Cuando le toca decidir, busca la jugada 
+    // según el nivel ('NivelAutomatico') en un hilo aparte (el juego sigue dibujándose; el nivel 
+    // fácil decide en el acto) y después la entrega, una decisión por fotograma, como lo haría el 
+    // ratón: se anota en la grabación y 
+    // la partida se puede repetir sin el jugador automático. En el modo por equipos solo decide la 
+    // jugada del personaje al que le toca según los factores (véase: 'ModoJuegoEquipo'). 
+    // Solo confirma el inicio de las rondas y de los turnos si juega contra otro automático; si 
+    // no, espera al jugador humano. Si el juego rechaza una decisión, la revierte y deja de jugar
+    // (véase: 'rechazos'). Tampoco juega cuando un lado se ha quedado sin personajes vivos: la 
+    // partida está decidida ('reglas::MotorReglas::terminada').
+    class JugadorAutomatico {
+    public:
+
+        // 'milisegundos' no cuenta en el nivel fácil; 'hilos', solo en el normal
+        JugadorAutomatico (
+                JuegoMesaBase *  juego, 
+                LadoTablero      lado, 
+                NivelAutomatico  nivel, 
+                int              milisegundos, 
+                int              hilos, 
+                uint64_t         semilla      );
+        ~JugadorAutomatico ();
+
+        LadoTablero     lado () const;
+        NivelAutomatico nivel () const;
+
+        // confirma también lo que corresponde al jugador del otro lado (ambos automáticos)
+        void continuaPartida (bool continua);
+
+        // en cada fotograma, después de los controles del juego
+        void actualiza ();
+
+        bool pensando () const;
+        int  rechazos () const;
+
+        // de la última búsqueda, según el nivel
+        const reglas::BusquedaMonteCarlo::Resultado & resultadoMonteCarlo () const;
+        const reglas::BusquedaExpectimax::Resultado & resultadoExpectimax () const;
+
+    private:
+
+        JuegoMesaBase * juego_;
+        LadoTablero     lado_;
+        NivelAutomatico nivel_;
+
+        reglas::MotorReglas                         motor;
+        std::unique_ptr <reglas::PoliticaUtilidad>   utilidad {};
+        std::unique_ptr <reglas::BusquedaMonteCarlo> montecarlo {};
+        std::unique_ptr <reglas::BusquedaExpectimax> expectimax {};
+        reglas::GeneradorAzar                       azar {};
+        std::vector <reglas::Jugada>                jugadas {};
+        EntregaSucesos                              entrega;
+
+        std::thread                           hilo {};
+        std::atomic <bool>                    terminada {};
+        std::atomic <bool>                    detener {};
+        uint64_t                              clave_buscada {};
+        reglas::Jugada                        jugada_buscada {};
+        reglas::BusquedaMonteCarlo::Resultado resultado_montecarlo {};
+        reglas::BusquedaExpectimax::Resultado resultado_expectimax {};
+
+        // decisiones de la jugada en curso, por entregar
+        std::vector <GrabacionPartida::Registro> pendientes {};
+        int                                      siguiente {};
+
+        bool continua_partida {};
+        int  rechazos_ {};
+
+
+        void decide ();
+        void decideEquipo ();
+        void buscaJugada ();
+        void lanzaBusqueda (const reglas::EstadoPartida & estado);
+        void recogeBusqueda ();
+        void traduce (const reglas::Jugada & jugada);
+        void entregaSiguiente ();
+
+        // si le corresponde pulsar el espacio en el estado en curso
+        bool confirma () const;
+
+    };
+
+
+}
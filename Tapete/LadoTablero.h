@@ -9,21 +9,9 @@
 namespace tapete {
 
 
-    enum class LadoTablero {
-        Izquierda,
-        Derecha,
-        nulo
-    };
-
-
-    inline LadoTablero opuesto (LadoTablero lado) {
-        assert (lado != LadoTablero::nulo);
-        if (lado == LadoTablero::Izquierda) {
-            return LadoTablero::Derecha;
-        } else {
-            return LadoTablero::Izquierda;
-        }
-    }
+    // el lado es parte de las reglas; véase 'reglas::LadoTablero'
+    using LadoTablero = reglas::LadoTablero;
+    using reglas::opuesto;
 
 }
 
@@ -0,0 +1,117 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   MatrizAmenazas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    void MatrizAmenazas::calcula (JuegoMesaBase * juego) {
+        personajes = juego->personajes ();
+        int cuenta_personajes = static_cast <int> (personajes.size ());
+        //
+        primera_fila  .clear ();
+        habilidad_fila.clear ();
+        for (ActorPersonaje * persj : personajes) {
+            primera_fila.push_back (static_cast <int> (habilidad_fila.size ()));
+            for (Habilidad * habil : persj->habilidades ()) {
+                habilidad_fila.push_back (habil);
+            }
+        }
+        amenazas.assign (habilidad_fila.size () * cuenta_personajes, Amenaza {});
+        //
+        for (int indc_ataca = 0; indc_ataca < cuenta_personajes; ++ indc_ataca) {
+            Coord sitio_ataca = personajes [indc_ataca]->sitioFicha ();
+            for (int indc_opone = 0; indc_opone < cuenta_personajes; ++ indc_opone) {
+                if (indc_opone == indc_ataca) {
+                    continue;
+                }
+                Coord sitio_opone = personajes [indc_opone]->sitioFicha ();
+                int  distn = GeometriaHexagonal::distancia (sitio_opone, sitio_ataca);
+                // la línea se comprueba una sola vez para todas las habilidades directas
+                bool linea_calculada = false;
+                bool linea_libre     = false;
+                int  ultima_fila = primera_fila [indc_ataca] + 
+                                   static_cast <int> (personajes [indc_ataca]->habilidades ().size ());
+                for (int fila = primera_fila [indc_ataca]; fila < ultima_fila; ++ fila) {
+                    Habilidad * habil = habilidad_fila [fila];
+                    Amenaza & amenaza = amenazas [fila * cuenta_personajes + indc_opone];
+                    amenaza.en_alcance = distn <= habil->alcance ();
+                    if (! amenaza.en_alcance || habil->tipoAcceso () != AccesoHabilidad::directo) {
+                        continue;
+                    }
+                    if (! linea_calculada) {
+                        linea_libre     = CalculoCaminos::segmentoValido (juego, sitio_ataca, sitio_opone);
+                        linea_calculada = true;
+                    }
+                    amenaza.linea_libre = linea_libre;
+                }
+            }
+        }
+        //
+        cambios_ocupacion = juego->tablero ()->ocupacion ().cambios ();
+        vigente_ = true;
+    }
+
+
+    void MatrizAmenazas::invalida () {
+        vigente_ = false;
+    }
+
+
+    bool MatrizAmenazas::vigente (JuegoMesaBase * juego) const {
+        return vigente_ && cambios_ocupacion == juego->tablero ()->ocupacion ().cambios ();
+    }
+
+
+    bool MatrizAmenazas::consulta (
+            const ActorPersonaje * atacante, 
+            const Habilidad *      habilidad, 
+            const ActorPersonaje * objetivo, 
+            bool &                 accesible  ) const {
+        if (! vigente_ || atacante == objetivo) {
+            return false;
+        }
+        int indc_ataca = indicePersonaje (atacante);
+        int indc_opone = indicePersonaje (objetivo);
+        if (indc_ataca < 0 || indc_opone < 0) {
+            return false;
+        }
+        const std::vector <Habilidad *> & habilidades = atacante->habilidades ();
+        for (int indc_habil = 0; indc_habil < habilidades.size (); ++ indc_habil) {
+            if (habilidades [indc_habil] == habilidad) {
+                accesible = this->accesible (indc_ataca, primera_fila [indc_ataca] + indc_habil, indc_opone);
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    int MatrizAmenazas::indicePersonaje (const ActorPersonaje * personaje) const {
+        for (int indc = 0; indc < personajes.size (); ++ indc) {
+            if (personajes [indc] == personaje) {
+                return indc;
+            }
+        }
+        return -1;
+    }
+
+
+    bool MatrizAmenazas::accesible (int indice_atacante, int fila, int indice_objetivo) const {
+        const Amenaza & amenaza = amenazas [fila * personajes.size () + indice_objetivo];
+        const Habilidad * habil = habilidad_fila [fila];
+        if (! amenaza.en_alcance) {
+            return false;
+        }
+        if (habil->tipoAcceso () == AccesoHabilidad::directo && ! amenaza.linea_libre) {
+            return false;
+        }
+        return habil->coste () <= personajes [indice_atacante]->puntosAccion ();
+    }
+
+
+}
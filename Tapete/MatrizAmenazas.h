@@ -0,0 +1,59 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  MatrizAmenazas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    class JuegoMesaBase;
+
+
+    // Para cada personaje, cada una de sus habilidades y cada posible objetivo: si el objetivo está 
+    // al alcance y, en las habilidades de acceso directo, si la línea hasta él está libre. Es lo que
+    // comprueba 'ModoJuegoBase::validaAtaqueOponente', calculado de una vez para todos los pares. 
+    // Solo depende de los sitios de las fichas, así que sigue vigente mientras no cambie la ocupación
+    // del tablero. Los puntos de acción se comparan al consultar, porque cambian con cada acción.
+    class MatrizAmenazas {
+    public:
+
+        void calcula (JuegoMesaBase * juego);
+        void invalida ();
+
+        bool vigente (JuegoMesaBase * juego) const;
+
+        // Devuelve falso si la combinación no está en la matriz (el atacante es el objetivo, o alguno
+        // no es conocido); si está, 'accesible' es el resultado de la validación.
+        bool consulta (
+                const ActorPersonaje * atacante, 
+                const Habilidad *      habilidad, 
+                const ActorPersonaje * objetivo, 
+                bool &                 accesible ) const;
+
+    private:
+
+        struct Amenaza {
+            bool en_alcance  {};
+            bool linea_libre {};
+        };
+
+        bool vigente_ {};
+        int  cambios_ocupacion {};
+
+        std::vector <ActorPersonaje *> personajes {};
+        // las filas de la matriz: una por cada habilidad de cada personaje
+        std::vector <int>              primera_fila {};
+        std::vector <Habilidad *>      habilidad_fila {};
+        // fila * cuenta de personajes + objetivo
+        std::vector <Amenaza>          amenazas {};
+
+        int indicePersonaje (const ActorPersonaje * personaje) const;
+        bool accesible (int indice_atacante, int fila, int indice_objetivo) const;
+
+    };
+
+
+}
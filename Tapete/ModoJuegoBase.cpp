@@ -13,6 +13,7 @@ namespace tapete {
         this->juego_ = juego;
         lado_equipo_inicial = LadoTablero::nulo;
         lado_equipo_actual  = LadoTablero::nulo;
+        siembraAzar (reglas::GeneradorAzar::semillaSistema ());
     }
 
 
@@ -63,6 +64,20 @@ namespace tapete {
     //----------------------------------------------------------------------------------------------
 
 
+    void ModoJuegoBase::siembraAzar (uint64_t semilla) {
+        azar_partida.siembra (semilla, 1);
+        azar_vistoso.siembra (semilla, 2);
+    }
+
+
+    uint64_t ModoJuegoBase::semillaAzar () const {
+        return azar_partida.semilla ();
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
     LadoTablero ModoJuegoBase::ladoEquipoInicial () const {
         return lado_equipo_inicial;
     }
@@ -118,6 +133,16 @@ namespace tapete {
     }
 
 
+    const AlcanceDesplaza & ModoJuegoBase::alcanceDesplaza () const {
+        return alcance_desplaza;
+    }
+
+
+    const MatrizAmenazas & ModoJuegoBase::matrizAmenazas () const {
+        return matriz_amenazas;
+    }
+
+
     Habilidad * ModoJuegoBase::habilidadAccion () const {
         return habilidad_accion;
     }
@@ -159,6 +184,8 @@ namespace tapete {
         ronda_  = 1;
         turno_  = 1;
         jugada_ = 1;
+        matriz_amenazas.invalida ();
+        juego_->grabacion ().anotaRonda (ronda_);
         if (trazar_avance) {
             std::cout << std::endl;
             std::cout << "Ronda = "  << ronda_  << "  ";
@@ -169,6 +196,7 @@ namespace tapete {
 
 
     void ModoJuegoBase::avanzaJugada () {
+        anotaJugada ();
         jugada_ ++;
         if (trazar_avance) {
             std::cout << std::endl;
@@ -180,8 +208,10 @@ namespace tapete {
 
 
     void ModoJuegoBase::avanzaTurno () {
+        anotaJugada ();
         turno_ ++;
         jugada_ = 1;
+        matriz_amenazas.invalida ();
         if (trazar_avance) {
             std::cout << std::endl;
             std::cout << "Ronda = "  << ronda_  << "  ";
@@ -192,10 +222,14 @@ namespace tapete {
 
 
     void ModoJuegoBase::avanzaRonda () {
+        anotaJugada ();
         restauraPersonajes ();
         ronda_ ++;
         turno_ = 1;
         jugada_ = 1;
+        matriz_amenazas.invalida ();
+        // el hilo escritor de la grabación vuelca la ronda terminada
+        juego_->grabacion ().anotaRonda (ronda_);
         if (trazar_avance) {
             std::cout << std::endl;
             std::cout << "Ronda = "  << ronda_  << "  ";
@@ -205,6 +239,14 @@ namespace tapete {
     }
 
 
+    // la huella del estado en que queda la partida al terminar la jugada, antes de avanzar 
+    void ModoJuegoBase::anotaJugada () {
+        if (juego_->grabacion ().activa ()) {
+            juego_->grabacion ().anotaJugada (juego_->clavePosicion ());
+        }
+    }
+
+
     //----------------------------------------------------------------------------------------------
 
 
@@ -245,7 +287,8 @@ namespace tapete {
             return LadoTablero::Derecha;
         }
         //
-        uint32_t azar = azarosa (2);
+        int azar = azar_partida.entero (2);
+        juego_->grabacion ().anota (GrabacionPartida::Suceso::tirada, azar, 2);
         if (azar == 0) {
             return LadoTablero::Izquierda;
         } else {
@@ -365,7 +408,8 @@ namespace tapete {
             return LadoTablero::Derecha;
         }
         //
-        uint32_t azar = azarosa (2);
+        int azar = azar_partida.entero (2);
+        juego_->grabacion ().anota (GrabacionPartida::Suceso::tirada, azar, 2);
         if (azar == 0) {
             return LadoTablero::Izquierda;
         } else {
@@ -383,7 +427,7 @@ namespace tapete {
         //
         atacante_        = personajeElegido (lado_tablero);
         modo_accion      = ModoAccionPersonaje::Nulo;
-        etapas_camino    .clear ();
+        vaciaEtapasCamino ();
         habilidad_accion = nullptr;
         oponente_        = nullptr; 
         area_celdas      .clear ();
@@ -412,7 +456,7 @@ namespace tapete {
         area_celdas      .clear ();
         oponente_        = nullptr; 
         habilidad_accion = nullptr;
-        etapas_camino    .clear ();
+        vaciaEtapasCamino ();
         modo_accion      = ModoAccionPersonaje::Nulo; 
         //
         PresenciaActuante & presnc_opone = juego_->tablero ()->presencia (opuesto (atacante_->ladoTablero ()));
@@ -434,7 +478,7 @@ namespace tapete {
         area_celdas      .clear ();
         oponente_        = nullptr; 
         habilidad_accion = nullptr;
-        etapas_camino    .clear ();
+        vaciaEtapasCamino ();
         modo_accion      = ModoAccionPersonaje::Nulo; 
         //
         PresenciaActuante & presnc_opone = juego_->tablero ()->presencia (opuesto (atacante_->ladoTablero ()));
@@ -471,6 +515,7 @@ namespace tapete {
         //
         modo_accion      = ModoAccionPersonaje::Habilidad;
         habilidad_accion = atacante_->habilidades () [indice_habilidad];
+        desombreaAlcance ();
         //
         PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (atacante_->ladoTablero ());
         presnc_ataca.marcaHabilidad (indice_habilidad);
@@ -483,6 +528,7 @@ namespace tapete {
         //
         PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (atacante_->ladoTablero ());
         presnc_ataca.desmarcaRetratoHabilidad ();
+        desombreaAlcance ();
         //
         habilidad_accion = nullptr;
         modo_accion      = ModoAccionPersonaje::Nulo;
@@ -527,11 +573,37 @@ namespace tapete {
         aserta (modo_accion == ModoAccionPersonaje::Desplazamiento,
                                                 "iniciaCamino", "modo de acción inválido");
         //
-        etapas_camino.push_back (atacante_->sitioFicha ());
+        apilaEtapaCamino (atacante_->sitioFicha ());
         juego_->tablero ()->vistaCamino ().arrancaCamino ();
     }
 
 
+    void ModoJuegoBase::calculaAlcanceDesplaza () {
+        // solo usado en 'ModoJuegoComun'
+        //
+        aserta (atacante_ != nullptr,           "calculaAlcanceDesplaza", "atacante no asignado");
+        aserta (atacante_->puntosAccion () > 0, "calculaAlcanceDesplaza", "atacante agotado");
+        aserta (modo_accion == ModoAccionPersonaje::Desplazamiento,
+                                                "calculaAlcanceDesplaza", "modo de acción inválido");
+        //
+        // antes de iniciar el camino, su única etapa será el sitio de la ficha
+        if (etapas_camino.size () == 0) {
+            alcance_desplaza.calcula (juego_, { atacante_->sitioFicha () }, atacante_->puntosAccion ());
+        } else {
+            alcance_desplaza.calcula (juego_, etapas_camino, atacante_->puntosAccion ());
+        }
+        sombreaAlcance ();
+    }
+
+
+    void ModoJuegoBase::actualizaMatrizAmenazas () {
+        // se calcula al primer uso tras cambiar el turno o la ocupación del tablero
+        if (! matriz_amenazas.vigente (juego_)) {
+            matriz_amenazas.calcula (juego_);
+        }
+    }
+
+
     void ModoJuegoBase::validaEtapaCamino (
             Coord proxima_celda, bool & etapa_valida, int & puntos_en_juego) {
         // solo usado en 'ModoJuegoComun'
@@ -545,20 +617,17 @@ namespace tapete {
             etapa_valida = false;
             return;
         }
-        if (CalculoCaminos::celdaOcupada (juego_, proxima_celda)) {
-            etapa_valida = false;
-            return;
-        }
-        if (! CalculoCaminos::etapaValidaCamino (juego_, proxima_celda)) {
-            etapa_valida = false;
-            return;
-        }
         //
-        puntos_en_juego = puntosEnJuegoCamino (proxima_celda);
-        if (puntos_en_juego > atacante_->puntosAccion ()) {
+        // el alcance se recalcula solo si ha cambiado el camino o se ha movido algún personaje
+        if (! alcance_desplaza.vigente (etapas_camino, atacante_->puntosAccion ())) {
+            calculaAlcanceDesplaza ();
+        }
+        int punts = alcance_desplaza.puntos (proxima_celda);
+        if (punts == AlcanceDesplaza::inalcanzable) {
             etapa_valida = false;
             return;
         }
+        puntos_en_juego = punts;
         etapa_valida = true;
     }
 
@@ -596,7 +665,7 @@ namespace tapete {
         aserta (modo_accion == ModoAccionPersonaje::Desplazamiento,
                                                 "agregaEtapaCamino", "modo de acción inválido");
         //
-        etapas_camino.push_back (proxima_celda);
+        apilaEtapaCamino (proxima_celda);
         juego_->tablero ()->vistaCamino ().fijaCeldaEtapa ();
         //
         atacante_->ponPuntosAccionEnJuego (puntos_en_juego);
@@ -606,6 +675,41 @@ namespace tapete {
     }
 
 
+    bool ModoJuegoBase::agregaCaminoOptimo (Coord celda_destino) {
+        // solo usado en 'ModoJuegoComun'
+        //
+        aserta (atacante_ != nullptr,           "agregaCaminoOptimo", "atacante no asignado");
+        aserta (atacante_->puntosAccion () > 0, "agregaCaminoOptimo", "atacante agotado");
+        aserta (modo_accion == ModoAccionPersonaje::Desplazamiento,
+                                                "agregaCaminoOptimo", "modo de acción inválido");
+        //
+        if (! CalculoCaminos::celdaEnTablero (celda_destino) || etapas_camino.back () == celda_destino) {
+            return false;
+        }
+        std::vector <Coord> etapas {};
+        int puntos_en_juego;
+        if (! CalculoCaminos::caminoOptimo (
+                juego_, etapas_camino, celda_destino, atacante_->puntosAccion (), etapas, puntos_en_juego)) {
+            return false;
+        }
+        // la celda pulsada está marcada como inválida; cada etapa se marca y se fija como si se 
+        // hubiera pulsado
+        VistaCaminoCeldas & vista_camino = juego_->tablero ()->vistaCamino ();
+        vista_camino.desmarcaCeldaEtapa ();
+        for (const Coord & etapa : etapas) {
+            vista_camino.marcaCeldaEtapa (etapa, true, etapas_camino.back ());
+            vista_camino.fijaCeldaEtapa ();
+            apilaEtapaCamino (etapa);
+        }
+        //
+        atacante_->ponPuntosAccionEnJuego (puntos_en_juego);
+        LadoTablero lado_ataca = atacante_->ladoTablero ();
+        PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (lado_ataca);
+        presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), puntos_en_juego);
+        return true;
+    }
+
+
     void ModoJuegoBase::mueveFichaCamino () {
         aserta (atacante_ != nullptr,           "mueveFichaCamino", "atacante no asignado");
         aserta (atacante_->puntosAccion () > 0, "mueveFichaCamino", "atacante agotado");
@@ -613,24 +717,23 @@ namespace tapete {
                                                 "mueveFichaCamino", "modo de acción erroneo");
         aserta (etapas_camino.size () > 0,      "mueveFichaCamino", "no hay etapas en el camino");
         //
-        juego_->tablero ()->rejilla ().desmarcaCelda (atacante_->sitioFicha ());
-        Coord nuevo_sitio = etapas_camino.back ();
-        atacante_->ponSitioFicha (nuevo_sitio);
-        etapas_camino.clear ();
-        juego_->tablero ()->vistaCamino ().vaciaCamino ();
-        juego_->tablero ()->rejilla ().marcaCelda (atacante_->sitioFicha (), ModoJuegoBase::color_atacante, false);
-        atacante_->ponPuntosAccion (atacante_->puntosAccion () - atacante_->puntosAccionEnJuego ());
-        atacante_->ponPuntosAccionEnJuego (0);
-        if (atacante_->puntosAccion () == 0) {
-            atacante_->presencia ().oscureceRetrato ();
-        }
-        //
-        LadoTablero lado_ataca = atacante_->ladoTablero ();
-        PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (lado_ataca);
+        PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (atacante_->ladoTablero ());
         aserta (presnc_ataca.visible (), "mueveFichaCamino", "el atacante no es visible");
-        presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), 0);
         //
-        juego_->tablero ()->emiteSonidoDesplaza ();
+        // el camino entero es una jugada; su coste es el que se ha ido poniendo en juego al fijar 
+        // las etapas
+        int puntos_camino = CalculoCaminos::puntosLongitud (juego_, CalculoCaminos::longitudCamino (etapas_camino));
+        aserta (puntos_camino == atacante_->puntosAccionEnJuego (), 
+                                                "mueveFichaCamino", "coste del camino erróneo");
+        reglas::Jugada jugada {};
+        jugada.tipo      = reglas::TipoJugada::desplaza;
+        jugada.personaje = static_cast <int8_t>  (atacante_->indice ());
+        jugada.celda     = static_cast <int16_t> (ConversionReglas::celdaReglas (etapas_camino.back ()));
+        jugada.puntos    = static_cast <int16_t> (puntos_camino);
+        alcance_desplaza.invalida ();
+        vaciaEtapasCamino ();
+        juego_->tablero ()->vistaCamino ().vaciaCamino ();
+        efectuaJugada (jugada);
     }
 
 
@@ -642,7 +745,7 @@ namespace tapete {
         aserta (modo_accion == ModoAccionPersonaje::Desplazamiento,
                                                 "anulaCamino", "modo de acción inválido");
         //
-        etapas_camino.clear ();
+        vaciaEtapasCamino ();
         juego_->tablero ()->vistaCamino ().vaciaCamino ();
         atacante_->ponPuntosAccionEnJuego (0);
         LadoTablero lado_atacante = atacante_->ladoTablero ();
@@ -656,15 +759,16 @@ namespace tapete {
     void ModoJuegoBase::alea100 () {
         // solo usado en 'ModoJuegoComun'
         //
-        valor_aleatorio_100 = azarosa (100);
+        // solo para la animación del cálculo; el valor que cuenta se tira al atacar
+        valor_mostrado_100 = azar_vistoso.entero (100);
     }
 
 
     void ModoJuegoBase::muestraAleatorio100 () {
         // solo usado en 'ModoJuegoComun'
         //
-        int digt_1 = valor_aleatorio_100 / 10;
-        int digt_2 = valor_aleatorio_100 % 10;
+        int digt_1 = valor_mostrado_100 / 10;
+        int digt_2 = valor_mostrado_100 % 10;
         juego_->tablero ()->muestraDisplay (digt_1, digt_2);
     }
 
@@ -676,6 +780,15 @@ namespace tapete {
     }
 
 
+    void ModoJuegoBase::tiraAleatorio100 () {
+        // el display queda con el valor usado en el ataque
+        valor_aleatorio_100 = azar_partida.entero (100);
+        juego_->grabacion ().anota (GrabacionPartida::Suceso::tirada, valor_aleatorio_100, 100);
+        valor_mostrado_100  = valor_aleatorio_100;
+        muestraAleatorio100 ();
+    }
+
+
     //----------------------------------------------------------------------------------------------
 
 
@@ -775,22 +888,12 @@ namespace tapete {
         //
         asertaHabilidadSimple ("aplicaHabilidadSimple");
         // 
-        juego_->sistemaAtaque ().calcula (atacante_, habilidad_accion);
-        //
-        atacante_->ponPuntosAccion (atacante_->puntosAccion () - atacante_->puntosAccionEnJuego ());
-        atacante_->ponPuntosAccionEnJuego (0);
-        if (atacante_->puntosAccion () == 0 ||
-            atacante_->vitalidad ()    == 0   ) {
-            atacante_->presencia ().oscureceRetrato ();
-        }
-        //
-        LadoTablero lado_ataca = atacante_->ladoTablero ();
-        PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (lado_ataca);
-        presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), 0);
-        presnc_ataca.refrescaBarraVida ();
-        //presnc_ataca.desmarca ();
-        //
-        juego_->tablero ()->emiteSonidoHabilidad (habilidad_accion);
+        reglas::Jugada jugada {};
+        jugada.tipo      = reglas::TipoJugada::habilidadSimple;
+        jugada.personaje = static_cast <int8_t> (atacante_->indice ());
+        jugada.habilidad = static_cast <int8_t> (habilidad_accion->indice ());
+        jugada.puntos    = static_cast <int16_t> (habilidad_accion->coste ());
+        efectuaJugada (jugada);
     }
 
 
@@ -859,7 +962,12 @@ namespace tapete {
         //        atacante_->sitioFicha (), oponente_->sitioFicha ());
         puntos_en_juego = habilidad_accion->coste ();
         //
-        float distn = distanciaCeldas (oponente_->sitioFicha (), atacante_->sitioFicha ()); 
+        actualizaMatrizAmenazas ();
+        if (matriz_amenazas.consulta (atacante_, habilidad_accion, oponente_, acceso_valido)) {
+            return;
+        }
+        //
+        int distn = distanciaCeldas (oponente_->sitioFicha (), atacante_->sitioFicha ()); 
         if (distn > habilidad_accion->alcance ()) {
             acceso_valido = false;
             return;
@@ -921,7 +1029,9 @@ namespace tapete {
         //
         asertaHabilidadOponente ("atacaOponente", oponente_);
         //
-        juego_->sistemaAtaque ().calcula (atacante_, habilidad_accion, oponente_, valor_aleatorio_100);
+        tiraAleatorio100 ();
+        // el oponente puede morir
+        alcance_desplaza.invalida ();
         //
         if (habilidadAccion ()->tipoAcceso () == AccesoHabilidad::directo) {
             VistaCaminoCeldas & vista_camino = juego_->tablero ()->vistaCamino ();
@@ -935,12 +1045,13 @@ namespace tapete {
             juego_->tablero ()->rejilla ().desmarcaCelda (oponente_->sitioFicha ());
         }
         //
-        refrescaBarrasVida ();
-        //
-        refrescaPuntosAccion ();
-        //presnc_ataca.desmarca ();
-        //
-        juego_->tablero ()->emiteSonidoHabilidad (habilidad_accion);
+        reglas::Jugada jugada {};
+        jugada.tipo      = reglas::TipoJugada::habilidadOponente;
+        jugada.personaje = static_cast <int8_t> (atacante_->indice ());
+        jugada.habilidad = static_cast <int8_t> (habilidad_accion->indice ());
+        jugada.objetivo  = static_cast <int8_t> (oponente_->indice ());
+        jugada.puntos    = static_cast <int16_t> (habilidad_accion->coste ());
+        efectuaJugada (jugada);
     }
 
 
@@ -1016,7 +1127,7 @@ namespace tapete {
             return;
         }
         //
-        float distn = distanciaCeldas (celda_area, atacante_->sitioFicha ()); 
+        int distn = distanciaCeldas (celda_area, atacante_->sitioFicha ()); 
         if (distn > habilidad_accion->alcance ()) {
             acceso_valido = false;
             return;
@@ -1081,27 +1192,58 @@ namespace tapete {
         //
         asertaHabilidadArea ("atacaArea", true);
         // 
-        std::vector <ActorPersonaje *> lista_oponentes {};
-        personajesAreaCeldas (lista_oponentes);
-        //
-        juego_->sistemaAtaque ().calcula (
-                atacante_, habilidad_accion, lista_oponentes, valor_aleatorio_100);
+        tiraAleatorio100 ();
+        // algún personaje puede morir
+        alcance_desplaza.invalida ();
         //
+        Coord celda_area = area_celdas [0] [0];
         desmarcaCeldasArea ();
         if (habilidadAccion ()->tipoAcceso () == AccesoHabilidad::directo) {
             VistaCaminoCeldas & vista_camino = juego_->tablero ()->vistaCamino ();
             vista_camino.vaciaCamino ();
         }
         //
-        refrescaBarrasVida ();
-        //
-        refrescaPuntosAccion ();
-        //presnc_ataca.desmarca ();
-        //
-        juego_->tablero ()->emiteSonidoHabilidad (habilidad_accion);
+        // los afectados son los de 'reglas::MotorReglas::personajesArea', que son los que tienen 
+        // la ficha en 'area_celdas'
+        reglas::Jugada jugada {};
+        jugada.tipo      = reglas::TipoJugada::habilidadArea;
+        jugada.personaje = static_cast <int8_t>  (atacante_->indice ());
+        jugada.habilidad = static_cast <int8_t>  (habilidad_accion->indice ());
+        jugada.celda     = static_cast <int16_t> (ConversionReglas::celdaReglas (celda_area));
+        jugada.puntos    = static_cast <int16_t> (habilidad_accion->coste ());
+        efectuaJugada (jugada);
     }
 
     
+    bool ModoJuegoBase::sugiereAreaHabilidad (Coord & celda, double & valor) {
+        // solo usado en 'ModoJuegoComun'
+        //
+        asertaHabilidadArea ("sugiereAreaHabilidad", false);
+        // 
+        if (habilidad_accion->coste () > atacante_->puntosAccion ()) {
+            return false;
+        }
+        reglas::EstadoPartida estado {};
+        ConversionReglas::extraeEstado (juego_, estado);
+        if (busqueda_area == nullptr) {
+            busqueda_area = std::make_unique <reglas::BusquedaArea> (juego_->motorReglas ());
+        }
+        std::vector <reglas::BusquedaArea::Colocacion> colocaciones {};
+        busqueda_area->busca (estado, atacante_->indice (), habilidad_accion->indice (), 2, colocaciones);
+        for (const reglas::BusquedaArea::Colocacion & colocacion : colocaciones) {
+            Coord celda_colocacion = ConversionReglas::celdaTablero (colocacion.celda);
+            // 'ModoJuegoComun::evaluaHabilidadArea' no admite la celda del atacante
+            if (celda_colocacion == atacante_->sitioFicha ()) {
+                continue;
+            }
+            celda = celda_colocacion;
+            valor = colocacion.valor;
+            return true;
+        }
+        return false;
+    }
+
+
     void ModoJuegoBase::asertaHabilidadArea (const string & metodo, bool con_area) {
         aserta (atacante_ != nullptr,           metodo, "atacante no asignado");
         aserta (atacante_->puntosAccion () > 0, metodo, "atacante agotado");
@@ -1220,7 +1362,7 @@ namespace tapete {
         personaje_elegido_derch = nullptr;
         atacante_ = nullptr;
         modo_accion = ModoAccionPersonaje::Nulo;
-        etapas_camino.clear ();
+        vaciaEtapasCamino ();
         juego_->tablero ()->vistaCamino ().vaciaCamino ();
         habilidad_accion = nullptr;
         oponente_ = nullptr;
@@ -1231,42 +1373,180 @@ namespace tapete {
     //----------------------------------------------------------------------------------------------
 
 
-    int ModoJuegoBase::azarosa (unsigned int contador) {
-	    std::random_device semilla {};
-        std::mt19937 generador {semilla ()};
-	    std::uniform_int_distribution <unsigned int> distrb {0, contador - 1};
-        return distrb (generador);
+    void ModoJuegoBase::captura (InstantaneaPartida & instantanea) {
+        aserta (modo_accion == ModoAccionPersonaje::Nulo, "captura", "acción en curso");
+        aserta (etapas_camino.size () == 0,               "captura", "camino en curso");
+        //
+        constexpr int maximoTipos = reglas::ReglasPartida::maximoTiposEstadistica;
+        reglas::EstadoPartida partida {};
+        ConversionReglas::extraeEstado (juego_, partida);
+        instantanea.cuenta_personajes = partida.cuenta_personajes;
+        instantanea.cuenta_cambios    = 0;
+        for (int indc = 0; indc < partida.cuenta_personajes; ++ indc) {
+            const reglas::EstadoPersonaje & persnj_estado = partida.personajes [indc];
+            InstantaneaPartida::Personaje & persnj_inst = instantanea.personajes [indc];
+            persnj_inst.celda         = persnj_estado.celda;
+            persnj_inst.vitalidad     = persnj_estado.vitalidad;
+            persnj_inst.puntos_accion = static_cast <int8_t> (persnj_estado.puntos_accion);
+            // los tipos de defensa van detrás de los de ataque
+            for (int tipo = 0; tipo < 2 * maximoTipos; ++ tipo) {
+                int16_t cambio = tipo < maximoTipos ? persnj_estado.cambio_ataque  [tipo] : 
+                                                      persnj_estado.cambio_defensa [tipo - maximoTipos];
+                if (cambio == 0) {
+                    continue;
+                }
+                aserta (instantanea.cuenta_cambios < InstantaneaPartida::maximoCambios, 
+                        "captura", "demasiados cambios de estadísticas");
+                InstantaneaPartida::CambioEstadistica & cambio_inst = instantanea.cambios [instantanea.cuenta_cambios ++];
+                cambio_inst.personaje = static_cast <int8_t> (indc);
+                cambio_inst.tipo      = static_cast <int8_t> (tipo);
+                cambio_inst.valor     = cambio;
+            }
+        }
+        instantanea.ronda    = partida.ronda;
+        instantanea.turno    = partida.turno;
+        instantanea.jugada   = partida.jugada;
+        instantanea.elegido  = partida.elegido;
+        instantanea.atacante = partida.atacante;
+        instantanea.lado_equipo_inicial = lado_equipo_inicial;
+        instantanea.lado_equipo_actual  = lado_equipo_actual;
+        instantanea.cuenta_factores = static_cast <int8_t> (factores_equipos.size ());
+        for (int indc = 0; indc < factores_equipos.size (); ++ indc) {
+            instantanea.factores_equipos [indc] = static_cast <int8_t> (factores_equipos [indc]->indice ());
+        }
+        instantanea.indice_factor_equipos = static_cast <int8_t> (indice_factor_equipos);
+        instantanea.azar_partida = azar_partida;
+    }
+
+
+    void ModoJuegoBase::restaura (const InstantaneaPartida & instantanea) {
+        constexpr int maximoTipos = reglas::ReglasPartida::maximoTiposEstadistica;
+        const std::vector <ActorPersonaje *> & personajes = juego_->personajes ();
+        aserta (instantanea.cuenta_personajes == personajes.size (), 
+                                                 "restaura", "la instantánea es de otra partida");
+        //
+        // 'vuelcaEstado' solo usa los personajes; el resto se toma directamente de la instantánea
+        reglas::EstadoPartida partida {};
+        partida.cuenta_personajes = instantanea.cuenta_personajes;
+        for (int indc = 0; indc < instantanea.cuenta_personajes; ++ indc) {
+            const InstantaneaPartida::Personaje & persnj_inst = instantanea.personajes [indc];
+            reglas::EstadoPersonaje & persnj_estado = partida.personajes [indc];
+            persnj_estado.celda         = persnj_inst.celda;
+            persnj_estado.vitalidad     = persnj_inst.vitalidad;
+            persnj_estado.puntos_accion = persnj_inst.puntos_accion;
+        }
+        for (int indc = 0; indc < instantanea.cuenta_cambios; ++ indc) {
+            const InstantaneaPartida::CambioEstadistica & cambio_inst = instantanea.cambios [indc];
+            reglas::EstadoPersonaje & persnj_estado = partida.personajes [cambio_inst.personaje];
+            if (cambio_inst.tipo < maximoTipos) {
+                persnj_estado.cambio_ataque  [cambio_inst.tipo] = cambio_inst.valor;
+            } else {
+                persnj_estado.cambio_defensa [cambio_inst.tipo - maximoTipos] = cambio_inst.valor;
+            }
+        }
+        ConversionReglas::vuelcaEstado (juego_, partida);
+        //
+        ronda_  = instantanea.ronda;
+        turno_  = instantanea.turno;
+        jugada_ = instantanea.jugada;
+        lado_equipo_inicial = instantanea.lado_equipo_inicial;
+        lado_equipo_actual  = instantanea.lado_equipo_actual;
+        factores_equipos.clear ();
+        for (int indc = 0; indc < instantanea.cuenta_factores; ++ indc) {
+            factores_equipos.push_back (personajes [instantanea.factores_equipos [indc]]);
+        }
+        indice_factor_equipos = instantanea.indice_factor_equipos;
+        azar_partida = instantanea.azar_partida;
+        //
+        int8_t indc_izqrd = instantanea.elegido [reglas::indiceLado (LadoTablero::Izquierda)];
+        int8_t indc_derch = instantanea.elegido [reglas::indiceLado (LadoTablero::Derecha)];
+        personaje_elegido_izqrd = indc_izqrd == reglas::EstadoPartida::ninguno ? nullptr : personajes [indc_izqrd];
+        personaje_elegido_derch = indc_derch == reglas::EstadoPartida::ninguno ? nullptr : personajes [indc_derch];
+        atacante_ = instantanea.atacante == reglas::EstadoPartida::ninguno ? nullptr : personajes [instantanea.atacante];
+        //
+        modo_accion      = ModoAccionPersonaje::Nulo;
+        vaciaEtapasCamino ();
+        habilidad_accion = nullptr;
+        oponente_        = nullptr;
+        area_celdas      .clear ();
+        alcance_desplaza .invalida ();
+        matriz_amenazas  .invalida ();
+        //
+        // la presentación se rehace entera: no se sabe desde dónde se llega
+        juego_->tablero ()->vistaCamino ().vaciaCamino ();
+        juego_->tablero ()->rejilla ().desmarcaCeldas (); 
+        for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+            PresenciaActuante & presnc = juego_->tablero ()->presencia (lado);
+            if (presnc.visible ()) {
+                presnc.oculta ();
+            }
+        }
+        if (atacante_ != nullptr) {
+            PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (atacante_->ladoTablero ());
+            presnc_ataca.muestra (atacante_);
+            presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), 0);
+            juego_->tablero ()->rejilla ().marcaCelda (atacante_->sitioFicha (), ModoJuegoBase::color_atacante, false);
+        } else {
+            for (ActorPersonaje * elegido : { personaje_elegido_izqrd, personaje_elegido_derch }) {
+                if (elegido != nullptr) {
+                    PresenciaActuante & presnc = juego_->tablero ()->presencia (elegido->ladoTablero ());
+                    presnc.muestra (elegido);
+                    presnc.iluminaPuntosAccion (elegido->puntosAccion (), 0);
+                    juego_->tablero ()->rejilla ().marcaCelda (elegido->sitioFicha (), ModoJuegoBase::color_elegido); 
+                }
+            }
+        }
+        for (ActorPersonaje * persj : personajes) {
+            if (persj->vitalidad () > 0 && persj->puntosAccion () > 0) {
+                persj->presencia ().aclaraRetrato ();
+            } else {
+                persj->presencia ().oscureceRetrato ();
+            }
+        }
+        refrescaBarrasVida ();
     }
 
 
     //----------------------------------------------------------------------------------------------
 
 
-    int ModoJuegoBase::puntosEnJuegoCamino (Coord proxima_celda) const {
-        float distn = 0.0f;
-        for (int indc = 0; indc < etapas_camino.size (); ++ indc) {
-            Coord previa = etapas_camino [indc];
-            Coord etapa;
-            if (indc == etapas_camino.size () - 1) {
-                etapa = proxima_celda;
-            } else {
-                etapa = etapas_camino [indc + 1];
-            }
-            distn += unir2d::norma (
-                    RejillaTablero::centroHexagono (etapa) -
-                    RejillaTablero::centroHexagono (previa) );
+    void ModoJuegoBase::apilaEtapaCamino (Coord celda) {
+        etapas_camino.push_back (celda);
+        juego_->tablero ()->ocupacion ().marca (CapaOcupacion::etapas, celda);
+    }
+
+
+    void ModoJuegoBase::vaciaEtapasCamino () {
+        etapas_camino.clear ();
+        juego_->tablero ()->ocupacion ().vacia (CapaOcupacion::etapas);
+        alcance_desplaza.invalida ();
+        desombreaAlcance ();
+    }
+
+
+    // de una vez, con lo que ya calculó 'alcance_desplaza'; las celdas alcanzables están libres, 
+    // así que no coinciden con las marcas del atacante, los elegidos o el objetivo
+    void ModoJuegoBase::sombreaAlcance () {
+        desombreaAlcance ();
+        alcance_desplaza.celdasAlcanzables (celdas_alcance);
+        juego_->tablero ()->rejilla ().marcaCeldas (celdas_alcance, ModoJuegoBase::color_alcance, false);
+    }
+
+
+    void ModoJuegoBase::desombreaAlcance () {
+        for (Coord celda : celdas_alcance) {
+            juego_->tablero ()->rejilla ().desmarcaCelda (celda);
         }
-        int punts = static_cast <int> (std::round (distn / puntosAccionDeDesplaza ()));
-        return punts;
+        celdas_alcance.clear ();
     }
 
 
-    float ModoJuegoBase::distanciaCeldas (Coord celda_origen, Coord celda_destino) const {
-        float distn = unir2d::norma (
-                RejillaTablero::centroHexagono (celda_destino) -
-                RejillaTablero::centroHexagono (celda_origen)   );
-        constexpr float unidad = static_cast <float> (RejillaTablero::ladoHexagono) * RejillaTablero::seno60_exacto * 2;
-        return distn / unidad;
+    //----------------------------------------------------------------------------------------------
+
+
+    int ModoJuegoBase::distanciaCeldas (Coord celda_origen, Coord celda_destino) const {
+        // en casillas, como el alcance de las habilidades
+        return GeometriaHexagonal::distancia (celda_origen, celda_destino);
     }
 
 
@@ -1275,9 +1555,7 @@ namespace tapete {
 
     void ModoJuegoBase::marcaCeldasArea () {
         for (int indc_radio = 0; indc_radio < area_celdas.size (); ++ indc_radio) {
-            for (Coord celda : area_celdas [indc_radio]) {
-                juego_->tablero ()->rejilla ().marcaCelda (celda, ModoJuegoBase::color_objetivo, true);
-            }
+            juego_->tablero ()->rejilla ().marcaCeldas (area_celdas [indc_radio], ModoJuegoBase::color_objetivo, true);
         }
     }
 
@@ -1291,20 +1569,6 @@ namespace tapete {
     }
 
 
-    void ModoJuegoBase::personajesAreaCeldas (
-            std::vector <ActorPersonaje *> & lista_oponentes) const {
-        for (int indc_radio = 0; indc_radio < area_celdas.size (); ++ indc_radio) {
-            for (Coord celda : area_celdas [indc_radio]) {
-                for (ActorPersonaje * persj : juego_->personajes ()) {
-                    if (persj->sitioFicha () == celda) {
-                        lista_oponentes.push_back (persj);
-                    }
-                }
-            }
-        }
-    }
-
-
     void ModoJuegoBase::iniciaPersonajes () {
         for (ActorPersonaje * persj : juego_->personajes ()) {
             persj->ponVitalidad (ActorPersonaje::maximaVitalidad);
@@ -1319,20 +1583,21 @@ namespace tapete {
             if (persj->vitalidad () > 0) {
                 persj->presencia ().aclaraRetrato ();
             }
-            for (TipoAtaque * ataque : juego_->ataques ()) {
-                if (persj->apareceAtaque (ataque)) {
-                    persj->restauraAtaque (ataque);
-                }
-            }
-            for (TipoDefensa * defns : juego_->defensas ()) {
-                if (persj->apareceDefensa (defns)) {
-                    persj->restauraDefensa (defns);
-                }
-            }
+            persj->restauraEstadisticas ();
         }
     }
 
 
+    void ModoJuegoBase::efectuaJugada (const reglas::Jugada & jugada) {
+        reglas::EstadoPartida estado {};
+        ConversionReglas::extraeEstado (juego_, estado);
+        PresentacionReglas presentacion {this};
+        juego_->motorReglas ().efectua (estado, jugada, valor_aleatorio_100, & presentacion);
+        ConversionReglas::vuelcaEstado (juego_, estado);
+        presentacion.presenta ();
+    }
+
+
     void ModoJuegoBase::refrescaBarrasVida () {
         for (ActorPersonaje * persj : juego_->personajes ()) {
             persj->presencia ().refrescaBarraVida ();
@@ -1351,19 +1616,6 @@ namespace tapete {
     }
 
 
-    void ModoJuegoBase::refrescaPuntosAccion () {
-        atacante_->ponPuntosAccion (
-                atacante_->puntosAccion () - atacante_->puntosAccionEnJuego ());
-        atacante_->ponPuntosAccionEnJuego (0);
-        if (atacante_->puntosAccion () == 0) {
-            atacante_->presencia ().oscureceRetrato ();
-        }
-        LadoTablero lado_ataca = atacante_->ladoTablero ();
-        PresenciaActuante & presnc_ataca = juego_->tablero ()->presencia (lado_ataca);
-        presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), 0);
-    }
-
-
     //----------------------------------------------------------------------------------------------
 
 
@@ -1379,88 +1631,31 @@ namespace tapete {
     //----------------------------------------------------------------------------------------------
 
 
-    void ModoJuegoBase::almacenaInforme ( 
-            const EstadoJuegoComun & estado,
-            const string &           modulo, 
-            const string &           metodo ) {
-        informes_proceso.agregaInforme (estado, this, modulo, metodo);
-    }
-
-
-    const string ModoJuegoBase::textoInforme () const {
-        return informes_proceso.textoInforme ();
-    }
-
-
-    void ModoJuegoBase::InformesProceso::agregaInforme (
-                const EstadoJuegoComun & estado, 
-                const ModoJuegoBase * proceso, 
-                const string &           modulo, 
-                const string &           metodo) {
-        Informe * informe;
-        prepara (informe);
-        informe->tiempo  = std::chrono::system_clock::now (); 
-        informe->estado  = estado.nombre ();
-        informe->ronda_  = proceso->ronda_;
-        informe->turno_  = proceso->turno_;
-        informe->jugada_ = proceso->jugada_;
-        informe->modulo  = modulo;
-        informe->metodo  = metodo;
+    int ModoJuegoBase::internaModulo (const string & modulo) {
+        return traza_proceso.interna (modulo);
     }
 
 
-    static string aString (std::chrono::system_clock::time_point momento) {
-        std::time_t t = std::chrono::system_clock::to_time_t (momento);
-        std::tm     tm {}; 
-        localtime_s (& tm, & t);
-        constexpr int ancho_buzon = 25;
-        char buzon [ancho_buzon];
-        std::strftime (buzon, ancho_buzon, "%T", & tm);
-        return string {buzon};
+    void ModoJuegoBase::almacenaInforme (const EstadoJuegoComun & estado, int modulo, const char * metodo) {
+        if (! traza_proceso.conoceEstado (estado)) {
+            traza_proceso.nombraEstado (estado, estado.nombre ());
+        }
+        traza_proceso.agrega (modulo, traza_proceso.interna (metodo), estado, ronda_, turno_, jugada_);
     }
 
 
-    const string ModoJuegoBase::InformesProceso::textoInforme () const {
-        string retorno {};        
-        for (int indc = 0; indc < lista_informes.size (); ++ indc) {
-            Informe * informe = lista_informes [indc];
-            if (informe == nullptr) {
-                break;
-            }
-            retorno.append (aString (informe->tiempo));
-            retorno.append (std::format ("  ( {}, {}, {} )", informe->ronda_,  informe->turno_, informe->jugada_));
-            retorno.append (std::format ("  {:36}", informe->metodo));
-            retorno.append (std::format ("  {}", informe->estado));
-            retorno.append ("\n");
-        }
-        return retorno;
+    const string ModoJuegoBase::textoInforme () const {
+        return traza_proceso.texto (cuentaInforme);
     }
 
 
-    void ModoJuegoBase::InformesProceso::prepara (Informe * & informe) {
-        int indc_vacio = -1;
-        for (int indc = 0; indc < lista_informes.size (); ++ indc) {
-            if (lista_informes [indc] == nullptr) {
-                indc_vacio = indc;
-                break;
-            }
-        }
-        if (indc_vacio != -1) {
-            informe = new Informe {};
-            lista_informes [indc_vacio] = informe;
-        } else {
-            rota ();
-            informe = lista_informes [lista_informes.size () - 1];
-        }
+    const RegistroTraza & ModoJuegoBase::trazaProceso () const {
+        return traza_proceso;
     }
 
 
-    void ModoJuegoBase::InformesProceso::rota () {
-        Informe * primero = lista_informes [0];
-        for (int indc = 1; indc < lista_informes.size (); ++ indc) {
-            lista_informes [indc - 1] = lista_informes [indc];
-        }
-        lista_informes [lista_informes.size () - 1] = primero;
+    void ModoJuegoBase::trazaAvance (bool trazar) {
+        trazar_avance = trazar;
     }
 
 
@@ -9,6 +9,9 @@
 namespace tapete {
 
 
+    struct InstantaneaPartida;
+
+
     class ModoJuegoBase {
     public:
 
@@ -23,6 +26,11 @@ namespace tapete {
         int turno  () const;
         int jugada () const;
 
+        // la semilla del azar de la partida; sembrando la misma antes de 'iniciaRondas' se repite 
+        // la misma secuencia de tiradas
+        void     siembraAzar (uint64_t semilla);
+        uint64_t semillaAzar () const;
+
         LadoTablero ladoEquipoInicial () const;
         LadoTablero ladoEquipoActual  () const;
         
@@ -35,12 +43,21 @@ namespace tapete {
         ModoAccionPersonaje  modoAccion () const;
 
         const std::vector <Coord> & etapasCamino () const;
+        const AlcanceDesplaza & alcanceDesplaza () const;
         Habilidad * habilidadAccion () const;
         ActorPersonaje * oponente () const;
         const AreaCentradaCeldas & areaCeldas () const;
+        const MatrizAmenazas & matrizAmenazas () const;
+
+        // instantánea de la partida entre dos jugadas; véase: 'JuegoMesaBase::captura'
+        virtual void captura  (InstantaneaPartida & instantanea);
+        virtual void restaura (const InstantaneaPartida & instantanea);
 
         // para depurar
         const string textoInforme () const;
+        const RegistroTraza & trazaProceso () const;
+        // la traza del avance por la consola; las herramientas sin ventana la desactivan
+        static void trazaAvance (bool trazar);
 
     protected:
 
@@ -78,10 +95,13 @@ namespace tapete {
         void marcaCeldaInicio ();
         void desmarcaCeldaInicio ();
         void iniciaCamino ();
+        void calculaAlcanceDesplaza ();
+        void actualizaMatrizAmenazas ();
         void validaEtapaCamino   (Coord proxima_celda, bool & etapa_valida, int & puntos_en_juego);
         void marcaCeldaCamino    (Coord proxima_celda, bool etapa_valida);
         void desmarcaCeldaCamino (Coord proxima_celda);
         void agregaEtapaCamino   (Coord proxima_celda, int puntos_en_juego);
+        bool agregaCaminoOptimo  (Coord celda_destino);
         void mueveFichaCamino ();
         void anulaCamino ();
 
@@ -114,6 +134,9 @@ namespace tapete {
         void muestraAtaqueArea (bool acceso_valido, int puntos_en_juego);
         void ocultaAtaqueArea ();
         void atacaArea ();
+        // la celda central con más daño neto esperado para la habilidad en acción (véase 
+        // 'reglas::BusquedaArea'); falso si no hay ninguna válida
+        bool sugiereAreaHabilidad (Coord & celda, double & valor);
 
         void iniciaTiempoCalculo ();
         void terminaTiempoCalculo ();
@@ -128,52 +151,12 @@ namespace tapete {
 
         void anulaTotalmente ();
 
-        // para depurar
-        void almacenaInforme ( 
-                const EstadoJuegoComun & estado,
-                const string &           modulo, 
-                const string &           metodo );
-
-    private:
-
-
-        class InformesProceso {
-        public:
-
-            void agregaInforme (
-                    const EstadoJuegoComun & estado, 
-                    const ModoJuegoBase * proceso, 
-                    const string &           modulo, 
-                    const string &           metodo  );
-
-            const string textoInforme () const;
-
-        private:
-
-            struct Informe {
-
-                std::chrono::system_clock::time_point tiempo;
-
-                string estado;
-
-                int ronda_;
-                int turno_;
-                int jugada_;
-
-                string modulo;
-                string metodo;
-
-            };
-
-
-            std::array <Informe *, 20> lista_informes {}; 
-
-
-            void prepara  (Informe * & informe);
-            void rota ();
-
-        };
+        // la acción del atacante, con 'reglas::MotorReglas'; véase: 'PresentacionReglas'
+        void efectuaJugada (const reglas::Jugada & jugada);
 
+        // para depurar
+        int  internaModulo (const string & modulo);
+        void almacenaInforme (const EstadoJuegoComun & estado, int modulo, const char * metodo);
 
     private:
 
@@ -200,33 +183,55 @@ namespace tapete {
 
         ModoAccionPersonaje  modo_accion {};
         std::vector <Coord>  etapas_camino {};
+        AlcanceDesplaza      alcance_desplaza {};
+        // las celdas de 'alcance_desplaza' sombreadas en la rejilla
+        std::vector <Coord>  celdas_alcance {};
         Habilidad *          habilidad_accion {};        
         ActorPersonaje *     oponente_ {};
         AreaCentradaCeldas   area_celdas {};
+        MatrizAmenazas       matriz_amenazas {};
+        // la de 'sugiereAreaHabilidad', creada en la primera consulta; sirve para cualquier 
+        // atacante y habilidad
+        std::unique_ptr <reglas::BusquedaArea> busqueda_area {};
+
+        // 'azar_partida' decide las tiradas; 'azar_vistoso' solo los dígitos que se muestran 
+        // mientras dura el cálculo, para que la animación no altere la secuencia de la partida
+        reglas::GeneradorAzar azar_partida {};
+        reglas::GeneradorAzar azar_vistoso {};
 
         int valor_aleatorio_100 {};
+        int valor_mostrado_100 {};
 
-        InformesProceso informes_proceso {};
+        // 'textoInforme' solo da las últimas, las que acompañan al informe de una excepción
+        RegistroTraza        traza_proceso {};
+        static constexpr int cuentaInforme = 20;
 
         inline static Color color_elegido  = Color::Blanco;
         inline static Color color_atacante = Color::Amarillo;
         inline static Color color_objetivo = Color::Marron;
+        inline static Color color_alcance  = Color::Gris;
+
+
+        // mantienen la capa de etapas de la ocupación del tablero
+        void apilaEtapaCamino (Coord celda);
+        void vaciaEtapasCamino ();
+
+        void tiraAleatorio100 ();
 
+        void anotaJugada ();
 
-        static int azarosa (unsigned int contador);
+        int   distanciaCeldas     (Coord celda_origen, Coord celda_destino) const;
 
-        int   puntosEnJuegoCamino   (Coord proxima_celda) const;
-        float distanciaCeldas (Coord celda_origen, Coord celda_destino) const;
+        void sombreaAlcance ();
+        void desombreaAlcance ();
 
         void marcaCeldasArea ();
         void desmarcaCeldasArea ();
-        void personajesAreaCeldas (std::vector <ActorPersonaje *> & lista_oponentes) const;
 
         void iniciaPersonajes ();
         void restauraPersonajes ();
 
         void refrescaBarrasVida ();
-        void refrescaPuntosAccion ();
 
         void asertaHabilidadSimple   (const string & metodo);
         void asertaHabilidadOponente (const string & metodo, ActorPersonaje * oponentable);
@@ -234,7 +239,7 @@ namespace tapete {
         void aserta (bool condicion, const string & metodo, const string & explicacion) const;
 
 
-        friend class InformesProceso;
+        friend class PresentacionReglas;
 
     };
 
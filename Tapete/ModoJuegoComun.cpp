@@ -32,6 +32,70 @@ namespace tapete {
     }
 
 
+    void ModoJuegoComun::captura (InstantaneaPartida & instantanea) {
+        try {
+            validaEntreJugadas ();
+            //
+            ModoJuegoBase::captura (instantanea);
+            instantanea.estado_modo = estado ();
+        } catch (const std::exception & excepcion) {
+            excepciona ("captura", excepcion);
+        }
+    }
+
+
+    void ModoJuegoComun::restaura (const InstantaneaPartida & instantanea) {
+        try {
+            validaEntreJugadas ();
+            //
+            ModoJuegoBase::ocultaIndicaciones ();
+            ModoJuegoBase::restaura (instantanea);
+            //
+            estado ().conserva (instantanea.estado_modo);
+            estadoPrevio ().conserva (instantanea.estado_modo);
+            validaAtributos ();
+            informaProceso ("restaura");
+            escribeEstado ();
+        } catch (const std::exception & excepcion) {
+            excepciona ("restaura", excepcion);
+        }
+    }
+
+
+    void ModoJuegoComun::deshaceJugada () {
+        try {
+            validaEstado ({ EstadoJuegoComun::inicioJugada });
+            //
+            if (jugadas_previas.size () < 2) {
+                return;
+            }
+            jugadas_previas.pop_back ();
+            restaura (jugadas_previas.back ());
+            informaProceso ("deshaceJugada");
+        } catch (const std::exception & excepcion) {
+            excepciona ("deshaceJugada", excepcion);
+        }
+    }
+
+
+    void ModoJuegoComun::apilaJugada () {
+        if (jugadas_previas.size () == maximoJugadasPrevias) {
+            jugadas_previas.erase (jugadas_previas.begin ());
+        }
+        captura (jugadas_previas.emplace_back ());
+    }
+
+
+    void ModoJuegoComun::vaciaJugadas () {
+        jugadas_previas.clear ();
+    }
+
+
+    void ModoJuegoComun::omiteAnimacionCalculo () {
+        segundos_espera = 0.0;
+    }
+
+
     void ModoJuegoComun::saltaFinalJuego () {
         try {
             validaEstado (false, {
@@ -141,6 +205,7 @@ namespace tapete {
                     // sin etapas camino, con habilidad área, sin oponente, sin celda área
             //            
             ModoJuegoBase::estableceModoAccionDesplazam ();
+            ModoJuegoBase::calculaAlcanceDesplaza ();
             //
             estado ().transita (EstadoJuegoComun::preparacionDesplazamiento);
             validaAtributos ();
@@ -264,6 +329,9 @@ namespace tapete {
             ModoJuegoBase::validaEtapaCamino (celda, valida, puntos);
             if (valida) {
                 ModoJuegoBase::agregaEtapaCamino (celda, puntos);
+            } else {
+                // sin etapa recta: el camino más barato hasta la celda, si se puede pagar
+                ModoJuegoBase::agregaCaminoOptimo (celda);
             }
             //
             estado ().transita (EstadoJuegoComun::marcacionCaminoFicha);
@@ -527,7 +595,7 @@ namespace tapete {
                             //  sin etapas camino, con habilidad oponente, con oponente, sin celda área
             //
             double segundos = tiempo.segundos ();
-            if (segundos < segundos_calculo) {
+            if (segundos < segundos_espera) {
                 ModoJuegoBase::alea100 ();
                 ModoJuegoBase::muestraAleatorio100 ();
             } else {                
@@ -535,14 +603,14 @@ namespace tapete {
                 ModoJuegoBase::atacaOponente ();
             }
             //
-            if (segundos < segundos_calculo) {
+            if (segundos < segundos_espera) {
                 // este transito no aporta nada y confunde mucho 
                 //estado ().transita (EstadoJuegoComun::oponenteHabilidadCalculando);
             } else {
                 estado ().transita (EstadoJuegoComun::oponenteHabilidadResultado);
             }
             validaAtributos ();
-            if (segundos >= segundos_calculo) {
+            if (segundos >= segundos_espera) {
                 informaProceso ("calculaHabilidadOponente");
             }
             escribeEstado ();
@@ -685,7 +753,7 @@ namespace tapete {
                             //  sin etapas camino, con habilidad área, sin oponente, con celda área
             //
             double segundos = tiempo.segundos ();
-            if (segundos < segundos_calculo) {
+            if (segundos < segundos_espera) {
                 ModoJuegoBase::alea100 ();
                 ModoJuegoBase::muestraAleatorio100 ();
             } else {
@@ -693,14 +761,14 @@ namespace tapete {
                 ModoJuegoBase::atacaArea ();
             }
             //
-            if (segundos < segundos_calculo) {
+            if (segundos < segundos_espera) {
                 // este transito no aporta nada y confunde mucho 
                 //estado ().transita (EstadoJuegoComun::areaHabilidadCalculando);
             } else {
                 estado ().transita (EstadoJuegoComun::areaHabilidadResultado);
             }
             validaAtributos ();
-            if (segundos >= segundos_calculo) {
+            if (segundos >= segundos_espera) {
                 informaProceso ("calculaHabilidadArea");
             }
             escribeEstado ();
@@ -846,29 +914,53 @@ namespace tapete {
     }
 
 
-    void ModoJuegoComun::validaEstado (const std::initializer_list <int> & estados) {
+    void ModoJuegoComun::validaEstado (const ConjuntoEstados & estados) {
         validaEstado (true, estados);
     }
 
 
-    void ModoJuegoComun::validaEstado (bool coincide, const std::initializer_list <int> & estados) {
-        if (coincide) {
-            for (int prueba : estados) {
-                if (estado () == prueba) {
-                    return;
-                }
-            }
+    void ModoJuegoComun::validaEstado (bool coincide, const ConjuntoEstados & estados) {
+        if (estados.contiene (estado ()) != coincide) {
             throw ExcepcionEstado (estado ());
-        } else {
-            for (int prueba : estados) {
-                if (estado () == prueba) {
-                    throw ExcepcionEstado (estado ());
-                }
-            }
         }
     }
 
 
+    void ModoJuegoComun::validaEntreJugadas () {
+        // ni a medio preparar una acción ni con la ayuda a la vista
+        validaEstado (false, {
+                EstadoJuegoComun::inicial,
+                EstadoJuegoComun::terminal,
+                EstadoJuegoComun::preparacionDesplazamiento,
+                EstadoJuegoComun::marcacionCaminoFicha,
+                EstadoJuegoComun::habilidadSimpleInvalida,
+                EstadoJuegoComun::habilidadSimpleConfirmacion,
+                EstadoJuegoComun::habilidadSimpleResultado,
+                EstadoJuegoComun::preparacionHabilidadOponente,
+                EstadoJuegoComun::oponenteHabilidadInvalido,
+                EstadoJuegoComun::oponenteHabilidadConfirmacion,
+                EstadoJuegoComun::oponenteHabilidadCalculando,
+                EstadoJuegoComun::oponenteHabilidadResultado,
+                EstadoJuegoComun::preparacionHabilidadArea,
+                EstadoJuegoComun::areaHabilidadInvalida,
+                EstadoJuegoComun::areaHabilidadConfirmacion,
+                EstadoJuegoComun::areaHabilidadCalculando,
+                EstadoJuegoComun::areaHabilidadResultado,
+                EstadoJuegoComun::mostrandoAyuda });
+    }
+
+
+    void ModoJuegoComun::validaAtributos () {
+#if TAPETE_INVARIANTES
+        const InvariantesEstado & fila = invariantes (estado ());
+        assert (fila.estado == estado ());
+        valida (fila.equipo_inicial, fila.equipo_actual, fila.elegidos, fila.atacante, fila.vivo, 
+                fila.agotado, fila.modo_accion, fila.etapas_camino, fila.habilidad, fila.tipo_accion, 
+                fila.oponente, fila.area_celdas);
+#endif
+    }
+
+
     void ModoJuegoComun::valida (
             SimboloValida simbolo_equipo_inicial,
             SimboloValida simbolo_equipo_actual,
@@ -1068,8 +1160,11 @@ namespace tapete {
     }
 
 
-    void ModoJuegoComun::informaProceso (const string & metodo) {
-        ModoJuegoBase::almacenaInforme (estado_, nombreModulo (), metodo);
+    void ModoJuegoComun::informaProceso (const char * metodo) {
+        if (modulo_traza == RegistroTraza::nulo) {
+            modulo_traza = ModoJuegoBase::internaModulo (nombreModulo ());
+        }
+        ModoJuegoBase::almacenaInforme (estado_, modulo_traza, metodo);
     }
 
 
@@ -1247,12 +1342,26 @@ namespace tapete {
                       L"Pulsa 'espacio'."},
                     { habilidadAccion ()->nombre () }     );
             break;
-        case EstadoJuegoComun::preparacionHabilidadArea:
-            juego ()->tablero ()->escribeMonitor (std::vector <wstring>
-                    { L"Selecciona una celda para usar la",
-                      L"habilidad sobre un área."          },
-                    { habilidadAccion ()->nombre () }        );
+        case EstadoJuegoComun::preparacionHabilidadArea: {
+            Coord  celda_sugerida;
+            double valor_sugerido;
+            if (ModoJuegoBase::sugiereAreaHabilidad (celda_sugerida, valor_sugerido)) {
+                juego ()->tablero ()->escribeMonitor (std::vector <wstring>
+                        { L"Selecciona una celda para usar la",
+                          L"habilidad sobre un área.",
+                          std::format (L"Sugerida: fila {}, columna {}", 
+                                    celda_sugerida.fila (), 
+                                    celda_sugerida.coln ()),
+                          std::format (L"(daño neto esperado {:.1f}).", valor_sugerido) },
+                        { habilidadAccion ()->nombre () }        );
+            } else {
+                juego ()->tablero ()->escribeMonitor (std::vector <wstring>
+                        { L"Selecciona una celda para usar la",
+                          L"habilidad sobre un área."          },
+                        { habilidadAccion ()->nombre () }        );
+            }
             break;
+        }
         case EstadoJuegoComun::areaHabilidadInvalida:
             juego ()->tablero ()->escribeMonitor (std::vector <wstring>
                     { L"La habilidad no se puede usar sobre",
@@ -17,8 +17,18 @@ namespace tapete {
         EstadoJuegoComun & estado ();
         EstadoJuegoComun & estadoPrevio ();
 
+        void captura  (InstantaneaPartida & instantanea) override;
+        void restaura (const InstantaneaPartida & instantanea) override;
+
+        // vuelve al inicio de la jugada anterior; véase: 'apilaJugada'
+        void deshaceJugada ();
+
         void saltaFinalJuego ();
 
+        // sin la animación de los dígitos del cálculo: la primera alarma ya da el resultado; para 
+        // repetir partidas sin ventana ('RepeticionPartida')
+        void omiteAnimacionCalculo ();
+
         void anunciaActuante    (LadoTablero lado);
         void desanunciaActuante (LadoTablero lado);
         void anunciaHabilidad    (LadoTablero lado, int indice);
@@ -66,8 +76,15 @@ namespace tapete {
 
     protected:
 
+        // 'nombreModulo' identifica el modo en la huella de la configuración
+        friend class JuegoMesaBase;
+
         explicit ModoJuegoComun (JuegoMesaBase * juego, EstadoJuegoComun & estado, EstadoJuegoComun & estado_previo);
 
+        // al empezar cada jugada: la instantánea de la partida para 'deshaceJugada'
+        void apilaJugada ();
+        void vaciaJugadas ();
+
         virtual void escribeEstado ();
 
 
@@ -84,11 +101,42 @@ namespace tapete {
             ignora
         };
 
+        // lo que deben cumplir los atributos en el estado 'estado', en el orden de 'valida'; cada 
+        // modo tiene una tabla con una fila por código de estado, en orden
+        struct InvariantesEstado {
+            int           estado;
+            SimboloValida equipo_inicial;
+            SimboloValida equipo_actual;
+            SimboloValida elegidos;
+            SimboloValida atacante;
+            SimboloValida vivo;
+            SimboloValida agotado;
+            SimboloValida modo_accion;
+            SimboloValida etapas_camino;
+            SimboloValida habilidad;
+            SimboloValida tipo_accion;
+            SimboloValida oponente;
+            SimboloValida area_celdas;
+        };
+
+        template <size_t cuenta>
+        static constexpr bool ordenadas (const std::array <InvariantesEstado, cuenta> & tabla) {
+            for (int indice = 0; indice < cuenta; ++ indice) {
+                if (tabla [indice].estado != indice) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         virtual const string nombreModulo ();
 
-        void validaEstado (const std::initializer_list <int> & estados);
-        void validaEstado (bool coincide, const std::initializer_list <int> & estados);
-        virtual void validaAtributos () = 0;
+        void validaEstado (const ConjuntoEstados & estados);
+        void validaEstado (bool coincide, const ConjuntoEstados & estados);
+        void validaEntreJugadas ();
+        // sin efecto si no se compila con 'TAPETE_INVARIANTES' (véase: 'tapete.h')
+        void validaAtributos ();
+        virtual const InvariantesEstado & invariantes (int estado) const = 0;
         virtual void valida (
                 SimboloValida simbolo_equipo_inicial,
                 SimboloValida simbolo_equipo_actual,
@@ -102,7 +150,7 @@ namespace tapete {
                 SimboloValida simbolo_tipo_accion, 
                 SimboloValida simbolo_oponente_, 
                 SimboloValida simbolo_area_celdas);
-        void informaProceso (const string & metodo);
+        void informaProceso (const char * metodo);
 
         static void aserta (bool condicion, const string & atributo, SimboloValida simbolo);
         void excepciona (const string & metodo, const std::exception & excepcion);
@@ -112,7 +160,14 @@ namespace tapete {
         EstadoJuegoComun & estado_;
         EstadoJuegoComun & estado_previo_;
 
+        int modulo_traza {RegistroTraza::nulo};
+
+        // la última es la de la jugada en curso
+        static constexpr int maximoJugadasPrevias = 32;
+        std::vector <InstantaneaPartida> jugadas_previas {};
+
         static constexpr double segundos_calculo = 1.0;
+        double                  segundos_espera {segundos_calculo};
 
     };
 
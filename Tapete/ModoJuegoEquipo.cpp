@@ -230,39 +230,37 @@ namespace tapete {
     }
 
 
-    void ModoJuegoEquipo::validaAtributos () {
-        switch (estado ()) {
+    const ModoJuegoComun::InvariantesEstado & ModoJuegoEquipo::invariantes (int estado) const {
+        static constexpr std::array <InvariantesEstado, EstadoJuegoEquipo::cuentaCodigos> tabla {{
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
         //                         | estado                      |        | equipo   | equipo   | elegidos | atacante | vivo   | agotado | modo      | etapas | habilidad | tipo     | personaje | área     |
         //                         |                             |        | inicial  | actual   |          |          |        |         | acción    | camino |           | accion   |           | celdas   |
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
-        case EstadoJuegoEquipo    ::inicial                      : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::terminal                     : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::inicioRonda                  : valida ( ASIGNADO , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::inicioTurno                  : valida ( ASIGNADO , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        //                                                                                                                                                                                                              
-        //                                                                                                                                                                                                               
-        case EstadoJuegoEquipo    ::inicioJugada                 : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::preparacionDesplazamiento    : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::marcacionCaminoFicha         : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::habilidadSimpleInvalida      : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::habilidadSimpleConfirmacion  : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::habilidadSimpleResultado     : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::preparacionHabilidadOponente : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::oponenteHabilidadInvalido    : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoEquipo    ::oponenteHabilidadConfirmacion: valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoEquipo    ::oponenteHabilidadCalculando  : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoEquipo    ::oponenteHabilidadResultado   : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoEquipo    ::preparacionHabilidadArea     : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO    ); break;
-        case EstadoJuegoEquipo    ::areaHabilidadInvalida        : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoEquipo    ::areaHabilidadConfirmacion    : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoEquipo    ::areaHabilidadCalculando      : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoEquipo    ::areaHabilidadResultado       : valida ( ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        //                                                                                                                                                                                                                 
-        //                                                                                                                                                                                                                  
-        case EstadoJuegoEquipo    ::mostrandoAyuda               : valida ( ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora   ); break;
-        case EstadoJuegoEquipo    ::finalPartida                 : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        }
+        {    EstadoJuegoEquipo    ::inicial                      ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::terminal                     ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::inicioJugada                 ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::preparacionDesplazamiento    ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::marcacionCaminoFicha         ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::habilidadSimpleInvalida      ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::habilidadSimpleConfirmacion  ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::habilidadSimpleResultado     ,          ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::preparacionHabilidadOponente ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::oponenteHabilidadInvalido    ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoEquipo    ::oponenteHabilidadConfirmacion,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoEquipo    ::oponenteHabilidadCalculando  ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoEquipo    ::oponenteHabilidadResultado   ,          ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoEquipo    ::preparacionHabilidadArea     ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::areaHabilidadInvalida        ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoEquipo    ::areaHabilidadConfirmacion    ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoEquipo    ::areaHabilidadCalculando      ,          ASIGNADO , NULO     , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoEquipo    ::areaHabilidadResultado       ,          ASIGNADO , NULO     , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoEquipo    ::mostrandoAyuda               ,          ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora    },
+        {    EstadoJuegoEquipo    ::finalPartida                 ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::inicioRonda                  ,          ASIGNADO , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoEquipo    ::inicioTurno                  ,          ASIGNADO , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     }
+        }};
+        static_assert (ordenadas (tabla));
+        return tabla [estado];
     }
 
 
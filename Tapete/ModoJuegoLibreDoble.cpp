@@ -340,39 +340,39 @@ namespace tapete {
     }
 
 
-    void ModoJuegoLibreDoble::validaAtributos () {
-        switch (estado ()) {
+    const ModoJuegoComun::InvariantesEstado & ModoJuegoLibreDoble::invariantes (int estado) const {
+        static constexpr std::array <InvariantesEstado, EstadoJuegoLibreDoble::cuentaCodigos> tabla {{
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
         //                         | estado                      |        | equipo   | equipo   | elegidos | atacante | vivo   | agotado | modo      | etapas | habilidad | tipo     | personaje | área     |
         //                         |                             |        | inicial  | actual   |          |          |        |         | acción    | camino |           | accion   |           | celdas   |
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
-        case EstadoJuegoLibreDoble::inicial                      : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::terminal                     : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::inicioRonda                  : valida ( NULO     , ASIGNADO , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::inicioTurnoNoElegido         : valida ( NULO     , ASIGNADO , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        //                                                                                                                                                                                                                   
-        case EstadoJuegoLibreDoble::inicioTurnoConfirmacion      : valida ( NULO     , ASIGNADO , UNO      , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::inicioJugada                 : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::preparacionDesplazamiento    : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::marcacionCaminoFicha         : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::habilidadSimpleInvalida      : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::habilidadSimpleConfirmacion  : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::habilidadSimpleResultado     : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::preparacionHabilidadOponente : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::oponenteHabilidadInvalido    : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoLibreDoble::oponenteHabilidadConfirmacion: valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoLibreDoble::oponenteHabilidadCalculando  : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoLibreDoble::oponenteHabilidadResultado   : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoLibreDoble::preparacionHabilidadArea     : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO    ); break;
-        case EstadoJuegoLibreDoble::areaHabilidadInvalida        : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoLibreDoble::areaHabilidadConfirmacion    : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoLibreDoble::areaHabilidadCalculando      : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoLibreDoble::areaHabilidadResultado       : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoLibreDoble::agotadosPuntosAccion         : valida ( NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        //                                                                                                                                                                                                                  
-        case EstadoJuegoLibreDoble::mostrandoAyuda               : valida ( ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora   ); break;
-        case EstadoJuegoLibreDoble::finalPartida                 : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        }
+        {    EstadoJuegoLibreDoble::inicial                      ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::terminal                     ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::inicioJugada                 ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::preparacionDesplazamiento    ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::marcacionCaminoFicha         ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::habilidadSimpleInvalida      ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::habilidadSimpleConfirmacion  ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::habilidadSimpleResultado     ,          NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::preparacionHabilidadOponente ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::oponenteHabilidadInvalido    ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoLibreDoble::oponenteHabilidadConfirmacion,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoLibreDoble::oponenteHabilidadCalculando  ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoLibreDoble::oponenteHabilidadResultado   ,          NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoLibreDoble::preparacionHabilidadArea     ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::areaHabilidadInvalida        ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoLibreDoble::areaHabilidadConfirmacion    ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoLibreDoble::areaHabilidadCalculando      ,          NULO     , ASIGNADO , UNO      , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoLibreDoble::areaHabilidadResultado       ,          NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoLibreDoble::mostrandoAyuda               ,          ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora    },
+        {    EstadoJuegoLibreDoble::finalPartida                 ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::inicioRonda                  ,          NULO     , ASIGNADO , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::inicioTurnoNoElegido         ,          NULO     , ASIGNADO , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::inicioTurnoConfirmacion      ,          NULO     , ASIGNADO , UNO      , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoLibreDoble::agotadosPuntosAccion         ,          NULO     , ASIGNADO , UNO      , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     }
+        }};
+        static_assert (ordenadas (tabla));
+        return tabla [estado];
     }
 
 
@@ -49,7 +49,7 @@ namespace tapete {
         void escribeEstado () override;
 
         const string nombreModulo () override;
-        void validaAtributos () override;
+        const InvariantesEstado & invariantes (int estado) const override;
 //        void excepciona (const string & metodo, const std::exception & excepcion);
 
     };
@@ -28,6 +28,7 @@ namespace tapete {
             //
             assert (ModoJuegoBase::cuentaPersonajesIgual ());
             ModoJuegoBase::iniciaRondas ();
+            vaciaJugadas ();
             //
             estado ().transita (EstadoJuegoPares::inicioRonda);
             validaAtributos ();
@@ -124,6 +125,7 @@ namespace tapete {
             ModoJuegoBase::estableceAtacante (lado);
             //
             estado ().transita (EstadoJuegoPares::inicioJugada);
+            apilaJugada ();
             validaAtributos ();
             informaProceso ("entraInicioJugada");
             escribeEstado ();
@@ -150,6 +152,7 @@ namespace tapete {
             //
             if (inicio_jugada) {
                 estado ().transita (EstadoJuegoComun::inicioJugada);
+                apilaJugada ();
             } else if (ataca_agotado) {
                 estado ().transita (EstadoJuegoPares::agotadosPuntosAccion);
             } else if (final_turno) {
@@ -185,6 +188,7 @@ namespace tapete {
             //
             if (inicio_jugada) {
                 estado ().transita (EstadoJuegoComun::inicioJugada);
+                apilaJugada ();
             } else if (ataca_agotado) {
                 estado ().transita (EstadoJuegoPares::agotadosPuntosAccion);
             } else if (final_turno) {
@@ -224,6 +228,51 @@ namespace tapete {
     }
 
 
+    void ModoJuegoPares::cedeJugada () {
+        try {
+            validaEstado ({ EstadoJuegoComun::inicioJugada });
+                            //  elegidos AMBOS, con atacante (NO agotado), modo acción NULO   
+                            //  sin etapas camino, sin HABILIDAD, sin OPONENTE, sin celda área
+            //
+            // solo cuando no puede desplazarse ni usar una habilidad: como 'TipoJugada::cede'
+            if (! atacanteBloqueado ()) {
+                return;
+            }
+            reglas::Jugada jugada {};
+            jugada.tipo      = reglas::TipoJugada::cede;
+            jugada.personaje = static_cast <int8_t> (atacante ()->indice ());
+            ModoJuegoBase::efectuaJugada (jugada);
+            bool inicio_jugada;
+            bool ataca_agotado;
+            bool final_turno;
+            asume (inicio_jugada, ataca_agotado, final_turno);
+            //
+            if (inicio_jugada) {
+                estado ().transita (EstadoJuegoComun::inicioJugada);
+                apilaJugada ();
+            } else if (ataca_agotado) {
+                estado ().transita (EstadoJuegoPares::agotadosPuntosAccion);
+            } else if (final_turno) {
+                estado ().transita (EstadoJuegoPares::finalTurno);
+            }
+            validaAtributos ();
+            informaProceso ("cedeJugada");
+            escribeEstado ();
+        } catch (const std::exception & excepcion) {
+            excepciona ("cedeJugada", excepcion);
+        }
+    }
+
+
+    bool ModoJuegoPares::atacanteBloqueado () {
+        reglas::EstadoPartida estado_reglas {};
+        ConversionReglas::extraeEstado (juego (), estado_reglas);
+        std::vector <reglas::Jugada> jugadas {};
+        juego ()->motorReglas ().generaJugadas (estado_reglas, jugadas);
+        return jugadas.size () == 1 && jugadas [0].tipo == reglas::TipoJugada::cede;
+    }
+
+
     void ModoJuegoPares::ignoraPersonajeAgotado () {
         try {
             validaEstado ({ EstadoJuegoPares::agotadosPuntosAccion });
@@ -235,6 +284,7 @@ namespace tapete {
             ModoJuegoBase::estableceAtacante (opuesto (lado_activo));
             // 
             estado ().transita (EstadoJuegoPares::inicioJugada);
+            apilaJugada ();
             validaAtributos ();
             informaProceso ("ignoraPersonajeAgotado");
             escribeEstado ();
@@ -338,6 +388,21 @@ namespace tapete {
                       "para reintentar."                      },
                     {}                                          );
             break;
+        case EstadoJuegoComun::inicioJugada:
+            if (atacanteBloqueado ()) {
+                juego ()->tablero ()->escribeMonitor (std::vector <wstring>
+                        { L"El personaje no puede moverse ni usar",
+                          L"ninguna habilidad. Pulsa 'espacio'",
+                          L"para ceder sus puntos de acción."     },
+                        {}                                          );
+            } else {
+                juego ()->tablero ()->escribeMonitor (std::vector <string>
+                        { "Selecciona el retrato para mover la",
+                          "ficha o selecciona una habilidad.",
+                          "'Esc' deshace la jugada anterior."    },
+                        {}                                        );
+            }
+            break;
         case EstadoJuegoPares::agotadosPuntosAccion:
             juego ()->tablero ()->escribeMonitor (std::vector <wstring>
                     { L"Puntos de acción agotados.",
@@ -363,39 +428,41 @@ namespace tapete {
     }
 
 
-    void ModoJuegoPares::validaAtributos () {
-        switch (estado ()) {
+    const ModoJuegoComun::InvariantesEstado & ModoJuegoPares::invariantes (int estado) const {
+        static constexpr std::array <InvariantesEstado, EstadoJuegoPares::cuentaCodigos> tabla {{
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
         //                         | estado                      |        | equipo   | equipo   | elegidos | atacante | vivo   | agotado | modo      | etapas | habilidad | tipo     | personaje | área     |
         //                         |                             |        | inicial  | actual   |          |          |        |         | acción    | camino |           | accion   |           | celdas   |
         //                         +-----------------------------+        +----------+----------+----------+----------+--------+---------+-----------+--------+-----------+----------+-----------+----------+
-        case EstadoJuegoPares     ::inicial                      : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::terminal                     : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::inicioRonda                  : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::inicioTurnoNoElegidos        : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::inicioTurnoElegidoUno        : valida ( NULO     , NULO     , UNO      , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::inicioTurnoConfirmacion      : valida ( NULO     , NULO     , AMBOS    , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::inicioJugada                 : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::preparacionDesplazamiento    : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::marcacionCaminoFicha         : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::habilidadSimpleInvalida      : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::habilidadSimpleConfirmacion  : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::habilidadSimpleResultado     : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::preparacionHabilidadOponente : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::oponenteHabilidadInvalido    : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoPares     ::oponenteHabilidadConfirmacion: valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoPares     ::oponenteHabilidadCalculando  : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoPares     ::oponenteHabilidadResultado   : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO    ); break;
-        case EstadoJuegoPares     ::preparacionHabilidadArea     : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::areaHabilidadInvalida        : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoPares     ::areaHabilidadConfirmacion    : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoPares     ::areaHabilidadCalculando      : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoPares     ::areaHabilidadResultado       : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO ); break;
-        case EstadoJuegoPares     ::agotadosPuntosAccion         : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::finalTurno                   : valida ( NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        case EstadoJuegoPares     ::mostrandoAyuda               : valida ( ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora   ); break;
-        case EstadoJuegoPares     ::finalPartida                 : valida ( NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO    ); break;
-        }
+        {    EstadoJuegoPares     ::inicial                      ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::terminal                     ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::inicioJugada                 ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::preparacionDesplazamiento    ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , DESPLAZAM , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::marcacionCaminoFicha         ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , DESPLAZAM , VARIOS , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::habilidadSimpleInvalida      ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::habilidadSimpleConfirmacion  ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::habilidadSimpleResultado     ,          NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , SIMPLE   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::preparacionHabilidadOponente ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::oponenteHabilidadInvalido    ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoPares     ::oponenteHabilidadConfirmacion,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoPares     ::oponenteHabilidadCalculando  ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoPares     ::oponenteHabilidadResultado   ,          NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , OPONENTE , ASIGNADO  , VACIO     },
+        {    EstadoJuegoPares     ::preparacionHabilidadArea     ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::areaHabilidadInvalida        ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoPares     ::areaHabilidadConfirmacion    ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoPares     ::areaHabilidadCalculando      ,          NULO     , NULO     , AMBOS    , ASIGNADO , SI     , NO      , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoPares     ::areaHabilidadResultado       ,          NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , HABILIDAD , CERO   , ASIGNADO  , AREA     , NULO      , NO_VACIO  },
+        {    EstadoJuegoPares     ::mostrandoAyuda               ,          ignora   , ignora   , ignora   , ignora   , ignora , ignora  , ignora    , ignora , ignora    , ignora   , ignora    , ignora    },
+        {    EstadoJuegoPares     ::finalPartida                 ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::inicioRonda                  ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::inicioTurnoNoElegidos        ,          NULO     , NULO     , NINGUNO  , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::inicioTurnoElegidoUno        ,          NULO     , NULO     , UNO      , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::inicioTurnoConfirmacion      ,          NULO     , NULO     , AMBOS    , NULO     , ignora , ignora  , ignora    , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::agotadosPuntosAccion         ,          NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     },
+        {    EstadoJuegoPares     ::finalTurno                   ,          NULO     , NULO     , AMBOS    , ASIGNADO , ignora , ignora  , NULO      , CERO   , NULO      , ignora   , NULO      , VACIO     }
+        }};
+        static_assert (ordenadas (tabla));
+        return tabla [estado];
     }
 
 
@@ -32,6 +32,7 @@ namespace tapete {
         void mueveFicha ();
         void asumeHabilidad ();
 
+        void cedeJugada ();
         void ignoraPersonajeAgotado ();
         void reiniciaTurno ();
 
@@ -46,10 +47,12 @@ namespace tapete {
                 bool & ataca_agotado, 
                 bool & final_turno   );
 
+        bool atacanteBloqueado ();
+
         void escribeEstado () override;
 
         const string nombreModulo () override;
-        void validaAtributos () override;
+        const InvariantesEstado & invariantes (int estado) const override;
 //        void excepciona (const string & metodo, const std::exception & excepcion);
 
     };
@@ -0,0 +1,91 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   OcupacionTablero.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    bool OcupacionTablero::enCapa (CapaOcupacion capa, Coord celda) const {
+        IndiceCelda indice {celda};
+        if (! indice.valido ()) {
+            return false;
+        }
+        return capas [static_cast <int> (capa)].test (indice.valor ());
+    }
+
+
+    bool OcupacionTablero::ocupada (Coord celda) const {
+        IndiceCelda indice {celda};
+        if (! indice.valido ()) {
+            return false;
+        }
+        return ocupadas_.test (indice.valor ());
+    }
+
+
+    void OcupacionTablero::marca (CapaOcupacion capa, Coord celda) {
+        IndiceCelda indice {celda};
+        if (! indice.valido ()) {
+            return;
+        }
+        capas [static_cast <int> (capa)].set (indice.valor ());
+        ocupadas_.set (indice.valor ());
+        ++ cambios_;
+    }
+
+
+    void OcupacionTablero::desmarca (CapaOcupacion capa, Coord celda) {
+        IndiceCelda indice {celda};
+        if (! indice.valido ()) {
+            return;
+        }
+        capas [static_cast <int> (capa)].reset (indice.valor ());
+        actualizaOcupada (indice.valor ());
+        ++ cambios_;
+    }
+
+
+    void OcupacionTablero::mueve (CapaOcupacion capa, Coord celda_sale, Coord celda_llega) {
+        desmarca (capa, celda_sale);
+        marca    (capa, celda_llega);
+    }
+
+
+    void OcupacionTablero::vacia (CapaOcupacion capa) {
+        capas [static_cast <int> (capa)].reset ();
+        ocupadas_ = capas [static_cast <int> (CapaOcupacion::muros )] | 
+                    capas [static_cast <int> (CapaOcupacion::fichas)] | 
+                    capas [static_cast <int> (CapaOcupacion::etapas)];
+        ++ cambios_;
+    }
+
+
+    const OcupacionTablero::CapaCeldas & OcupacionTablero::celdas (CapaOcupacion capa) const {
+        return capas [static_cast <int> (capa)];
+    }
+
+
+    const OcupacionTablero::CapaCeldas & OcupacionTablero::ocupadas () const {
+        return ocupadas_;
+    }
+
+
+    int OcupacionTablero::cambios () const {
+        return cambios_;
+    }
+
+
+    void OcupacionTablero::actualizaOcupada (int indice) {
+        ocupadas_.set (
+                indice,
+                capas [static_cast <int> (CapaOcupacion::muros )].test (indice) ||
+                capas [static_cast <int> (CapaOcupacion::fichas)].test (indice) ||
+                capas [static_cast <int> (CapaOcupacion::etapas)].test (indice)    );
+    }
+
+
+}
@@ -0,0 +1,58 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  OcupacionTablero.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    enum class CapaOcupacion {
+        muros,
+        fichas,
+        etapas
+    };
+
+
+    // Un bit por cada celda válida de la rejilla, en tres capas: muros, fichas de los personajes y 
+    // etapas del camino en curso. Las consultas son de tiempo constante; quien modifica los sitios
+    // (ActorTablero, ActorPersonaje, ModoJuegoBase) debe mantener las capas al día.
+    class OcupacionTablero {
+    public:
+
+        using CapaCeldas = ConjuntoCeldas;
+
+
+        bool enCapa  (CapaOcupacion capa, Coord celda) const;
+        bool ocupada (Coord celda) const;
+
+        void marca    (CapaOcupacion capa, Coord celda);
+        void desmarca (CapaOcupacion capa, Coord celda);
+        void mueve    (CapaOcupacion capa, Coord celda_sale, Coord celda_llega);
+        void vacia    (CapaOcupacion capa);
+
+        const CapaCeldas & celdas (CapaOcupacion capa) const;
+
+        // las tres capas juntas
+        const CapaCeldas & ocupadas () const;
+
+        // cuenta las modificaciones; quien guarda un cálculo que depende de la ocupación lo compara
+        // para saber si sigue valiendo
+        int cambios () const;
+
+    private:
+
+        static constexpr int cuentaCapas = 3;
+
+        std::array <CapaCeldas, cuentaCapas> capas {};
+        CapaCeldas                           ocupadas_ {};
+        int                                  cambios_ {};
+
+        void actualizaOcupada (int indice);
+
+    };
+
+
+}
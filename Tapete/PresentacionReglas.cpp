@@ -0,0 +1,73 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   PresentacionReglas.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    PresentacionReglas::PresentacionReglas (ModoJuegoBase * modo) {
+        this->modo_ = modo;
+    }
+
+
+    void PresentacionReglas::fichaDesplazada (int personaje, int celda_sale, int /*celda_llega*/) {
+        atacante_        = modo_->juego ()->personajes () [personaje];
+        this->celda_sale = ConversionReglas::celdaTablero (celda_sale);
+        desplazada       = true;
+    }
+
+
+    void PresentacionReglas::habilidadAplicada (int personaje, int habilidad, int aleatorio_100) {
+        JuegoMesaBase * juego = modo_->juego ();
+        atacante_  = juego->personajes  () [personaje];
+        habilidad_ = juego->habilidades () [habilidad];
+        // los personajes aún no han cambiado
+        juego->sistemaAtaque ().anotaHabilidad (atacante_, habilidad_, aleatorio_100);
+    }
+
+
+    void PresentacionReglas::vitalidadCambiada (int personaje, int vitalidad_origen, int vitalidad_final) {
+        JuegoMesaBase * juego = modo_->juego ();
+        juego->sistemaAtaque ().anotaAfectado (
+                juego->personajes () [personaje], vitalidad_origen, vitalidad_final);
+        vitalidad_cambiada = true;
+    }
+
+
+    void PresentacionReglas::presenta () {
+        if (atacante_ == nullptr) {
+            return;
+        }
+        JuegoMesaBase * juego = modo_->juego ();
+        if (desplazada) {
+            juego->tablero ()->rejilla ().desmarcaCelda (celda_sale);
+            juego->tablero ()->rejilla ().marcaCelda (
+                    atacante_->sitioFicha (), ModoJuegoBase::color_atacante, false);
+        }
+        if (habilidad_ != nullptr) {
+            juego->sistemaAtaque ().completaEfectos ();
+        }
+        if (vitalidad_cambiada) {
+            modo_->refrescaBarrasVida ();
+        }
+        //
+        if (atacante_->puntosAccion () == 0 || atacante_->vitalidad () == 0) {
+            atacante_->presencia ().oscureceRetrato ();
+        }
+        PresenciaActuante & presnc_ataca = juego->tablero ()->presencia (atacante_->ladoTablero ());
+        presnc_ataca.iluminaPuntosAccion (atacante_->puntosAccion (), 0);
+        presnc_ataca.refrescaBarraVida ();
+        //
+        if (desplazada) {
+            juego->tablero ()->emiteSonidoDesplaza ();
+        } else {
+            juego->tablero ()->emiteSonidoHabilidad (habilidad_);
+        }
+    }
+
+
+}
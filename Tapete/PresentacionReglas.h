@@ -0,0 +1,41 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  PresentacionReglas.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Lo que se ve en el tapete de una jugada que aplica 'reglas::MotorReglas'. Mientras las 
+    // reglas cambian el 'reglas::EstadoPartida', se anotan los avisos (y la explicación del 
+    // cálculo en 'SistemaAtaque'); 'presenta', cuando el estado ya está volcado en los personajes, 
+    // marca las celdas, refresca los retratos y las barras de vida y hace sonar la jugada. 
+    // No cambia nada de la partida.
+    class PresentacionReglas : public reglas::ObservadorReglas {
+    public:
+
+        explicit PresentacionReglas (ModoJuegoBase * modo);
+
+        void fichaDesplazada   (int personaje, int celda_sale, int celda_llega) override;
+        void habilidadAplicada (int personaje, int habilidad, int aleatorio_100) override;
+        void vitalidadCambiada (int personaje, int vitalidad_origen, int vitalidad_final) override;
+
+        void presenta ();
+
+    private:
+
+        ModoJuegoBase * modo_;
+
+        ActorPersonaje * atacante_ {};
+        Coord            celda_sale {};
+        bool             desplazada {};
+        Habilidad *      habilidad_ {};
+        bool             vitalidad_cambiada {};
+
+    };
+
+
+}
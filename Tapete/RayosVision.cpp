@@ -0,0 +1,138 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   RayosVision.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    void RayosVision::prepara () {
+        indice_rayo.assign (filasDesplaza * columnasDesplaza, -1);
+        rayos.clear ();
+        rayos.reserve (1 + 3 * alcanceRayos * (alcanceRayos + 1));
+        for (int filas = - 2 * alcanceRayos; filas <= 2 * alcanceRayos; ++ filas) {
+            for (int colns = - alcanceRayos; colns <= alcanceRayos; ++ colns) {
+                if ((filas + colns) % 2 != 0 || (filas == 0 && colns == 0)) {
+                    continue;
+                }
+                if (GeometriaHexagonal::distancia (0, 0, filas, colns) > alcanceRayos) {
+                    continue;
+                }
+                Rayo rayo {};
+                if (! recorreRayo (Coord {filas, colns}, rayo)) {
+                    continue;
+                }
+                int indice = (filas + 2 * alcanceRayos) * columnasDesplaza + (colns + alcanceRayos);
+                indice_rayo [indice] = static_cast <short> (rayos.size ());
+                rayos.push_back (rayo);
+            }
+        }
+    }
+
+
+    bool RayosVision::segmentoLibre (
+            const ConjuntoCeldas & ocupadas, 
+            Coord celda_origen, Coord celda_destino, 
+            bool & libre                            ) const {
+        int filas = celda_destino.fila () - celda_origen.fila ();
+        int colns = celda_destino.coln () - celda_origen.coln ();
+        if (filas < - 2 * alcanceRayos || filas > 2 * alcanceRayos ||
+            colns < -     alcanceRayos || colns >     alcanceRayos ) {
+            return false;
+        }
+        if (indice_rayo.empty ()) {
+            return false;
+        }
+        int indice = indice_rayo [(filas + 2 * alcanceRayos) * columnasDesplaza + (colns + alcanceRayos)];
+        if (indice < 0) {
+            return false;
+        }
+        const Rayo & rayo = rayos [indice];
+        if (celda_origen.fila () + rayo.fila_minima < 1                        ||
+            celda_origen.fila () + rayo.fila_maxima > RejillaTablero::filas    ||
+            celda_origen.coln () + rayo.coln_minima < 1                        ||
+            celda_origen.coln () + rayo.coln_maxima > RejillaTablero::columnas ) {
+            return false;
+        }
+        IndiceCelda indice_origen {celda_origen};
+        if (! indice_origen.valido ()) {
+            return false;
+        }
+        libre = true;
+        for (int indc = 0; indc < rayo.cuenta_saltos; ++ indc) {
+            if (ocupadas [indice_origen.valor () + rayo.saltos [indc]]) {
+                libre = false;
+                break;
+            }
+        }
+        return true;
+    }
+
+
+    bool RayosVision::recorreRayo (Coord desplazamiento, Rayo & rayo) {
+        //
+        // el recorrido de 'reglas::TableroReglas::segmentoLibre', pero sin tablero: desde un origen 
+        // cualquiera, se anotan las celdas atravesadas y las candidatas que se han comparado
+        //
+        using reglas::TableroReglas;
+        const Coord origen {1, 1};
+        Coord destino = origen + desplazamiento;
+        int direccion_exacta;
+        int direccion_cuadrante;
+        TableroReglas::direccion (
+                desplazamiento.fila (), desplazamiento.coln (), direccion_exacta, direccion_cuadrante);
+        TableroReglas::Recta recta_etapa = TableroReglas::recta (
+                origen.fila (), origen.coln (), destino.fila (), destino.coln ());
+        auto vecina = [] (Coord celda, int direccion) {
+            return Coord {celda.fila () + TableroReglas::pasoFila [direccion], 
+                          celda.coln () + TableroReglas::pasoColn [direccion]};
+        };
+        auto anota = [& rayo] (Coord salto) {
+            rayo.fila_minima = std::min (rayo.fila_minima, salto.fila ());
+            rayo.fila_maxima = std::max (rayo.fila_maxima, salto.fila ());
+            rayo.coln_minima = std::min (rayo.coln_minima, salto.coln ());
+            rayo.coln_maxima = std::max (rayo.coln_maxima, salto.coln ());
+        };
+        int distancia = GeometriaHexagonal::distancia (origen, destino);
+        Coord celda_sale = origen;
+        // cada paso avanza una casilla
+        for (int paso = 0; paso < distancia; ++ paso) {
+            Coord celda_llega;
+            if (direccion_exacta != 0) {
+                celda_llega = vecina (celda_sale, direccion_exacta);
+                anota (celda_llega - origen);
+            } else {
+                std::array <Coord, 2> celda_proxm {
+                        vecina (celda_sale, TableroReglas::candidata (direccion_cuadrante, 0)),
+                        vecina (celda_sale, TableroReglas::candidata (direccion_cuadrante, 1)) };
+                anota (celda_proxm [0] - origen);
+                anota (celda_proxm [1] - origen);
+                float distn_0 = TableroReglas::distanciaRecta (recta_etapa, celda_proxm [0].fila (), celda_proxm [0].coln ());
+                float distn_1 = TableroReglas::distanciaRecta (recta_etapa, celda_proxm [1].fila (), celda_proxm [1].coln ());
+                if (std::fabsf (distn_0 - distn_1) < toleranciaEmpate) {
+                    return false;
+                }
+                celda_llega = distn_0 < distn_1 ? celda_proxm [0] : celda_proxm [1];
+            }
+            if (celda_llega == destino) {
+                return true;
+            }
+            rayo.saltos [rayo.cuenta_saltos] = static_cast <short> (saltoIndice (celda_llega - origen));
+            rayo.cuenta_saltos ++;
+            celda_sale = celda_llega;
+        }
+        // no llega al destino
+        return false;
+    }
+
+
+    int RayosVision::saltoIndice (Coord desplazamiento) {
+        // fila y columna tienen la misma paridad, la suma es par
+        return (desplazamiento.fila () * RejillaTablero::columnas + desplazamiento.coln ()) / 2;
+    }
+
+
+}
@@ -0,0 +1,64 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  RayosVision.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Celdas que atraviesa el segmento recto entre dos celdas, con el recorrido de 
+    // 'reglas::TableroReglas::segmentoLibre', precalculadas para cada desplazamiento de hasta 
+    // 'alcanceRayos' casillas. 
+    // El índice compacto ('IndiceCelda') es lineal en la fila y la columna, así que el rayo de un
+    // desplazamiento se guarda como saltos de índice desde el origen y vale para cualquier origen:
+    // comprobar la visión es consultar esos bits en las celdas ocupadas, sin rectas ni raíces.
+    // No hay rayo (y hay que recorrer el segmento) cuando alguna celda que el recorrido tiene en 
+    // cuenta queda fuera del tablero, o cuando el recorrido duda entre dos celdas equidistantes.
+    class RayosVision {
+    public:
+
+        static constexpr int alcanceRayos = 20;
+
+
+        void prepara ();
+
+        // Devuelve falso si no hay rayo para el segmento; si lo hay, 'libre' indica si ninguna de 
+        // las celdas atravesadas (sin contar origen y destino) está en 'ocupadas'.
+        bool segmentoLibre (
+                const ConjuntoCeldas & ocupadas, 
+                Coord celda_origen, Coord celda_destino, 
+                bool & libre                            ) const;
+
+    private:
+
+        // por debajo, dos celdas candidatas se consideran equidistantes de la recta (píxeles)
+        static constexpr float toleranciaEmpate = 0.01f;
+
+        static constexpr int filasDesplaza    = 4 * alcanceRayos + 1;
+        static constexpr int columnasDesplaza = 2 * alcanceRayos + 1;
+
+        struct Rayo {
+            // saltos de índice desde el origen hasta las celdas atravesadas
+            std::array <short, alcanceRayos> saltos {};
+            int                              cuenta_saltos {};
+            // desplazamientos extremos de las celdas que el recorrido tiene en cuenta
+            int fila_minima {};
+            int fila_maxima {};
+            int coln_minima {};
+            int coln_maxima {};
+        };
+
+        // por cada desplazamiento (fila, columna), su rayo en 'rayos' o -1
+        std::vector <short> indice_rayo {};
+        std::vector <Rayo>  rayos {};
+
+        static bool recorreRayo (Coord desplazamiento, Rayo & rayo);
+        static int  saltoIndice (Coord desplazamiento);
+
+    };
+
+
+}
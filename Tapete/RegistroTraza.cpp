@@ -0,0 +1,192 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   RegistroTraza.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    RegistroTraza::RegistroTraza () {
+        origen = std::chrono::steady_clock::now ();
+        for (std::atomic <int16_t> & nombre_estado : nombres_estado) {
+            nombre_estado.store (nulo, std::memory_order_relaxed);
+        }
+    }
+
+
+    int RegistroTraza::interna (const char * literal) {
+        auto encontrado = literales.find (literal);
+        if (encontrado != literales.end ()) {
+            return encontrado->second;
+        }
+        // el mismo literal puede tener distintas direcciones en distintas unidades de compilación
+        int identificador = interna (string {literal});
+        literales.emplace (literal, identificador);
+        return identificador;
+    }
+
+
+    int RegistroTraza::interna (const string & nombre) {
+        int cuenta = cuenta_nombres.load (std::memory_order_relaxed);
+        for (int indc = 0; indc < cuenta; ++ indc) {
+            if (nombres [indc] == nombre) {
+                return indc;
+            }
+        }
+        if (cuenta == maximoNombres) {
+            throw std::logic_error {"RegistroTraza: demasiados nombres"};
+        }
+        nombres [cuenta] = nombre;
+        cuenta_nombres.store (cuenta + 1, std::memory_order_release);
+        return cuenta;
+    }
+
+
+    bool RegistroTraza::conoceEstado (int codigo) const {
+        assert (0 <= codigo && codigo < maximoEstados);
+        return nombres_estado [codigo].load (std::memory_order_acquire) != nulo;
+    }
+
+
+    void RegistroTraza::nombraEstado (int codigo, const string & nombre) {
+        assert (0 <= codigo && codigo < maximoEstados);
+        nombres_estado [codigo].store (static_cast <int16_t> (interna (nombre)), std::memory_order_release);
+    }
+
+
+    void RegistroTraza::agrega (int modulo, int metodo, int estado, int ronda, int turno, int jugada) {
+        uint64_t indice = cuenta_.load (std::memory_order_relaxed);
+        Traza traza {};
+        traza.tiempo = std::chrono::duration_cast <std::chrono::nanoseconds> (
+                std::chrono::steady_clock::now () - origen).count ();
+        traza.ronda  = static_cast <int16_t> (ronda);
+        traza.turno  = static_cast <int16_t> (turno);
+        traza.jugada = static_cast <int16_t> (jugada);
+        traza.metodo = static_cast <uint8_t> (metodo);
+        traza.modulo = static_cast <uint8_t> (modulo);
+        traza.estado = static_cast <int8_t>  (estado);
+        // quien lea esta escritura verá también la cuenta anterior, con 'indice' (véase: 'copia')
+        std::atomic_thread_fence (std::memory_order_release);
+        guarda (trazas_ [indice & (capacidad - 1)], traza);
+        cuenta_.store (indice + 1, std::memory_order_release);
+    }
+
+
+    uint64_t RegistroTraza::cuenta () const {
+        return cuenta_.load (std::memory_order_acquire);
+    }
+
+
+    void RegistroTraza::copia (std::vector <Traza> & trazas) const {
+        trazas.clear ();
+        uint64_t final = cuenta_.load (std::memory_order_acquire);
+        uint64_t inicio = final > capacidad ? final - capacidad : 0;
+        for (uint64_t indice = inicio; indice < final; ++ indice) {
+            trazas.push_back (lee (trazas_ [indice & (capacidad - 1)]));
+        }
+        // El escritor puede estar escribiendo la traza 'final_despues', que sobrescribe la 
+        // 'final_despues - capacidad': esa y las anteriores pueden estar a medias. 
+        std::atomic_thread_fence (std::memory_order_acquire);
+        uint64_t final_despues = cuenta_.load (std::memory_order_relaxed);
+        if (final_despues + 1 > inicio + capacidad) {
+            uint64_t perdidas = std::min <uint64_t> (final_despues + 1 - capacidad - inicio, trazas.size ());
+            trazas.erase (trazas.begin (), trazas.begin () + perdidas);
+        }
+    }
+
+
+    void RegistroTraza::guarda (Traza & destino, const Traza & origen) {
+        std::atomic_ref {destino.tiempo}.store (origen.tiempo, std::memory_order_relaxed);
+        std::atomic_ref {destino.ronda }.store (origen.ronda,  std::memory_order_relaxed);
+        std::atomic_ref {destino.turno }.store (origen.turno,  std::memory_order_relaxed);
+        std::atomic_ref {destino.jugada}.store (origen.jugada, std::memory_order_relaxed);
+        std::atomic_ref {destino.metodo}.store (origen.metodo, std::memory_order_relaxed);
+        std::atomic_ref {destino.modulo}.store (origen.modulo, std::memory_order_relaxed);
+        std::atomic_ref {destino.estado}.store (origen.estado, std::memory_order_relaxed);
+    }
+
+
+    RegistroTraza::Traza RegistroTraza::lee (Traza & origen) {
+        Traza traza {};
+        traza.tiempo = std::atomic_ref {origen.tiempo}.load (std::memory_order_relaxed);
+        traza.ronda  = std::atomic_ref {origen.ronda }.load (std::memory_order_relaxed);
+        traza.turno  = std::atomic_ref {origen.turno }.load (std::memory_order_relaxed);
+        traza.jugada = std::atomic_ref {origen.jugada}.load (std::memory_order_relaxed);
+        traza.metodo = std::atomic_ref {origen.metodo}.load (std::memory_order_relaxed);
+        traza.modulo = std::atomic_ref {origen.modulo}.load (std::memory_order_relaxed);
+        traza.estado = std::atomic_ref {origen.estado}.load (std::memory_order_relaxed);
+        return traza;
+    }
+
+
+    const string & RegistroTraza::nombre (int identificador) const {
+        assert (0 <= identificador && identificador < cuenta_nombres.load (std::memory_order_acquire));
+        return nombres [identificador];
+    }
+
+
+    const string & RegistroTraza::nombreEstado (int codigo) const {
+        static const string desconocido {"?"};
+        if (codigo < 0 || codigo >= maximoEstados) {
+            return desconocido;
+        }
+        int16_t identificador = nombres_estado [codigo].load (std::memory_order_acquire);
+        if (identificador == nulo) {
+            return desconocido;
+        }
+        return nombre (identificador);
+    }
+
+
+    const string RegistroTraza::texto (int cuenta_trazas) const {
+        std::vector <Traza> vigentes {};
+        copia (vigentes);
+        size_t primera = vigentes.size () > cuenta_trazas ? vigentes.size () - cuenta_trazas : 0;
+        string retorno {};
+        for (size_t indc = primera; indc < vigentes.size (); ++ indc) {
+            const Traza & traza = vigentes [indc];
+            retorno.append (std::format ("{:10.3f} s", traza.tiempo / 1e9));
+            retorno.append (std::format ("  ( {}, {}, {} )", traza.ronda, traza.turno, traza.jugada));
+            retorno.append (std::format ("  {:36}", nombre (traza.metodo)));
+            retorno.append (std::format ("  {}", nombreEstado (traza.estado)));
+            retorno.append ("\n");
+        }
+        return retorno;
+    }
+
+
+    // Formato del volcado, en el orden de bytes de la máquina:
+    //     "TRZ1"
+    //     uint32  cuenta de nombres; por cada uno: uint16 longitud y los caracteres
+    //     int16   [32] identificador del nombre de cada código de estado (-1 si no aparece)
+    //     uint32  cuenta de trazas; y las trazas, de la más antigua a la más reciente
+    void RegistroTraza::vuelca (const string & ruta_archivo) const {
+        std::ofstream archivo {ruta_archivo, std::ios::binary};
+        if (! archivo) {
+            throw std::runtime_error {"RegistroTraza: no se puede crear el archivo " + ruta_archivo};
+        }
+        archivo.write ("TRZ1", 4);
+        uint32_t cuenta = static_cast <uint32_t> (cuenta_nombres.load (std::memory_order_acquire));
+        archivo.write (reinterpret_cast <const char *> (& cuenta), sizeof (cuenta));
+        for (uint32_t indc = 0; indc < cuenta; ++ indc) {
+            uint16_t longitud = static_cast <uint16_t> (nombres [indc].size ());
+            archivo.write (reinterpret_cast <const char *> (& longitud), sizeof (longitud));
+            archivo.write (nombres [indc].data (), longitud);
+        }
+        std::array <int16_t, maximoEstados> identificadores {};
+        for (int codigo = 0; codigo < maximoEstados; ++ codigo) {
+            identificadores [codigo] = nombres_estado [codigo].load (std::memory_order_acquire);
+        }
+        archivo.write (reinterpret_cast <const char *> (identificadores.data ()), sizeof (identificadores));
+        std::vector <Traza> vigentes {};
+        copia (vigentes);
+        cuenta = static_cast <uint32_t> (vigentes.size ());
+        archivo.write (reinterpret_cast <const char *> (& cuenta), sizeof (cuenta));
+        archivo.write (reinterpret_cast <const char *> (vigentes.data ()), vigentes.size () * sizeof (Traza));
+    }
+
+
+}
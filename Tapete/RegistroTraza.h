@@ -0,0 +1,92 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  RegistroTraza.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Historia de las operaciones del proceso del juego, para depurar. Es un anillo de capacidad 
+    // fija de trazas sin punteros ni cadenas: los nombres del módulo, del método y del estado se 
+    // guardan una sola vez y las trazas llevan su identificador. Agregar una traza no reserva 
+    // memoria ni espera (salvo la primera vez que aparece un nombre); el texto solo se forma 
+    // cuando se pide ('texto'), normalmente al informar de una excepción.
+    // Escribe un único hilo; 'copia', 'texto' y 'nombreEstado' pueden leer desde otro. Las trazas 
+    // se escriben y se leen campo a campo con operaciones atómicas relajadas, como un 'seqlock' 
+    // cuyo contador es 'cuenta': 'copia' descarta las que el escritor haya podido alcanzar mientras.
+    class RegistroTraza {
+    public:
+
+        static constexpr int capacidad = 4096;
+        static_assert (std::has_single_bit (unsigned {capacidad}));
+
+        static constexpr int nulo = -1;
+
+        struct Traza {
+            // nanosegundos desde la creación del registro ('steady_clock')
+            int64_t  tiempo;
+            int16_t  ronda;
+            int16_t  turno;
+            int16_t  jugada;
+            uint8_t  metodo;
+            uint8_t  modulo;
+            // código del estado ('EstadoJuegoComun' o derivado)
+            int8_t   estado;
+        };
+
+        static_assert (std::is_trivially_copyable_v <Traza>);
+
+        RegistroTraza ();
+
+        // identificador de un nombre; un literal se reconoce por su dirección, sin comparar texto
+        int interna (const char * literal);
+        int interna (const string & nombre);
+
+        bool conoceEstado (int codigo) const;
+        void nombraEstado (int codigo, const string & nombre);
+
+        void agrega (int modulo, int metodo, int estado, int ronda, int turno, int jugada);
+
+        // trazas agregadas desde el principio, incluidas las ya sobrescritas
+        uint64_t cuenta () const;
+
+        // las trazas vigentes, de la más antigua a la más reciente
+        void copia (std::vector <Traza> & trazas) const;
+
+        const string & nombre (int identificador) const;
+        const string & nombreEstado (int codigo) const;
+
+        // una línea por traza, de las 'cuenta_trazas' más recientes
+        const string texto (int cuenta_trazas) const;
+
+        // nombres y trazas vigentes en binario; véase el formato en 'RegistroTraza.cpp'
+        void vuelca (const string & ruta_archivo) const;
+
+    private:
+
+        static constexpr int maximoNombres = 256;
+        static constexpr int maximoEstados = 32;
+
+        std::chrono::steady_clock::time_point origen;
+
+        // 'mutable': 'copia' lee con 'std::atomic_ref', que no admite objetos constantes
+        mutable std::array <Traza, capacidad> trazas_ {};
+        std::atomic <uint64_t>                cuenta_ {};
+
+        std::array <string, maximoNombres>   nombres {};
+        std::atomic <int>                    cuenta_nombres {};
+        std::unordered_map <const char *, int> literales {};
+
+        std::array <std::atomic <int16_t>, maximoEstados> nombres_estado {};
+
+
+        static void guarda (Traza & destino, const Traza & origen);
+        static Traza lee (Traza & origen);
+
+    };
+
+
+}
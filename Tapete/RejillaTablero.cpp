@@ -44,6 +44,7 @@ namespace tapete {
 
     RejillaTablero::RejillaTablero (ActorTablero * actor_tablero) {
         this->actor_tablero = actor_tablero;
+        marcaje_celdas.assign (IndiceCelda::cuenta, MarcajeCelda {});
     }
 
 
@@ -165,6 +166,92 @@ namespace tapete {
     }
 
 
+    void RejillaTablero::localizaCeldaTabla (Vector punto, Coord & localizada) const {
+        int x = static_cast <int> (punto.x ());
+        int y = static_cast <int> (punto.y ());
+        if (punto.x () < 0.0f || punto.y () < 0.0f || x >= anchoPixeles || y >= altoPixeles ||
+            static_cast <float> (x) != punto.x () || static_cast <float> (y) != punto.y ()     ) {
+            // fuera de la rejilla o entre píxeles: se calcula
+            localizaCelda (punto, localizada);
+            return;
+        }
+        localizada = IndiceCelda {celdas_pixeles [y * anchoPixeles + x]}.celda ();
+    }
+
+
+    void RejillaTablero::preparaLocalizacion (std::vector <short> & celdas_pixeles) {
+        // 'localizaCelda' es la referencia; se evalúa una vez por píxel
+        celdas_pixeles.resize (static_cast <size_t> (anchoPixeles) * altoPixeles);
+        Coord localizada {};
+        for (int y = 0; y < altoPixeles; ++ y) {
+            for (int x = 0; x < anchoPixeles; ++ x) {
+                localizaCelda (Vector {static_cast <float> (x), static_cast <float> (y)}, localizada);
+                celdas_pixeles [y * anchoPixeles + x] = static_cast <short> (IndiceCelda {localizada}.valor ());
+            }
+        }
+    }
+
+
+    bool RejillaTablero::compruebaLocalizacion (Vector & pixel_erroneo) {
+        std::vector <short> celdas_pixeles {};
+        preparaLocalizacion (celdas_pixeles);
+        return compruebaLocalizacion (celdas_pixeles, pixel_erroneo);
+    }
+
+
+    bool RejillaTablero::compruebaLocalizacion (
+            const std::vector <short> & celdas_pixeles, Vector & pixel_erroneo) {
+        constexpr float tolerancia = 0.25f;
+        for (int y = 0; y < altoPixeles; ++ y) {
+            for (int x = 0; x < anchoPixeles; ++ x) {
+                Vector      punto {static_cast <float> (x), static_cast <float> (y)};
+                IndiceCelda tabla {celdas_pixeles [y * anchoPixeles + x]};
+                pixel_erroneo = punto;
+                // las celdas cuyo hexágono puede contener el píxel, alrededor de la más cercana 
+                // sin contar con la paridad: ninguna otra lo contiene
+                float cercania = std::numeric_limits <float>::max ();
+                int fila = static_cast <int> (std::round (y / (ladoHexagono * seno60)));
+                int coln = static_cast <int> (std::round ((x / static_cast <float> (ladoHexagono) + 0.5f) / 1.5f));
+                for (int fila_vecina = fila - 2; fila_vecina <= fila + 2; ++ fila_vecina) {
+                    for (int coln_vecina = coln - 1; coln_vecina <= coln + 1; ++ coln_vecina) {
+                        IndiceCelda vecina {fila_vecina, coln_vecina};
+                        if (! vecina.valido ()) {
+                            continue;
+                        }
+                        cercania = std::min (cercania, unir2d::norma (centroHexagono (vecina.celda ()) - punto));
+                        if (vecina != tabla && margenHexagono (vecina.celda (), punto) > tolerancia) {
+                            return false;
+                        }
+                    }
+                }
+                // fuera de su hexágono, solo en los márgenes y con el centro más cercano
+                if (tabla.valido () && margenHexagono (tabla.celda (), punto) < - tolerancia &&
+                    unir2d::norma (centroHexagono (tabla.celda ()) - punto) > cercania + tolerancia) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+
+    float RejillaTablero::margenHexagono (Coord celda, Vector punto) {
+        Vector centro = centroHexagono (celda);
+        float  margen = std::numeric_limits <float>::max ();
+        for (int posicion = 1; posicion <= trazosHexagono; ++ posicion) {
+            Vector desde = verticeHexagono (celda, posicion);
+            Vector hasta = verticeHexagono (celda, posicion % trazosHexagono + 1);
+            Vector lado  = hasta - desde;
+            // producto vectorial con el lado: el signo del centro es el de dentro
+            float del_punto  = lado.x () * (punto .y () - desde.y ()) - lado.y () * (punto .x () - desde.x ());
+            float del_centro = lado.x () * (centro.y () - desde.y ()) - lado.y () * (centro.x () - desde.x ());
+            float distancia  = del_punto / unir2d::norma (lado);
+            margen = std::min (margen, del_centro > 0.0f ? distancia : - distancia);
+        }
+        return margen;
+    }
+
+
     void RejillaTablero::prepara () {
         //------------------------------------------------------------
         trazos_rejilla = new unir2d::Trazos {};
@@ -209,9 +296,12 @@ namespace tapete {
         //------------------------------------------------------------
         trazos_marcaje = new unir2d::Trazos {};
         trazos_marcaje->ponPosicion (PresenciaTablero::regionRejilla.posicion ());
-        cambio_trazos_marcaje = false;
+        cambio_trazos_marcaje  = false;
+        borrado_trazos_marcaje = false;
         //trazaHexagono (Coord {4, 4});
         //------------------------------------------------------------
+        preparaLocalizacion (celdas_pixeles);
+        //------------------------------------------------------------
         //
         actor_tablero->agregaDibujo (trazos_rejilla);
         actor_tablero->agregaDibujo (trazos_marcaje);
@@ -223,6 +313,12 @@ namespace tapete {
         delete trazos_rejilla;
         trazos_marcaje = nullptr;
         trazos_rejilla = nullptr;
+        marcaje_celdas.assign (IndiceCelda::cuenta, MarcajeCelda {});
+        celdas_con_hueco.clear ();
+        celdas_cambiadas.clear ();
+        huecos_libres = 0;
+        celdas_pixeles.clear ();
+        celdas_pixeles.shrink_to_fit ();
     }
 
 
@@ -232,41 +328,62 @@ namespace tapete {
 
 
     void RejillaTablero::marcaCelda (Coord posicion, Color color, bool grueso) {
-        std::vector <MarcajeCelda>::iterator iter = buscaMarcaCelda (posicion);
-        if (iter != marcaje_celdas.end ()) {
-            iter->color  = color;
-            iter->grueso = grueso;
-        } else {
-            MarcajeCelda marcj {posicion, color, grueso};
-            marcaje_celdas.push_back (marcj);
+        IndiceCelda indice {posicion};
+        if (! indice.valido ()) {
+            return;
+        }
+        MarcajeCelda & marcj = marcaje_celdas [indice.valor ()];
+        marcj.marcada = true;
+        marcj.color   = color;
+        marcj.grueso  = grueso;
+        anotaCambio (indice);
+    }
+
+
+    void RejillaTablero::marcaCeldas (const std::vector <Coord> & posiciones, Color color, bool grueso) {
+        for (Coord posicion : posiciones) {
+            marcaCelda (posicion, color, grueso);
         }
-        cambio_trazos_marcaje = true;
     }
 
 
     void RejillaTablero::desmarcaCelda (Coord posicion) {
-        std::vector <MarcajeCelda>::iterator iter = buscaMarcaCelda (posicion);
-        if (iter == marcaje_celdas.end ()) {
+        IndiceCelda indice {posicion};
+        if (! indice.valido ()) {
             return;
         }
-        marcaje_celdas.erase (iter);
-        cambio_trazos_marcaje = true;
+        MarcajeCelda & marcj = marcaje_celdas [indice.valor ()];
+        if (! marcj.marcada) {
+            return;
+        }
+        marcj.marcada = false;
+        anotaCambio (indice);
     }
 
 
     void RejillaTablero::desmarcaCeldas () {
-        marcaje_celdas.clear ();
-        cambio_trazos_marcaje = true;
+        // no se repinta celda a celda: los trazos se borran de una vez en 'refrescaMarcaje'
+        for (IndiceCelda indice : celdas_con_hueco) {
+            marcaje_celdas [indice.valor ()] = MarcajeCelda {};
+        }
+        for (IndiceCelda indice : celdas_cambiadas) {
+            marcaje_celdas [indice.valor ()] = MarcajeCelda {};
+        }
+        celdas_con_hueco.clear ();
+        celdas_cambiadas.clear ();
+        huecos_libres = 0;
+        borrado_trazos_marcaje = true;
+        cambio_trazos_marcaje  = true;
     }
 
 
-    std::vector <RejillaTablero::MarcajeCelda>::iterator RejillaTablero::buscaMarcaCelda (Coord posicion) {
-        for (std::vector <MarcajeCelda>::iterator iter = marcaje_celdas.begin (); iter < marcaje_celdas.end (); ++ iter) {
-            if (iter->posicion == posicion) {
-                return iter;
-            }
+    void RejillaTablero::anotaCambio (IndiceCelda indice) {
+        MarcajeCelda & marcj = marcaje_celdas [indice.valor ()];
+        if (! marcj.cambio) {
+            marcj.cambio = true;
+            celdas_cambiadas.push_back (indice);
         }
-        return marcaje_celdas.end (); 
+        cambio_trazos_marcaje = true;
     }
 
 
@@ -274,50 +391,120 @@ namespace tapete {
         if (! cambio_trazos_marcaje) {
             return;
         }
+        if (borrado_trazos_marcaje) {
+            trazos_marcaje->borraLineas ();
+            borrado_trazos_marcaje = false;
+        }
+        for (IndiceCelda indice : celdas_cambiadas) {
+            MarcajeCelda & marcj = marcaje_celdas [indice.valor ()];
+            marcj.cambio = false;
+            if (marcj.hueco < 0) {
+                if (! marcj.marcada) {
+                    continue;
+                }
+                marcj.hueco = static_cast <int> (trazos_marcaje->lineas ().size ());
+                celdas_con_hueco.push_back (indice);
+                trazaHexagono (indice.celda ());
+            } else if (marcj.pintada != marcj.marcada) {
+                huecos_libres += marcj.marcada ? - 1 : 1;
+            }
+            marcj.pintada = marcj.marcada;
+            pintaHexagono (marcj);
+        }
+        celdas_cambiadas.clear ();
+        cambio_trazos_marcaje = false;
+        //
+        liberaHuecosFinales ();
+        int huecos_ocupados = static_cast <int> (celdas_con_hueco.size ()) - huecos_libres;
+        if (huecos_libres >= minimoHuecosCompacta && huecos_libres > huecos_ocupados) {
+            compactaMarcaje ();
+        }
+    }
+
+
+    void RejillaTablero::liberaHuecosFinales () {
+        while (! celdas_con_hueco.empty ()) {
+            MarcajeCelda & marcj = marcaje_celdas [celdas_con_hueco.back ().valor ()];
+            if (marcj.pintada) {
+                return;
+            }
+            for (int indc = 0; indc < 2 * trazosHexagono; ++ indc) {
+                trazos_marcaje->extreUltimaLinea ();
+            }
+            marcj.hueco = -1;
+            celdas_con_hueco.pop_back ();
+            huecos_libres --;
+        }
+    }
+
+
+    void RejillaTablero::compactaMarcaje () {
+        // se vuelven a trazar las celdas que se ven, seguidas; cuesta lo que los huecos liberados 
+        // desde la compactación anterior
         trazos_marcaje->borraLineas ();
-        for (MarcajeCelda marcj : marcaje_celdas) {
-            trazaHexagono (marcj);
+        size_t ocupadas = 0;
+        for (IndiceCelda indice : celdas_con_hueco) {
+            MarcajeCelda & marcj = marcaje_celdas [indice.valor ()];
+            if (! marcj.pintada) {
+                marcj.hueco = -1;
+                continue;
+            }
+            marcj.hueco = static_cast <int> (trazos_marcaje->lineas ().size ());
+            celdas_con_hueco [ocupadas] = indice;
+            ocupadas ++;
+            trazaHexagono (indice.celda ());
+            pintaHexagono (marcj);
         }
+        celdas_con_hueco.resize (ocupadas);
+        huecos_libres = 0;
     }
 
 
-    void RejillaTablero::trazaHexagono (const MarcajeCelda & marcaje) {
-        Vector centro = centroHexagono (marcaje.posicion);
-        Vector punto1 = verticeHexagono (marcaje.posicion, 1);
-        Vector punto2 = verticeHexagono (marcaje.posicion, 2);
-        Vector punto3 = verticeHexagono (marcaje.posicion, 3);
-        Vector punto4 = verticeHexagono (marcaje.posicion, 4);
-        Vector punto5 = verticeHexagono (marcaje.posicion, 5);
-        Vector punto6 = verticeHexagono (marcaje.posicion, 6);
+    void RejillaTablero::trazaHexagono (Coord posicion) {
+        // los trazos de una celda se agregan una sola vez, transparentes; luego solo cambia su color
+        Vector punto1 = verticeHexagono (posicion, 1);
+        Vector punto2 = verticeHexagono (posicion, 2);
+        Vector punto3 = verticeHexagono (posicion, 3);
+        Vector punto4 = verticeHexagono (posicion, 4);
+        Vector punto5 = verticeHexagono (posicion, 5);
+        Vector punto6 = verticeHexagono (posicion, 6);
         punto1 += Vector { 1,  1};
         punto2 += Vector {-1,  1};
         punto3 += Vector {-1,  0};
         punto4 += Vector { 0, -1};
         punto5 += Vector { 0, -1};
         punto6 += Vector { 1,  0};
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto1, punto2, marcaje.color});    
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto2, punto3, marcaje.color});
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto3, punto4, marcaje.color});
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto4, punto5, marcaje.color});    
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto5, punto6, marcaje.color});
-        trazos_marcaje->agrega (unir2d::TrazoLinea {punto6, punto1, marcaje.color});
-        if (marcaje.grueso) {
-            punto1 += Vector { 0,  1};
-            punto2 += Vector { 0,  1};
-            punto3 += Vector {-1,  0};
-            punto4 += Vector { 0, -1};
-            punto5 += Vector { 0, -1};
-            punto6 += Vector { 1,  0};
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto1, punto2, marcaje.color});    
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto2, punto3, marcaje.color});
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto3, punto4, marcaje.color});
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto4, punto5, marcaje.color});    
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto5, punto6, marcaje.color});
-            trazos_marcaje->agrega (unir2d::TrazoLinea {punto6, punto1, marcaje.color});
-        }
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto1, punto2, colorTransparente});    
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto2, punto3, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto3, punto4, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto4, punto5, colorTransparente});    
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto5, punto6, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto6, punto1, colorTransparente});
+        // el trazo grueso
+        punto1 += Vector { 0,  1};
+        punto2 += Vector { 0,  1};
+        punto3 += Vector {-1,  0};
+        punto4 += Vector { 0, -1};
+        punto5 += Vector { 0, -1};
+        punto6 += Vector { 1,  0};
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto1, punto2, colorTransparente});    
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto2, punto3, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto3, punto4, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto4, punto5, colorTransparente});    
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto5, punto6, colorTransparente});
+        trazos_marcaje->agrega (unir2d::TrazoLinea {punto6, punto1, colorTransparente});
     }
 
 
+    void RejillaTablero::pintaHexagono (const MarcajeCelda & marcaje) {
+        Color color_fino   = marcaje.marcada                   ? marcaje.color : colorTransparente;
+        Color color_grueso = marcaje.marcada && marcaje.grueso ? marcaje.color : colorTransparente;
+        for (int indc = 0; indc < trazosHexagono; ++ indc) {
+            trazos_marcaje->ponColorLinea (marcaje.hueco + indc,                  color_fino);
+            trazos_marcaje->ponColorLinea (marcaje.hueco + trazosHexagono + indc, color_grueso);
+        }
+    }
+
 }
 
 
@@ -9,6 +9,9 @@
 namespace tapete {
 
 
+    class IndiceCelda;
+
+
     class RejillaTablero {
     public:
 
@@ -25,32 +28,71 @@ namespace tapete {
         static Vector centroHexagono (Coord centro);
         static Vector verticeHexagono (Coord centro, int minuto);
 
-        void localizaCelda (Vector punto, Coord & localizada);
+        static void localizaCelda (Vector punto, Coord & localizada);
+        // igual que 'localizaCelda', pero es una sola lectura de la tabla preparada en 'prepara'
+        void localizaCeldaTabla (Vector punto, Coord & localizada) const;
+
+        // Prepara la tabla de 'localizaCeldaTabla' y la comprueba contra la geometría de los 
+        // hexágonos ('verticeHexagono'), sin ventana: un píxel dentro del hexágono de una celda 
+        // del tablero debe tener esa celda; uno fuera de todos, ninguna o la de centro más 
+        // cercano (los márgenes del tablero). En los lados se admite un cuarto de píxel, porque 
+        // 'localizaCelda' elige el centro más cercano. Si falla, da el primer píxel erróneo. 
+        // (Véase: 'Repeticion --rejilla'.)
+        static bool compruebaLocalizacion (Vector & pixel_erroneo);
 
         // las posiciones de las celdas comienzan en la (1, 1) y terminan en
         void marcaCelda (Coord posicion, Color color);
         void marcaCelda (Coord posicion, Color color, bool grueso);
+        void marcaCeldas (const std::vector <Coord> & posiciones, Color color, bool grueso);
         void desmarcaCelda (Coord posicion);
         void desmarcaCeldas ();
 
     private:
 
         static constexpr int   puntosHexagono = 7;
+        static constexpr int   trazosHexagono = 6;
+
+        inline static const Color colorTransparente {0, 0, 0, 0};
+
+        static constexpr int anchoPixeles = static_cast <int> (PresenciaTablero::tamanoRejilla.x ());
+        static constexpr int altoPixeles  = static_cast <int> (PresenciaTablero::tamanoRejilla.y ());
 
 
         ActorTablero * actor_tablero;
 
         unir2d::Trazos * trazos_rejilla {};
 
+        // Cada celda marcada tiene un hueco de trazos en 'trazos_marcaje': seis para el trazo fino 
+        // y seis para el grueso. Marcar o desmarcar solo cambia el color de esos trazos 
+        // (transparente si no se ven). Al desmarcar, el hueco queda libre, por si la celda se 
+        // vuelve a marcar; los huecos libres del final se quitan en seguida, y cuando hay más 
+        // libres que ocupados se compactan los trazos, de modo que nunca hay muchos más trazos 
+        // que celdas marcadas.
         struct MarcajeCelda {
-            Coord posicion;
-            Color color;
-            bool  grueso;
+            bool  marcada {};
+            Color color   {colorTransparente};
+            bool  grueso  {};
+            bool  cambio  {};
+            // primer trazo de la celda en 'trazos_marcaje', o -1 si aún no tiene
+            int   hueco   {-1};
+            // si los trazos del hueco se ven ('marcada' al repintarlos)
+            bool  pintada {};
         };
+        // por 'IndiceCelda'
         std::vector <MarcajeCelda> marcaje_celdas {};
+        // en el orden de sus huecos
+        std::vector <IndiceCelda>  celdas_con_hueco {};
+        std::vector <IndiceCelda>  celdas_cambiadas {};
+        int                        huecos_libres {};
+
+        static constexpr int minimoHuecosCompacta = 16;
 
         unir2d::Trazos * trazos_marcaje {};
         bool             cambio_trazos_marcaje {};
+        bool             borrado_trazos_marcaje {};
+
+        // por cada píxel de la rejilla, el índice de su celda (ver 'IndiceCelda') o -1
+        std::vector <short> celdas_pixeles {};
 
 
         explicit RejillaTablero (ActorTablero * actor_tablero);
@@ -59,10 +101,18 @@ namespace tapete {
         void prepara ();
         void libera ();
 
-        std::vector <MarcajeCelda>::iterator buscaMarcaCelda (Coord posicion);
+        static void  preparaLocalizacion   (std::vector <short> & celdas_pixeles);
+        static bool  compruebaLocalizacion (const std::vector <short> & celdas_pixeles, Vector & pixel_erroneo);
+        // distancia de 'punto' a los lados del hexágono de la celda: positiva dentro
+        static float margenHexagono (Coord celda, Vector punto);
+
+        void anotaCambio (IndiceCelda indice);
 
         void refrescaMarcaje ();
-        void trazaHexagono (const MarcajeCelda & marcaje);
+        void liberaHuecosFinales ();
+        void compactaMarcaje ();
+        void trazaHexagono (Coord posicion);
+        void pintaHexagono (const MarcajeCelda & marcaje);
 
 
         friend class ActorTablero;
@@ -0,0 +1,168 @@
+﻿// proyecto: Grupal/Tapete
+// arhivo:   RepeticionPartida.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "tapete.h"
+
+
+namespace tapete {
+
+
+    using Suceso = GrabacionPartida::Suceso;
+
+
+    RepeticionPartida::RepeticionPartida (JuegoMesaBase * juego) {
+        this->juego_ = juego;
+    }
+
+
+    void RepeticionPartida::carga (const string & ruta_archivo) {
+        GrabacionPartida::lee (ruta_archivo, cabecera_, registros_);
+    }
+
+
+    void RepeticionPartida::carga (
+            const GrabacionPartida::Cabecera &              cabecera, 
+            const std::vector <GrabacionPartida::Registro> & registros ) {
+        cabecera_  = cabecera;
+        registros_ = registros;
+    }
+
+
+    const GrabacionPartida::Cabecera & RepeticionPartida::cabecera () const {
+        return cabecera_;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+
+
+    // Cada decisión grabada va seguida de los sucesos que produjo (tiradas, rondas, jugadas). Se 
+    // entrega la decisión, que se anota en memoria como en la partida original, y se comparan uno 
+    // a uno los registros anotados con los grabados. Las grabaciones de la versión 1 no tienen 
+    // los sucesos 'jugada', y los de la 2 llevan otra huella del estado: en las dos, los sucesos 
+    // 'jugada' no se comparan.
+    RepeticionPartida::Resultado RepeticionPartida::ejecuta () {
+        Resultado resultado {};
+        GrabacionPartida & grabacion = juego_->grabacion ();
+        //
+        juego_->modo ()->siembraAzar (cabecera_.semilla);
+        grabacion.abreMemoria ();
+        try {
+            iniciado = true;
+            juego_->iniciaSinVentana ();
+        } catch (const std::exception & excepcion) {
+            diverge (resultado, 0, string {"al iniciar el juego: "} + excepcion.what ());
+            return resultado;
+        }
+        if (juego_->huellaConfiguracion () != cabecera_.huella) {
+            diverge (resultado, 0, "la configuración del juego no es la de la grabación");
+            return resultado;
+        }
+        juego_->sucesos ()->modo ()->omiteAnimacionCalculo ();
+        //
+        EntregaSucesos entrega {juego_};
+        size_t indice = 0;
+        bool con_jugadas = cabecera_.version >= 3;
+        if (! con_jugadas) {
+            std::erase_if (registros_, [] (const GrabacionPartida::Registro & registro) { 
+                return registro.suceso == Suceso::jugada; 
+            });
+        }
+        auto inicio = std::chrono::steady_clock::now ();
+        while (indice < registros_.size () && resultado.explicacion.empty ()) {
+            // lo anotado hasta ahora (al iniciar o por la última decisión) debe ser lo grabado
+            for (const GrabacionPartida::Registro & anotado : grabacion.registros ()) {
+                if (anotado.suceso == Suceso::jugada && ! con_jugadas) {
+                    continue;
+                }
+                if (indice == registros_.size () || registros_ [indice] != anotado) {
+                    string grabado = indice == registros_.size () ? "el final" : describe (registros_ [indice]);
+                    diverge (resultado, indice, "la repetición produce " + describe (anotado) + 
+                                                " en lugar de " + grabado);
+                    break;
+                }
+                if (anotado.suceso == Suceso::jugada) {
+                    resultado.jugadas ++;
+                }
+                indice ++;
+            }
+            grabacion.descartaRegistros ();
+            if (! resultado.explicacion.empty () || indice == registros_.size ()) {
+                break;
+            }
+            const GrabacionPartida::Registro & registro = registros_ [indice];
+            if (registro.suceso == Suceso::final) {
+                indice ++;
+                break;
+            }
+            if (! EntregaSucesos::esDecision (registro.suceso)) {
+                diverge (resultado, indice, "la repetición no produce " + describe (registro));
+                break;
+            }
+            try {
+                if (! entrega.entrega (registro)) {
+                    diverge (resultado, indice, "suceso imposible en este juego: " + describe (registro));
+                    break;
+                }
+            } catch (const std::exception & excepcion) {
+                diverge (resultado, indice, describe (registro) + ": " + excepcion.what ());
+                break;
+            }
+            resultado.decisiones ++;
+        }
+        auto final = std::chrono::steady_clock::now ();
+        resultado.registros = indice;
+        resultado.segundos = std::chrono::duration <double> (final - inicio).count ();
+        if (resultado.explicacion.empty ()) {
+            resultado.coincide = true;
+        }
+        return resultado;
+    }
+
+
+    void RepeticionPartida::termina () {
+        if (iniciado) {
+            juego_->terminaSinVentana ();
+            iniciado = false;
+        }
+    }
+
+
+    void RepeticionPartida::diverge (Resultado & resultado, size_t indice, const string & explicacion) {
+        resultado.coincide = false;
+        resultado.registro_divergente = indice;
+        resultado.explicacion = explicacion;
+        if (juego_->modo () != nullptr) {
+            resultado.ronda  = juego_->modo ()->ronda ();
+            resultado.turno  = juego_->modo ()->turno ();
+            resultado.jugada = juego_->modo ()->jugada ();
+        }
+    }
+
+
+    const string RepeticionPartida::describe (const GrabacionPartida::Registro & registro) {
+        static const std::array <const char *, GrabacionPartida::cuentaSucesos> nombres {
+                "final", "personajeSeleccionado", "fichaSeleccionada", "fichaPulsada", 
+                "actuanteSeleccionado", "habilidadSeleccionada", "celdaSeleccionada", "celdaPulsada", 
+                "ayudaSeleccionada", "pulsadoEspacio", "pulsadoEscape", "pulsadoArriba", "pulsadoAbajo", 
+                "tirada", "ronda", "jugada" };
+        string texto {nombres [static_cast <int> (registro.suceso)]};
+        if (registro.suceso == Suceso::jugada) {
+            std::ostringstream clave {};
+            clave << std::hex << registro.clave;
+            return texto + " (clave " + clave.str () + ")";
+        }
+        switch (GrabacionPartida::operandos (registro.suceso)) {
+        case 1:
+            return texto + " (" + std::to_string (registro.valor) + ")";
+        case 2:
+            return texto + " (" + std::to_string (registro.valor) + ", " + std::to_string (registro.dato) + ")";
+        default:
+            return texto;
+        }
+    }
+
+
+}
@@ -0,0 +1,65 @@
+﻿// proyecto: Grupal/Tapete
+// archivo:  RepeticionPartida.h
+// versión:  1.1  (9-Ene-2023)
+
+
+#pragma once
+
+
+namespace tapete {
+
+
+    // Vuelve a jugar una partida grabada ('GrabacionPartida') en un juego sin ventana, tan deprisa 
+    // como se pueda: entrega las decisiones grabadas con 'EntregaSucesos' y resuelve los cálculos 
+    // sin animación. El juego se graba en memoria mientras tanto; las tiradas, las rondas y la 
+    // clave del estado al final de cada jugada deben coincidir con las grabadas.
+    // Sirve de prueba de regresión de las reglas y de medida del rendimiento del proceso del juego.
+    class RepeticionPartida {
+    public:
+
+        struct Resultado {
+            bool   coincide {};
+            // registros de la grabación procesados; de ellos, decisiones y jugadas comprobadas
+            size_t registros {};
+            size_t decisiones {};
+            size_t jugadas {};
+            double segundos {};
+            // si no coincide: el primer registro que difiere, dónde estaba la partida y por qué
+            size_t registro_divergente {};
+            int    ronda {};
+            int    turno {};
+            int    jugada {};
+            string explicacion {};
+        };
+
+        // 'juego' recién construido, sin iniciar
+        explicit RepeticionPartida (JuegoMesaBase * juego);
+
+        void carga (const string & ruta_archivo);
+        // una grabación ya leída ('GrabacionPartida::lee')
+        void carga (const GrabacionPartida::Cabecera &              cabecera, 
+                    const std::vector <GrabacionPartida::Registro> & registros );
+
+        // inicia el juego y repite la partida; el juego queda iniciado hasta 'termina'
+        Resultado ejecuta ();
+        void termina ();
+
+        const GrabacionPartida::Cabecera & cabecera () const;
+
+    private:
+
+        JuegoMesaBase * juego_;
+        bool            iniciado {};
+
+        GrabacionPartida::Cabecera                cabecera_ {};
+        std::vector <GrabacionPartida::Registro> registros_ {};
+
+
+        void diverge (Resultado & resultado, size_t indice, const string & explicacion);
+
+        static const string describe (const GrabacionPartida::Registro & registro);
+
+    };
+
+
+}
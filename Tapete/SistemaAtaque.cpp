@@ -29,6 +29,50 @@ namespace tapete {
 
     void SistemaAtaque::agregaEfectividad (GradoEfectividad * elemento) {
         grados_efectividad.push_back (elemento);
+        tramos_efectividad.clear ();
+        distribuciones.clear ();
+    }
+
+
+    void SistemaAtaque::compilaEfectividades () {
+        tramos_efectividad.clear ();
+        for (int valor = minimoFinalAtaque; valor <= maximoFinalAtaque; ++ valor) {
+            // el mismo criterio que 'anotaAtaque': el primer grado que acota el valor
+            GradoEfectividad * elegida = nullptr;
+            for (GradoEfectividad * efectividad : grados_efectividad) {
+                if (valor <= efectividad->valorSuperioAtaque ()) {
+                    elegida = efectividad;
+                    break;
+                }
+            }
+            if (tramos_efectividad.empty () || tramos_efectividad.back ().efectividad != elegida) {
+                int porciento = elegida != nullptr ? elegida->porcentajeDano () : 0;
+                tramos_efectividad.push_back ({ valor, valor, elegida, porciento });
+            } else {
+                tramos_efectividad.back ().hasta = valor;
+            }
+            tramo_final_ataque [valor - minimoFinalAtaque] = 
+                    static_cast <short> (tramos_efectividad.size () - 1);
+        }
+    }
+
+
+    const std::vector <SistemaAtaque::TramoEfectividad> & SistemaAtaque::tramosEfectividad () const {
+        return tramos_efectividad;
+    }
+
+
+    const SistemaAtaque::TramoEfectividad & SistemaAtaque::tramoEfectividad (int valor_final_ataque) const {
+        assert (! tramos_efectividad.empty ());
+        assert (minimoFinalAtaque <= valor_final_ataque && valor_final_ataque <= maximoFinalAtaque);
+        return tramos_efectividad [tramo_final_ataque [valor_final_ataque - minimoFinalAtaque]];
+    }
+
+
+    void SistemaAtaque::aseguraEfectividades () {
+        if (tramos_efectividad.empty ()) {
+            compilaEfectividades ();
+        }
     }
 
 
@@ -57,18 +101,20 @@ namespace tapete {
     } 
 
 
-    // Cálculo para una habilidad "auto-aplicada":
-    void SistemaAtaque::calcula (
+    void SistemaAtaque::anotaHabilidad (
             ActorPersonaje * atacante, 
-            Habilidad *      habilidad) {
-        assert (habilidad->tipoEnfoque () == EnfoqueHabilidad::si_mismo);
+            Habilidad *      habilidad,
+            int              aleatorio_100) {
+        reinicia ();
+        this->atacante_      = atacante;
+        this->habilidad_     = habilidad;
+        this->aleatorio_100_ = aleatorio_100;
+        if (habilidad_->tipoEnfoque () != EnfoqueHabilidad::si_mismo) {
+            return;
+        }
         assert (habilidad->tipoAcceso  () == AccesoHabilidad::ninguno);
         assert (habilidad->antagonista () == Antagonista::si_mismo);  
         //
-        reinicia ();
-        this->atacante_  = atacante;
-        this->habilidad_ = habilidad;
-        //
         // ver: 'ValidacionJuego::EstadisticasHabilidades' '(i) (k)' 
         if (habilidad_->efectosAtaque  ().size () == 0 &&
             habilidad_->efectosDefensa ().size () == 0   ) {
@@ -89,9 +135,6 @@ namespace tapete {
                         "Sistema de ataque mal configurado, aplicando efecto en ataque: tipo de ataque no admitido por el atacante"};
             }
             registro.valor_origen_ataque = atacante_->valorAtaque (registro.tipo_ataque);
-            atacante_->cambiaAtaque (registro.tipo_ataque, registro.valor_cambio_ataque);
-            //
-            registro.valor_final_ataque = atacante_->valorAtaque (registro.tipo_ataque);
             //
             cambios_efecto.push_back (registro);
         }
@@ -108,115 +151,147 @@ namespace tapete {
                         "Sistema de ataque mal configurado, aplicando efecto en defensa: tipo de defensa no admitido por el atacante"};
             }
             registro.valor_origen_defensa = atacante_->valorDefensa (registro.tipo_defensa);
-            atacante_->cambiaDefensa (registro.tipo_defensa, registro.valor_cambio_defensa);
-            //
-            registro.valor_final_defensa = atacante_->valorDefensa (registro.tipo_defensa);
             //
             cambios_efecto.push_back (registro);
         }
     }
 
 
-    // Cálculo para una habilidad "de ataque" o "de curación", que "afecta a personaje"
-    // Usado cuando la habilidad tiene: 
-    //      tipoEnfoque = EnfoqueHabilidad::personaje
-    //      tipoAcceso  = { AccesoHabilidad::directo, AccesoHabilidad::indirecto }
-    //      antagonista = { Antagonista::oponente, Antagonista::aliado }
+    // Para una habilidad "de ataque" o "de curación", que "afecta a personaje" o "afecta a área"
     // Clasificación de la habilidad:
     //      antagonista = Antagonista::oponente => "de ataque"
     //      antagonista = Antagonista::aliado   => "de curación"
-    void SistemaAtaque::calcula (
-            ActorPersonaje * atacante, 
-            Habilidad *      habilidad,
+    void SistemaAtaque::anotaAfectado (
             ActorPersonaje * oponente, 
-            int              aleatorio_100) {
-        assert (habilidad->tipoEnfoque () == EnfoqueHabilidad::personaje);
-        assert (habilidad->tipoAcceso  () == AccesoHabilidad::directo ||
-                habilidad->tipoAcceso  () == AccesoHabilidad::indirecto );
-        assert (habilidad->antagonista () == Antagonista::oponente ||
-                habilidad->antagonista () == Antagonista::aliado     );
-        //        
-        reinicia ();
-        this->atacante_  = atacante;
-        this->habilidad_ = habilidad;
+            int              vitalidad_origen, 
+            int              vitalidad_final) {
+        assert (habilidad_ != nullptr);
+        assert (habilidad_->tipoEnfoque () == EnfoqueHabilidad::personaje ||
+                habilidad_->tipoEnfoque () == EnfoqueHabilidad::area        );
         //
         if (habilidad_->antagonista () == Antagonista::oponente) {
-            calculaAtaque (oponente, aleatorio_100);
+            anotaAtaque (oponente, vitalidad_origen, vitalidad_final);
         } else {
-            calculaCuracion (oponente);
+            anotaCuracion (oponente, vitalidad_origen, vitalidad_final);
         }
     }
 
 
-    // Cálculo para una habilidad "de ataque" o "de curación", que "afecta a un área"
-    // Usado cuando la habilidad tiene: 
-    //      tipoEnfoque = EnfoqueHabilidad::area
-    //      tipoAcceso  = { AccesoHabilidad::directo, AccesoHabilidad::indirecto }
-    //      antagonista = { Antagonista::oponente, Antagonista::aliado }
-    // Clasificación de la habilidad:
-    //      antagonista = Antagonista::oponente => "de ataque"
-    //      antagonista = Antagonista::aliado   => "de curación"
-    void SistemaAtaque::calcula (
-            ActorPersonaje *               atacante, 
-            Habilidad *                    habilidad,
-            std::vector <ActorPersonaje *> lista_oponentes, 
-            int                            aleatorio_100) {
-        assert (habilidad->tipoEnfoque () == EnfoqueHabilidad::area);
-        assert (habilidad->tipoAcceso  () == AccesoHabilidad::directo ||
-                habilidad->tipoAcceso  () == AccesoHabilidad::indirecto );
-        assert (habilidad->antagonista () == Antagonista::oponente ||
-                habilidad->antagonista () == Antagonista::aliado     );
-        //
-        reinicia ();
-        this->atacante_  = atacante;
-        this->habilidad_ = habilidad;
-        //
-        ataques_oponente   .clear ();
-        curaciones_oponente.clear ();
-        cambios_efecto     .clear ();
-        //
-        for (ActorPersonaje * oponente : lista_oponentes) {
-            if (habilidad_->antagonista () == Antagonista::oponente) {
-                calculaAtaque (oponente, aleatorio_100);
+    void SistemaAtaque::completaEfectos () {
+        for (CambioEfecto & registro : cambios_efecto) {
+            if (registro.tipo_ataque != nullptr) {
+                registro.valor_final_ataque  = atacante_->valorAtaque  (registro.tipo_ataque);
             } else {
-                calculaCuracion (oponente);
+                registro.valor_final_defensa = atacante_->valorDefensa (registro.tipo_defensa);
             }
         }
     }
 
 
     void SistemaAtaque::reinicia () {
-        atacante_  = nullptr;
-        habilidad_ = nullptr;
+        atacante_      = nullptr;
+        habilidad_     = nullptr;
+        aleatorio_100_ = 0;
         ataques_oponente   .clear ();
         curaciones_oponente.clear ();
         cambios_efecto     .clear ();
     }
 
 
-    // Cálculo para una habilidad "de ataque" y para uno de los personajes afectados
-    void SistemaAtaque::calculaAtaque (ActorPersonaje * oponente, int aleatorio_100) {
+    // Registro para una habilidad "de ataque" y para uno de los personajes afectados
+    void SistemaAtaque::anotaAtaque (ActorPersonaje * oponente, int vitalidad_origen, int vitalidad_final) {
         assert (habilidad_->antagonista () == Antagonista::oponente);
         //
         AtaqueOponente registro {};
         registro.oponente = oponente;
+        valoresAtaque (atacante_, habilidad_, oponente, registro);
+        aseguraEfectividades ();
+        //
+        DistribucionDano distrb = distribucion (atacante_, habilidad_, oponente);
+        registro.dano_esperado       = distrb.dano_esperado;
+        registro.probabilidad_muerte = distrb.probabilidad_muerte;
+        //
+        registro.aleatorio_100 = aleatorio_100_;
+        registro.valor_final_ataque = registro.ventaja + registro.aleatorio_100;
+        //
+        // véase: 'ValidacionJuego::SistemaAtaque'
+        const TramoEfectividad & tramo = tramoEfectividad (registro.valor_final_ataque);
+        registro.efectividad    = tramo.efectividad;
+        registro.porciento_dano = tramo.porciento_dano;
+        //
+        registro.valor_ajustado_dano = reglas::MotorReglas::ajustaDano (registro.valor_dano, registro.porciento_dano); 
+        registro.valor_final_dano = registro.valor_ajustado_dano - registro.valor_reduce_dano;
+        //
+        registro.vitalidad_origen = vitalidad_origen;
+        registro.vitalidad_final  = vitalidad_final;
+        //
+        ataques_oponente.push_back (registro);
+    }
+
+
+    SistemaAtaque::DistribucionDano SistemaAtaque::distribucion (
+            ActorPersonaje * atacante, 
+            Habilidad *      habilidad,
+            ActorPersonaje * oponente) {
+        assert (habilidad->antagonista () == Antagonista::oponente);
         //
-        registro.tipo_ataque = habilidad_->tipoAtaque (); 
+        AtaqueOponente valores {};
+        valoresAtaque (atacante, habilidad, oponente, valores);
+        aseguraEfectividades ();
+        ClaveDistribucion clave {
+                habilidad, valores.valor_ataque, valores.valor_defensa, valores.valor_reduce_dano };
+        auto iter = distribuciones.find (clave);
+        if (iter == distribuciones.end ()) {
+            DistribucionDano nueva {};
+            // la misma que usan las políticas y las búsquedas de las reglas
+            reglas::MotorReglas::distribucionDano (
+                    juego->reglasPartida (), valores.valor_dano, valores.ventaja, valores.valor_reduce_dano, 
+                    nueva.casos_dano );
+            int64_t suma = 0;
+            for (const reglas::MotorReglas::CasoDano & caso : nueva.casos_dano) {
+                suma += static_cast <int64_t> (caso.dano) * caso.casos;
+            }
+            nueva.dano_esperado = static_cast <float> (suma) / 100.0f;
+            iter = distribuciones.emplace (clave, nueva).first;
+        }
+        //
+        DistribucionDano resultado = iter->second;
+        resultado.vitalidad = oponente->vitalidad ();
+        int casos_muerte = 0;
+        if (resultado.vitalidad > 0) {
+            for (const reglas::MotorReglas::CasoDano & caso : resultado.casos_dano) {
+                if (caso.dano >= resultado.vitalidad) {
+                    casos_muerte += caso.casos;
+                }
+            }
+        }
+        resultado.probabilidad_muerte = static_cast <float> (casos_muerte) / 100.0f;
+        return resultado;
+    }
+
+
+    // Los valores de un ataque que no dependen del valor aleatorio
+    void SistemaAtaque::valoresAtaque (
+            ActorPersonaje * atacante, 
+            Habilidad *      habilidad,
+            ActorPersonaje * oponente,
+            AtaqueOponente & registro ) const {
+        registro.tipo_ataque = habilidad->tipoAtaque (); 
         // véase: 'ValidacionJuego::EstadisticasHabilidades' '(d)'
         if (registro.tipo_ataque == nullptr) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: tipo de ataque no establecido en la habilidad"};
         }
         // véase: 'ValidacionJuego::EstadisticasPersonajes' '(a)'
-        if (! atacante_->apareceAtaque (registro.tipo_ataque)) {
+        if (! atacante->apareceAtaque (registro.tipo_ataque)) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: tipo de ataque no admitido por el atacante"};
         }
-        registro.valor_ataque = atacante_->valorAtaque (registro.tipo_ataque);
+        registro.valor_ataque = atacante->valorAtaque (registro.tipo_ataque);
         // véase: 'ValidacionJuego::EstadisticasPersonajes' '(a)'
         if (registro.valor_ataque <= 0 || ActorPersonaje::maximaVitalidad < registro.valor_ataque) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: valor de ataque inválido"};
         }
         //
-        registro.tipo_defensa = habilidad_->tipoDefensa ();
+        registro.tipo_defensa = habilidad->tipoDefensa ();
         // véase: 'ValidacionJuego::EstadisticasHabilidades' '(e)'
         if (registro.tipo_defensa == nullptr) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: tipo de defensa no establecido en la habilidad"};
@@ -232,34 +307,22 @@ namespace tapete {
         }
         //
         registro.ventaja = registro.valor_ataque - registro.valor_defensa;
-        registro.aleatorio_100 = aleatorio_100;
-        registro.valor_final_ataque = registro.ventaja + registro.aleatorio_100;
         //
         // véase: 'ValidacionJuego::SistemaAtaque'
         if (grados_efectividad.size () == 0) {
             throw std::logic_error {"Sistema de ataque mal configurado: grados de efectividad no configurados"};
         }
-        // 
-        // véase: 'ValidacionJuego::SistemaAtaque'
-        for (GradoEfectividad * efectividad : grados_efectividad) {
-            if (registro.valor_final_ataque <= efectividad->valorSuperioAtaque ()) {
-                registro.efectividad = efectividad;
-                registro.porciento_dano = efectividad->porcentajeDano ();
-                break;
-            }
-        }
         //
-        registro.tipo_dano = habilidad_->tipoDano ();
+        registro.tipo_dano = habilidad->tipoDano ();
         // véase: 'ValidacionJuego::EstadisticasHabilidades' '(f)'
         if (registro.tipo_dano == nullptr) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: tipo de daño no establecido en la habilidad"};
         }
-        registro.valor_dano = habilidad_->valorDano ();
+        registro.valor_dano = habilidad->valorDano ();
         // véase: 'ValidacionJuego::EstadisticasHabilidades' '(g)'
         if (registro.valor_dano <= 0 || ActorPersonaje::maximaVitalidad < registro.valor_dano) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: valor de daño inválido"};
         }
-        registro.valor_ajustado_dano = (int) (registro.valor_dano * (((float) registro.porciento_dano) / 100.0f)); 
         //
         // véase: 'ValidacionJuego::EstadisticasPersonajes' '(c)'
         if (! oponente->apareceReduceDano (registro.tipo_dano)) {
@@ -270,27 +333,11 @@ namespace tapete {
         if (registro.valor_dano < 0 || ActorPersonaje::maximaVitalidad < registro.valor_dano) {
             throw std::logic_error {"Sistema de ataque mal configurado, aplicando ataque: valor de reducción de daño inválido"};
         }
-        registro.valor_final_dano = registro.valor_ajustado_dano - registro.valor_reduce_dano;
-        //
-        registro.vitalidad_origen = oponente->vitalidad ();
-        registro.vitalidad_final  = oponente->vitalidad ();
-        if (registro.vitalidad_final > 0) {
-            registro.vitalidad_final -= registro.valor_final_dano;
-            if (registro.vitalidad_final < 0) {
-                registro.vitalidad_final = 0;
-            }
-            if (registro.vitalidad_final > ActorPersonaje::maximaVitalidad) {
-                registro.vitalidad_final = ActorPersonaje::maximaVitalidad;
-            }
-            oponente->ponVitalidad (registro.vitalidad_final);
-        }
-        //
-        ataques_oponente.push_back (registro);
     }
 
 
-    // Cálculo para una habilidad "de curación" y para uno de los personajes afectados
-    void SistemaAtaque::calculaCuracion (ActorPersonaje * oponente) {
+    // Registro para una habilidad "de curación" y para uno de los personajes afectados
+    void SistemaAtaque::anotaCuracion (ActorPersonaje * oponente, int vitalidad_origen, int vitalidad_final) {
         // la habilidad es de curación, el oponente puede ser del mismo equipo o no
         assert (habilidad_->antagonista () == Antagonista::aliado);
         //        
@@ -303,18 +350,8 @@ namespace tapete {
         }
         registro.valor_curacion = habilidad_->valorCuracion ();
         //
-        registro.vitalidad_origen = oponente->vitalidad ();
-        registro.vitalidad_final  = oponente->vitalidad ();
-        if (registro.vitalidad_final > 0) {
-            registro.vitalidad_final += registro.valor_curacion;
-            if (registro.vitalidad_final < 0) {
-                registro.vitalidad_final = 0;
-            }
-            if (registro.vitalidad_final > ActorPersonaje::maximaVitalidad) {
-                registro.vitalidad_final = ActorPersonaje::maximaVitalidad;
-            }
-            oponente->ponVitalidad (registro.vitalidad_final);
-        }
+        registro.vitalidad_origen = vitalidad_origen;
+        registro.vitalidad_final  = vitalidad_final;
         //
         curaciones_oponente.push_back (registro);
     }
@@ -18,6 +18,25 @@ namespace tapete {
         const std::vector <GradoEfectividad *> & efectividades () const;
         void agregaEfectividad (GradoEfectividad * elemento);
 
+        // Los valores finales de ataque posibles: ventaja entre -149 y 149 más el valor aleatorio.
+        static constexpr int minimoFinalAtaque = 1 - ActorPersonaje::maximaVitalidad;
+        static constexpr int maximoFinalAtaque = ActorPersonaje::maximaVitalidad - 1 + 99;
+
+        // Los grados de efectividad recortados a esos valores: cada tramo es el intervalo de 
+        // valores finales que selecciona un grado. Si los grados no cubren algún valor (solo 
+        // antes de validarlos), su tramo no tiene grado y el porcentaje de daño es cero.
+        struct TramoEfectividad {
+            int                desde;
+            int                hasta;
+            GradoEfectividad * efectividad;
+            int                porciento_dano;
+        };
+        // Prepara la tabla de tramos; se llama tras validar los grados de efectividad, y si no, 
+        // el primer cálculo de un ataque.
+        void compilaEfectividades ();
+        const std::vector <TramoEfectividad> & tramosEfectividad () const;
+        const TramoEfectividad & tramoEfectividad (int valor_final_ataque) const;
+
         ActorPersonaje * atacante () const;
         Habilidad *      habilidad () const;
 
@@ -30,7 +49,7 @@ namespace tapete {
         // Si el personaje atacado tiene vitalidad cero (está muerto) el ataque no tiene efecto. 
         // Además, el ataque no puede hacer que la vitalidad sea inferior a cero ni superior a la 
         // vitalidad inicial de los personajes.
-        // Esta estructura de datos se crea mediante el segundo método 'calcula'. 
+        // Esta estructura de datos se crea mediante 'anotaAfectado'. 
         struct AtaqueOponente {
             // personaje atacado
             ActorPersonaje *   oponente;              
@@ -66,6 +85,10 @@ namespace tapete {
             int                vitalidad_origen;      
             // vitalidad del oponente ajustada con el valor final del daño
             int                vitalidad_final;       
+            // daño medio y probabilidad de dejar la vitalidad a cero, sobre los 100 valores 
+            // aleatorios posibles y antes de aplicar el ataque
+            float              dano_esperado;
+            float              probabilidad_muerte;
         };
         const std::vector <AtaqueOponente> & ataquesOponente () const;
 
@@ -79,7 +102,7 @@ namespace tapete {
         // Si el personaje curado tiene vitalidad cero (está muerto) la curación no tiene efecto. 
         // Además, la curación no puede hacer que la vitalidad sea sea inferior a cero (si fuera 
         // posible) ni superior a la vitalidad inicial de los personajes.
-        // Esta estructura de datos se crea mediante el tercer método 'calcula'. 
+        // Esta estructura de datos se crea mediante 'anotaAfectado'. 
         struct CuracionOponente {
             // personaje sobre el que se aplica la curación
             ActorPersonaje * oponente;   
@@ -101,7 +124,7 @@ namespace tapete {
         // para el tipo de ataque o de defensa.
         // A inicio de una ronda de juego nueva, el personaje recupera los valores iniciales de los 
         // ataques y defensas.
-        // Esta estructura de datos se crea mediante el primer método 'calcula'. 
+        // Esta estructura de datos se crea mediante 'anotaHabilidad' y 'completaEfectos'. 
         struct CambioEfecto {                                                   
             // tipo de ataque del efecto de la habilidad (puede ser nulo, si es defensa)  
             TipoAtaque *  tipo_ataque;              
@@ -125,42 +148,40 @@ namespace tapete {
         const std::vector <CambioEfecto> & cambiosEfecto () const; 
 
 
-        // Cálculo para una habilidad "auto-aplicada":
-        // Usado cuando la habilidad tiene: 
-        //      tipoEnfoque = EnfoqueHabilidad::si_mismo
-        //      tipoAcceso  = AccesoHabilidad::ninguno
-        //      antagonista = Antagonista::si_mismo
-        void calcula (
-                ActorPersonaje * atacante, 
-                Habilidad *      habilidad);
-
-        // Cálculo para una habilidad "de ataque" o "de curación", que "afecta a personaje"
-        // Usado cuando la habilidad tiene: 
-        //      tipoEnfoque = EnfoqueHabilidad::personaje
-        //      tipoAcceso  = { AccesoHabilidad::directo, AccesoHabilidad::indirecto }
-        //      antagonista = { Antagonista::oponente, Antagonista::aliado }
-        // Clasificación de la habilidad:
-        //      antagonista = Antagonista::oponente ==> "de ataque"
-        //      antagonista = Antagonista::aliado   ==> "de curación"
-        void calcula (
+        // Los registros explican una habilidad mientras 'reglas::MotorReglas' la aplica (véase: 
+        // 'PresentacionReglas'); aquí no cambia ningún personaje. 'anotaHabilidad' empieza, con 
+        // los personajes aún como antes de la habilidad; 'anotaAfectado' anota cada personaje vivo 
+        // al que llega, con la vitalidad que dan las reglas; y 'completaEfectos', ya cambiado el 
+        // atacante, los valores resultantes de una habilidad "auto-aplicada".
+        void anotaHabilidad (
                 ActorPersonaje * atacante, 
                 Habilidad *      habilidad,
-                ActorPersonaje * oponente, 
                 int              aleatorio_100);
+        void anotaAfectado (
+                ActorPersonaje * oponente, 
+                int              vitalidad_origen, 
+                int              vitalidad_final);
+        void completaEfectos ();
+
+
+        // Resultado de un ataque para los 100 valores aleatorios posibles, sin aplicarlo. 
+        // 'casos_dano' tiene, de menor a mayor, cada valor final del daño y cuántos de los 100 
+        // valores aleatorios lo producen ('reglas::MotorReglas::distribucionDano'). La probabilidad de muerte es la de que el ataque deje a
+        // cero la vitalidad actual del oponente.
+        struct DistribucionDano {
+            std::vector <reglas::MotorReglas::CasoDano> casos_dano;
+            float                                       dano_esperado;
+            int                                         vitalidad;
+            float                                       probabilidad_muerte;
+        };
 
-        // Cálculo para una habilidad "de ataque" o "de curación", que "afecta a área"
-        // Usado cuando la habilidad tiene: 
-        //      tipoEnfoque = EnfoqueHabilidad::area
-        //      tipoAcceso  = { AccesoHabilidad::directo, AccesoHabilidad::indirecto }
-        //      antagonista = { Antagonista::oponente, Antagonista::aliado }
-        // Clasificación de la habilidad:
-        //      antagonista = Antagonista::oponente ==> "de ataque"
-        //      antagonista = Antagonista::aliado   ==> "de curación"
-        void calcula (
-                ActorPersonaje *               atacante, 
-                Habilidad *                    habilidad,
-                std::vector <ActorPersonaje *> lista_oponentes, 
-                int                            aleatorio_100);
+        // Para una habilidad "de ataque". El reparto de daños se guarda para cada combinación de
+        // habilidad y valores de ataque, defensa y reducción de daño, así que se recalcula cuando 
+        // un efecto cambia alguno de ellos.
+        DistribucionDano distribucion (
+                ActorPersonaje * atacante, 
+                Habilidad *      habilidad,
+                ActorPersonaje * oponente);
         
     private:
 
@@ -168,18 +189,39 @@ namespace tapete {
 
         std::vector <GradoEfectividad *> grados_efectividad {};
 
+        static constexpr int cuentaFinalAtaque = maximoFinalAtaque - minimoFinalAtaque + 1;
+        std::vector <TramoEfectividad>        tramos_efectividad {};
+        std::array <short, cuentaFinalAtaque> tramo_final_ataque {};
+
         ActorPersonaje * atacante_;
         Habilidad *      habilidad_;
+        int              aleatorio_100_ {};
 
         std::vector <AtaqueOponente>   ataques_oponente {};
         std::vector <CuracionOponente> curaciones_oponente {};
         std::vector <CambioEfecto>     cambios_efecto {}; 
 
+        struct ClaveDistribucion {
+            Habilidad * habilidad;
+            int         valor_ataque;
+            int         valor_defensa;
+            int         valor_reduce_dano;
+            auto operator <=> (const ClaveDistribucion &) const = default;
+        };
+        std::map <ClaveDistribucion, DistribucionDano> distribuciones {};
+
 
         void reinicia ();
+        void aseguraEfectividades ();
 
-        void calculaAtaque   (ActorPersonaje * oponente, int aleatorio_100);
-        void calculaCuracion (ActorPersonaje * oponente);
+        void anotaAtaque   (ActorPersonaje * oponente, int vitalidad_origen, int vitalidad_final);
+        void anotaCuracion (ActorPersonaje * oponente, int vitalidad_origen, int vitalidad_final);
+
+        void valoresAtaque (
+                ActorPersonaje * atacante, 
+                Habilidad *      habilidad,
+                ActorPersonaje * oponente,
+                AtaqueOponente & registro ) const;
 
     };
 
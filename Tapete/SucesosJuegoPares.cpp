@@ -49,6 +49,9 @@ namespace tapete {
         case EstadoJuegoPares::inicioTurnoConfirmacion:
             modo ()->entraInicioJugada ();
             break;
+        case EstadoJuegoComun::inicioJugada:
+            modo ()->cedeJugada ();
+            break;
         case EstadoJuegoPares::agotadosPuntosAccion:
             modo ()->ignoraPersonajeAgotado ();
             break;
@@ -76,6 +79,9 @@ namespace tapete {
         case EstadoJuegoPares::inicioTurnoConfirmacion:
             modo ()->revierteInicioTurno ();
             break;
+        case EstadoJuegoComun::inicioJugada:
+            modo ()->deshaceJugada ();
+            break;
         default:
             SucesosJuegoComun::pulsadoEscape ();
             break;
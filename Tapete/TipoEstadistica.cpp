@@ -25,7 +25,7 @@ namespace tapete {
     }
 
 
-    int TipoEstadistica::indice () {
+    int TipoEstadistica::indice () const {
         return indice_;
     }
 
@@ -23,7 +23,7 @@ namespace tapete {
         Categoria categoria () const;
         const wstring & nombre () const;
 
-        int indice ();
+        int indice () const;
         void ponIndice (int valor);
 
     protected:
@@ -156,6 +156,9 @@ namespace tapete {
         aserta (juego->ataques ().size () > 0,
                 L"Debe haber al menos un tipo de ataque.",
                 LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
+        aserta (juego->ataques ().size () <= ActorPersonaje::maximoTiposEstadistica,
+                std::format (L"No puede haber más de {} tipos de ataque.", ActorPersonaje::maximoTiposEstadistica),
+                LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
         for (int i = 0; i < juego->ataques ().size (); i ++) {
             TipoAtaque * ataqu = juego->ataques () [i];
             aserta (cadenaValida (ataqu->nombre ()),
@@ -165,6 +168,9 @@ namespace tapete {
         aserta (juego->defensas ().size () > 0,
                 L"Debe haber al menos un tipo de defensa.",
                 LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
+        aserta (juego->defensas ().size () <= ActorPersonaje::maximoTiposEstadistica,
+                std::format (L"No puede haber más de {} tipos de defensa.", ActorPersonaje::maximoTiposEstadistica),
+                LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
         for (int i = 0; i < juego->defensas ().size (); i ++) {
             TipoDefensa * defns = juego->defensas () [i];
             aserta (cadenaValida (defns->nombre ()),
@@ -174,6 +180,9 @@ namespace tapete {
         aserta (juego->danos ().size () > 0,
                 L"Debe haber al menos un tipo de daño.",
                 LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
+        aserta (juego->danos ().size () <= ActorPersonaje::maximoTiposEstadistica,
+                std::format (L"No puede haber más de {} tipos de daño.", ActorPersonaje::maximoTiposEstadistica),
+                LocalizaConfigura::Seccion_6_Estadisticas_parte_2);
         for (int i = 0; i < juego->danos ().size (); i ++) {
             TipoDano * dano = juego->danos () [i];
             aserta (cadenaValida (dano->nombre ()),
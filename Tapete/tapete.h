@@ -13,7 +13,29 @@ using Region = unir2d::Region;
 using Color  = unir2d::Color;
 
 
+// Las invariantes de los atributos de cada estado ('ModoJuegoComun::validaAtributos') se comprueban 
+// al depurar y desaparecen en la versión final; se fuerza con 'TAPETE_INVARIANTES=0' o '=1'.
+#ifndef TAPETE_INVARIANTES
+#ifdef NDEBUG
+#define TAPETE_INVARIANTES 0
+#else
+#define TAPETE_INVARIANTES 1
+#endif
+#endif
+
+
 #include <sstream>
+#include <cstring>
+#include <bitset>
+#include <queue>
+#include <atomic>
+#include <fstream>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <reglas.h>
 
 #include "LadoTablero.h"
 #include "TipoEstadistica.h"
@@ -28,6 +50,12 @@ using Color  = unir2d::Color;
 
 #include "PresenciaTablero.h"
 #include "RejillaTablero.h"
+#include "GeometriaHexagonal.h"
+#include "IndiceCelda.h"
+#include "RayosVision.h"
+#include "OcupacionTablero.h"
+#include "AlcanceDesplaza.h"
+#include "MatrizAmenazas.h"
 #include "PresenciaHabilidades.h"
 #include "PresenciaActuante.h"
 #include "VistaCaminoCeldas.h"
@@ -39,10 +67,14 @@ using Color  = unir2d::Color;
 #include "GradoEfectividad.h"
 #include "SistemaAtaque.h"
 #include "EscritorAyuda.h"
+#include "RegistroTraza.h"
+#include "GrabacionPartida.h"
 #include "ModoJuegoBase.h"
+#include "PresentacionReglas.h"
 
 #include "SucesosJuegoComun.h"
 #include "EstadoJuegoComun.h"
+#include "InstantaneaPartida.h"
 #include "ModoJuegoComun.h"
 
 #include "SucesosJuegoPares.h"
@@ -59,3 +91,7 @@ using Color  = unir2d::Color;
 
 #include "ValidacionJuego.h"
 #include "JuegoMesaBase.h"
+#include "ConversionReglas.h"
+#include "EntregaSucesos.h"
+#include "JugadorAutomatico.h"
+#include "RepeticionPartida.h"
@@ -0,0 +1,178 @@
+﻿// proyecto: Grupal/Torneo
+// arhivo:   principal.cpp
+// versión:  1.1  (9-Ene-2023)
+
+
+#include "juego.h"
+
+
+// Juega sin ventana un torneo de equilibrado ('reglas::TorneoReglas') con los personajes de 
+// 'JuegoMesa', en los tres modos, en todos sus muros preparados y con las políticas al azar, 
+// de guion y de utilidad. Escribe un archivo CSV con una línea por enfrentamiento y muestra, por 
+// personaje, las partidas jugadas y el porcentaje de victorias. Se ejecuta en la carpeta de 
+// 'Juego', donde están los activos.
+//
+//     uso: Torneo [-partidas N] [-rondas N] [-equipo N] [-hilos N] [-semilla N] [-salida archivo]
+
+
+namespace {
+
+
+    // los nombres son cortos y casi siempre ASCII; no hay pares suplentes
+    std::string utf8 (const wstring & texto) {
+        std::string resultado {};
+        for (wchar_t caracter : texto) {
+            uint32_t codigo = static_cast <uint32_t> (caracter);
+            if (codigo < 0x80) {
+                resultado += static_cast <char> (codigo);
+            } else if (codigo < 0x800) {
+                resultado += static_cast <char> (0xC0 | (codigo >> 6));
+                resultado += static_cast <char> (0x80 | (codigo & 0x3F));
+            } else {
+                resultado += static_cast <char> (0xE0 | (codigo >> 12));
+                resultado += static_cast <char> (0x80 | ((codigo >> 6) & 0x3F));
+                resultado += static_cast <char> (0x80 | (codigo & 0x3F));
+            }
+        }
+        return resultado;
+    }
+
+
+    // inicia un juego con los muros dados para extraer sus reglas y los puestos iniciales
+    void preparaMapa (
+            const string &                       nombre, 
+            const ActorTablero::GraficoMuros &   grafico_muros, 
+            reglas::TorneoReglas &               torneo, 
+            std::vector <std::string> &          personajes ) {
+        std::unique_ptr <juego::JuegoMesa> juego {new juego::JuegoMesa {}};
+        juego->sustituyeMuros (grafico_muros);
+        juego->iniciaSinVentana ();
+        //
+        reglas::TorneoReglas::Mapa mapa {};
+        mapa.nombre = nombre;
+        mapa.reglas = juego->reglasPartida ();
+        for (LadoTablero lado : { LadoTablero::Izquierda, LadoTablero::Derecha }) {
+            for (ActorPersonaje * persj : juego->personajes (lado)) {
+                mapa.celdas [reglas::indiceLado (lado)].push_back (ConversionReglas::celdaReglas (persj->sitioFicha ()));
+            }
+        }
+        torneo.agregaMapa (mapa);
+        //
+        // el plantel se nombra con el primer mapa
+        if (personajes.empty ()) {
+            for (ActorPersonaje * persj : juego->personajes ()) {
+                personajes.push_back (utf8 (persj->nombre ()));
+            }
+            std::vector <std::string> habilidades {};
+            for (Habilidad * habld : juego->habilidades ()) {
+                habilidades.push_back (utf8 (habld->nombre ()));
+            }
+            torneo.nombraPlantel (personajes, habilidades);
+        }
+        juego->terminaSinVentana ();
+    }
+
+
+    void muestraPersonajes (const reglas::TorneoReglas & torneo, const std::vector <std::string> & nombres) {
+        std::vector <int64_t> partidas  (nombres.size ());
+        std::vector <int64_t> victorias (nombres.size ());
+        for (size_t indc = 0; indc < torneo.enfrentamientos ().size (); ++ indc) {
+            const reglas::TorneoReglas::Enfrentamiento & enfrentamiento = torneo.enfrentamientos () [indc];
+            const reglas::TorneoReglas::Resultado &      resultado      = torneo.resultados () [indc];
+            for (int persj : enfrentamiento.izquierda) {
+                partidas  [persj] += resultado.partidas;
+                victorias [persj] += resultado.victorias_izquierda;
+            }
+            for (int persj : enfrentamiento.derecha) {
+                partidas  [persj] += resultado.partidas;
+                victorias [persj] += resultado.victorias_derecha;
+            }
+        }
+        for (size_t persj = 0; persj < nombres.size (); ++ persj) {
+            std::cout << "    " << std::left << std::setw (16) << nombres [persj] << std::right;
+            std::cout << std::setw (10) << partidas [persj] << " partidas  ";
+            std::cout << std::fixed << std::setprecision (1);
+            std::cout << std::setw (5) << (partidas [persj] > 0 ? 100.0 * victorias [persj] / partidas [persj] : 0.0);
+            std::cout << " % victorias" << std::endl;
+        }
+    }
+
+
+}
+
+
+int main (int cuenta_argumentos, char * argumentos []) {
+    std::setlocale (LC_ALL, "es_ES.utf8");
+    ModoJuegoBase::trazaAvance (false);
+    //
+    reglas::TorneoReglas::Configuracion configuracion {};
+    configuracion.semilla = reglas::GeneradorAzar::semillaSistema ();
+    string ruta_salida {"torneo.csv"};
+    try {
+        for (int indc = 1; indc < cuenta_argumentos; ++ indc) {
+            string opcion {argumentos [indc]};
+            if (indc + 1 == cuenta_argumentos) {
+                throw std::invalid_argument {opcion};
+            }
+            string valor {argumentos [++ indc]};
+            if (opcion == "-partidas") {
+                configuracion.partidas = std::stoi (valor);
+            } else if (opcion == "-rondas") {
+                configuracion.maximo_rondas = std::stoi (valor);
+            } else if (opcion == "-equipo") {
+                configuracion.tamano_equipo = std::stoi (valor);
+            } else if (opcion == "-hilos") {
+                configuracion.hilos = std::stoi (valor);
+            } else if (opcion == "-semilla") {
+                configuracion.semilla = std::stoull (valor);
+            } else if (opcion == "-salida") {
+                ruta_salida = valor;
+            } else {
+                throw std::invalid_argument {opcion};
+            }
+        }
+    } catch (const std::exception &) {
+        std::cerr << "uso: Torneo [-partidas N] [-rondas N] [-equipo N] [-hilos N] [-semilla N] [-salida archivo]" << std::endl;
+        return 2;
+    }
+    //
+    try {
+        reglas::TorneoReglas torneo {};
+        std::vector <std::string> personajes {};
+        for (const std::pair <string, const ActorTablero::GraficoMuros *> & muros : juego::JuegoMesa::murosPreparados ()) {
+            try {
+                preparaMapa (muros.first, * muros.second, torneo, personajes);
+            } catch (const std::exception & excepcion) {
+                std::cerr << "se omiten los muros '" << muros.first << "': " << excepcion.what () << std::endl;
+            }
+        }
+        torneo.agregaPolitica ("azar",     [] () { return std::make_unique <reglas::PoliticaAzar>     (); });
+        torneo.agregaPolitica ("guion",    [] () { return std::make_unique <reglas::PoliticaGuion>    (); });
+        torneo.agregaPolitica ("utilidad", [] () { return std::make_unique <reglas::PoliticaUtilidad> (); });
+        //
+        torneo.ejecuta (configuracion);
+        //
+        std::ofstream salida {ruta_salida};
+        if (! salida) {
+            throw std::runtime_error {"no se puede escribir " + ruta_salida};
+        }
+        torneo.escribeCsv (salida);
+        //
+        std::cout << "semilla " << configuracion.semilla << ", ";
+        std::cout << torneo.enfrentamientos ().size () << " enfrentamientos, ";
+        std::cout << torneo.partidasJugadas () << " partidas, ";
+        std::cout << torneo.hilos () << " hilos" << std::endl;
+        std::cout << "    " << torneo.segundos () << " s";
+        // un torneo diminuto puede durar menos que la resolución del reloj
+        if (torneo.segundos () > 0) {
+            std::cout << ", " << static_cast <int64_t> (torneo.partidasJugadas () / torneo.segundos ()) << " partidas/s";
+        }
+        std::cout << std::endl;
+        muestraPersonajes (torneo, personajes);
+        std::cout << "resultados en " << ruta_salida << std::endl;
+    } catch (const std::exception & excepcion) {
+        std::cerr << excepcion.what () << std::endl;
+        return 1;
+    }
+    return 0;
+}